@@ -0,0 +1,101 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	ASSET LOADER MODULE																	//
+//	Reads & decodes meshes on worker threads, so that the main thread can get on with	//
+//	setting up Direct3D at the same time.  Each mesh asked for is read on its own		//
+//	thread, and the results are handed back to the main thread through a function		//
+//	given by the caller, as only the main thread may make Direct3D objects from them.	//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _ASSETLOADER_H_
+#define _ASSETLOADER_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <future>				// Standard futures, for waiting on each read.  
+#include <string>				// Standard string class.  
+#include <vector>				// Standard vector container.  
+#include "MeshData.h"			// Flat mesh layout.  
+#include "CookedMesh.h"			// Cooked binary meshes.  
+#include "StartupTimeline.h"	// Startup timings.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	TYPE DEFINITIONS
+//	The function each finished mesh is handed to on the main thread.  It is given the
+//	name the mesh was asked for under, the mesh itself (or NULL & the reason if it
+//	couldn't be read) & the context passed along with it.  
+//////////////////////////////////////////////////////////////////////////////////////////
+typedef void (*PublishFunction)(const char* path, const MeshView* Mesh, const char* error,
+								void* context);
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	SOURCE CLASS
+//	A mesh read from disk, from its cooked copy if there is one & from the model itself
+//	if not.  A cooked mesh is left mapped, so the view points into the mapping.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class MeshSource
+{
+	public:
+		bool Read(const char* path, bool verify);	// Reads a mesh.  
+
+		const MeshView& GetView();		// Reports the mesh read.  
+		const char* GetError();			// Describes why reading failed.  
+
+	private:
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS OBJECTS
+	//////////////////////////////////////////////////////////////////////////////////////
+		CookedMesh		Mapped;			// The cooked copy, if there is one.  
+		MeshData		Data;			// The mesh as read from the model, if need be.  
+		MeshView		View;			// The mesh, wherever it was read from.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS DATA
+	//////////////////////////////////////////////////////////////////////////////////////
+		char			Error[128];		// Why reading failed, if it did.  
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  The code for the methods is
+//	detailed in the module's source file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class AssetLoader
+{
+	public:
+		AssetLoader(StartupTimeline* Timeline);	// Class constructor.  
+		~AssetLoader();							// Class destructor.  
+
+		void Request(const char* path);			// Starts reading a mesh.  
+		int Publish(PublishFunction Function, void* context);	// Hands on finished meshes.  
+		void Finish(PublishFunction Function, void* context);	// Waits for & hands on all.  
+
+	private:
+		// A mesh being read, along with what became of it.  
+		struct AssetJob
+		{
+			std::string			Path;		// The name the mesh was asked for under.  
+			MeshSource			Source;		// The mesh, once read.  
+			std::future<bool>	Done;		// Set once reading has finished.  
+			bool				published;	// Whether it has been handed on.  
+		};
+
+		static bool Read(AssetJob* Job, StartupTimeline* Timeline);	// Reads a mesh.  
+		void Hand(AssetJob* Job, PublishFunction Function, void* context);	// Hands it on.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS OBJECTS
+	//////////////////////////////////////////////////////////////////////////////////////
+		StartupTimeline*		Timeline;	// Where reads are timed, if anywhere.  
+		std::vector<AssetJob*>	Jobs;		// Every mesh asked for.  
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,82 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLOCK MODULE																		//
+//	A small interface over a monotonic high-resolution clock.  Anything that needs to	//
+//	keep time is given a clock rather than reading the system's directly, so that a		//
+//	stand-in clock can be swapped in when running away from the real hardware.  The		//
+//	manual clock is one such stand-in, moving only when told to so timing code can be	//
+//	checked against known times.														//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _CLOCK_H_
+#define _CLOCK_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	Conversions between the clock's nanosecond units & more readable ones.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define NS_PER_MS			1000000LL
+#define NS_PER_SECOND		1000000000LL
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  The code for the methods is
+//	detailed in the module's source file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class Clock
+{
+	public:
+		virtual ~Clock() {}						// Class destructor.  
+
+		virtual long long Now() = 0;			// Reports the time in nanoseconds.  
+		virtual void Sleep(long long ns) = 0;	// Gives up the CPU for a given time.  
+		virtual void Pause() = 0;				// Gives up the rest of the time slice.  
+};
+
+//	The clock used by the game itself, driven by the system's steady clock.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class SystemClock : public Clock
+{
+	public:
+		long long Now();					// Reports the time in nanoseconds.  
+		void Sleep(long long ns);			// Gives up the CPU for a given time.  
+		void Pause();						// Gives up the rest of the time slice.  
+};
+
+//	A clock that only moves when told to, for checking timing code against known times.  
+//	Sleeping & pausing move it on by set amounts instead of waiting.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class ManualClock : public Clock
+{
+	public:
+		ManualClock();						// Class constructor.  
+
+		long long Now();					// Reports the time in nanoseconds.  
+		void Sleep(long long ns);			// Moves on by the time & any oversleep.  
+		void Pause();						// Moves on by the length of a pause.  
+
+		void Advance(long long ns);			// Moves on, as if working.  
+		void SetOversleep(long long ns);	// Sets how late each sleep wakes.  
+		void SetPauseLength(long long ns);	// Sets how long each pause takes.  
+
+		long long GetSleepTime();			// Reports the total time spent asleep.  
+		int GetPauseCount();				// Reports the pauses made.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS DATA
+	//////////////////////////////////////////////////////////////////////////////////////
+	private:
+		long long	now;				// The time the clock shows.  
+		long long	oversleep;			// Extra time added to each sleep.  
+		long long	pause_length;		// Time taken by each pause.  
+		long long	asleep;				// Total time spent asleep.  
+		int			pauses;				// Pauses made so far.  
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,105 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	COMMAND BUFFER MODULE																//
+//	A backend that records a frame's drawing instead of drawing it, to be handed on to	//
+//	another backend in one go.  Each call is packed into a single block of memory as a	//
+//	byte saying what it was, followed by its values; the block is kept from frame to	//
+//	frame, so once it has grown to fit a frame nothing more is allocated.  Meshes are	//
+//	made straight away in the backend being recorded for, as they outlive any one		//
+//	frame.																				//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _COMMANDBUFFER_H_
+#define _COMMANDBUFFER_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <vector>			// Standard vector container.  
+#include "RenderBackend.h"	// Render backend interface.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	The byte starting each recorded call.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define COMMAND_BEGIN			0		// BeginScene().  
+#define COMMAND_END				1		// EndScene().  
+#define COMMAND_PRESENT			2		// Present().  
+#define COMMAND_CLEAR			3		// Clear(), with its flags, colour, depth & stencil.  
+#define COMMAND_TRANSFORM		4		// SetTransform(), with the type & matrix.  
+#define COMMAND_MATERIAL		5		// SetMaterial(), with the material.  
+#define COMMAND_LIGHT			6		// SetLight(), with the light.  
+#define COMMAND_STATE			7		// SetRenderState(), with the state & value.  
+#define COMMAND_DRAW			8		// DrawSubset(), with the mesh & subset.  
+#define COMMAND_COUNT			9
+
+#define COMMAND_START_BYTES		4096	// The memory set aside before the first frame.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  The code for the methods is
+//	detailed in the module's source file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class CommandBuffer : public RenderBackend
+{
+	public:
+		CommandBuffer(RenderBackend* Target);	// Class constructor.  
+
+		const char* GetName();					// Reports what the backend is.  
+		int GetWidth();							// Reports the target's width.  
+		int GetHeight();						// Reports the target's height.  
+
+		int CreateMesh(const MeshView& Level);	// Makes a mesh in the target.  
+		void DestroyMesh(int mesh);				// Frees a mesh in the target.  
+		unsigned int GetFaceCount(int mesh);	// Reports a mesh's triangles.  
+		size_t GetMeshBytes(int mesh);			// Reports a mesh's memory.  
+
+		void BeginScene();						// Records the start of a frame.  
+		void EndScene();						// Records the end of drawing.  
+		void Present();							// Records the frame being shown.  
+		void Clear(unsigned int flags, unsigned int colour, float depth,
+				   unsigned int stencil);		// Records a clear.  
+
+		void SetTransform(int type, const Matrix& Transform);	// Records a transform.  
+		void GetTransform(int type, Matrix& Transform);			// Reports a transform.  
+		void SetMaterial(const RenderMaterial& Material);		// Records a material.  
+		void SetLight(const RenderLight& Light);				// Records a light.  
+		void SetRenderState(int state, unsigned int value);		// Records a render state.  
+
+		void DrawSubset(int mesh, unsigned int subset);			// Records a draw.  
+
+		// Functions for handing on what has been recorded.  
+		void Submit();							// Replays to the target & empties.  
+		void Replay(RenderBackend& Backend);	// Replays to any backend.  
+		void Reset();							// Empties the buffer, keeping its memory.  
+
+		size_t GetBytes();						// Reports the bytes recorded.  
+		int GetCommandCount();					// Reports the calls recorded.  
+		size_t GetCapacity();					// Reports the memory set aside.  
+
+	private:
+		unsigned char* Reserve(int command, size_t bytes);	// Makes room for a call.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS OBJECTS
+	//////////////////////////////////////////////////////////////////////////////////////
+		RenderBackend*				Target;		// The backend being recorded for.  
+		std::vector<unsigned char>	Arena;		// The memory calls are recorded into.  
+
+		Matrix		Transforms[TRANSFORM_COUNT];	// The transforms last recorded.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS DATA
+	//////////////////////////////////////////////////////////////////////////////////////
+		size_t		used;				// The bytes of the arena in use.  
+		int			commands;			// The calls recorded.  
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,92 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CONTROLLER MODULE																	//
+//	Classes that stand in for the player when a session is run without a window.  A	//
+//	controller looks at the simulation each tick and decides how far to turn the ring,	//
+//	in the same steps the keyboard would.												//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _CONTROLLER_H_
+#define _CONTROLLER_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "Defines.h"	// Library for the project's definitions & macros.  
+#include "Simulation.h"	// Renderer-free game simulation.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	Settings shared by the controllers.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define KEY_ROTATION		0.05f		// The ring's turn per tick while a key is held.  
+#define HOLD_FOREVER		0x7fffffff	// Reported when a controller won't act again.  
+#define HOLD_TURN_LIMIT		128			// Most ticks a held key is counted out for.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  The code for the methods is
+//	detailed in the module's source file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class Controller
+{
+	public:
+		virtual ~Controller() {}					// Class destructor.  
+
+		virtual void Reset() = 0;					// Prepares for a fresh session.  
+		virtual float Control(Simulation& Sim) = 0;	// Picks the rotation for a tick.  
+
+		// Functions letting a session jump ahead while the controller's input is steady.  
+		virtual int Hold(Simulation& Sim, float& x) = 0;	// Ticks it keeps a turn.  
+		virtual void Skip(int ticks) = 0;			// Lets ticks pass with it held.  
+};
+
+//	A controller that plays the game the way a person would: once it has reacted to a
+//	bounce, it holds a key towards the nearest block matching the ball's colour & lets
+//	go once the ball is over it.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class BotController : public Controller
+{
+	public:
+		BotController(int reaction);		// Class constructor.  
+
+		void Reset();						// Prepares for a fresh session.  
+		float Control(Simulation& Sim);		// Picks the rotation for a tick.  
+
+		int Hold(Simulation& Sim, float& x);	// Ticks it keeps a turn.  
+		void Skip(int ticks);				// Lets ticks pass with it held.  
+
+		static float TargetAngle(Simulation& Sim);	// Nearest angle that bounces.  
+
+	private:
+		void Observe(Simulation& Sim);		// Notices when the colours change.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS DATA
+	//////////////////////////////////////////////////////////////////////////////////////
+		int		reaction;		// Ticks taken to react to a new set of colours.  
+		int		waiting;		// Ticks left before reacting to the current colours.  
+		int		bounces;		// The bounce count the bot last reacted to.  
+};
+
+//	A controller that never touches the ring, leaving every bounce to chance.  Useful as
+//	a baseline when comparing tuning values.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class IdleController : public Controller
+{
+	public:
+		void Reset();						// Prepares for a fresh session.  
+		float Control(Simulation& Sim);		// Picks the rotation for a tick.  
+
+		int Hold(Simulation& Sim, float& x);	// Ticks it keeps a turn.  
+		void Skip(int ticks);				// Lets ticks pass with it held.  
+};
+
+#endif
\ No newline at end of file
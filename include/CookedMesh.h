@@ -0,0 +1,115 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	COOKED MESH MODULE																	//
+//	A binary mesh format made to be used straight from a memory mapping.  A cooked file	//
+//	is a small header followed by the vertex, index, attribute, material & level of		//
+//	detail arrays laid out exactly as MeshData holds them, each starting on a 64-byte	//
+//	boundary, so loading one is no more than mapping it & checking the header.  The		//
+//	vertices may instead be packed into less than half the space on disk, but as the	//
+//	fixed-function pipeline can't read them packed they are unpacked into a copy on		//
+//	loading, which costs the mapping its zero-copy open; packing is only done when		//
+//	asked for, & the shipped models are left unpacked.  Files are cooked from models	//
+//	ahead of time by TABTool.															//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _COOKEDMESH_H_
+#define _COOKEDMESH_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "MeshData.h"		// Flat mesh layout.  
+#include "MappedFile.h"		// Memory-mapped files.  
+#include "VertexPacker.h"	// Packed vertex layout.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	Settings for the cooked format.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define COOKED_MAGIC		0x4d424154	// "TABM", marking the start of a cooked mesh.  
+#define COOKED_VERSION		3			// The version of the file layout.  
+#define COOKED_ALIGNMENT	64			// The boundary each section starts on.  
+#define COOKED_EXTENSION	".tbm"		// The extension given to cooked meshes.  
+
+#define COOKED_VERTICES		0			// The section holding the vertices.  
+#define COOKED_INDICES		1			// The section holding the indices.  
+#define COOKED_ATTRIBUTES	2			// The section holding each face's material.  
+#define COOKED_MATERIALS	3			// The section holding the materials.  
+#define COOKED_LODS			4			// The section listing the levels of detail.  
+#define COOKED_SECTIONS		5			// The number of sections.  
+
+#define COOKED_PACKED		0x01		// The vertices are packed.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	FILE HEADER
+//	Stored at the start of every cooked mesh.  Files are written in little-endian byte
+//	order, which every platform the game runs on uses, so they are read as they lie.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct CookedSection
+{
+	unsigned long long	offset;			// Where the section starts in the file.  
+	unsigned int		count;			// The number of items in the section.  
+	unsigned int		stride;			// The size of each item.  
+};
+
+struct CookedHeader
+{
+	unsigned int		magic;			// Always COOKED_MAGIC.  
+	unsigned int		version;		// Always COOKED_VERSION.  
+	unsigned int		headerSize;		// The size of this header.  
+	unsigned int		flags;			// The COOKED_ flags the mesh was cooked with.  
+	unsigned long long	fileSize;		// The size of the whole file.  
+	unsigned long long	dataChecksum;	// Checksum of everything after the header.  
+	CookedSection		Sections[COOKED_SECTIONS];	// Where each array lies.  
+	PackedBounds		Bounds;			// The box packed positions lie in.  
+	unsigned long long	headerChecksum;	// Checksum of the header up to this point.  
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  The code for the methods is
+//	detailed in the module's source file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class CookedMesh
+{
+	public:
+		CookedMesh();							// Class constructor.  
+
+		bool Open(const char* path);			// Maps a cooked mesh & checks its header.  
+		void Close();							// Unmaps the mesh.  
+		bool Verify();							// Checks the checksum of the mesh's data.  
+
+		MeshView GetView();						// Reports a view of the mapped mesh.  
+		bool IsPacked();						// Reports whether the vertices are packed.  
+		unsigned long long GetChecksum();		// Reports the checksum of the data.  
+		size_t GetSize();						// Reports the size of the file.  
+		const char* GetError();					// Describes why opening failed.  
+
+		static bool Write(const char* path, const MeshView& Mesh, bool packed);	// Cooks.  
+		static void CookedPath(const char* path, char* Cooked, int length);	// Names it.  
+		static unsigned long long Checksum(const void* Data, size_t size);	// Hashes data.  
+
+	private:
+		bool Fail(const char* Message);			// Records an error & unmaps the file.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS OBJECTS
+	//////////////////////////////////////////////////////////////////////////////////////
+		MappedFile				File;			// The mapped file.  
+		const CookedHeader*		Header;			// The header, where it lies in the file.  
+		std::vector<MeshVertex>	Unpacked;		// The vertices, if they had to be unpacked.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS DATA
+	//////////////////////////////////////////////////////////////////////////////////////
+		const char*				Error;			// Why opening failed, if it did.  
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,77 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	DIRECT3D BACKEND MODULE																//
+//	Draws through the Direct3D device made by the settings class.  Each call is handed	//
+//	more or less straight to the device, as the backend's types are laid out the same	//
+//	as Direct3D's; meshes are kept as D3DX meshes, one for each mesh made.				//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _D3D9BACKEND_H_
+#define _D3D9BACKEND_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <d3d9.h>			// Library for DirectX 9.0c functionality.  
+#include <d3dx9.h>			// Extended library for DirectX 9.0c functionality.  
+#include <vector>			// Standard vector container.  
+#include "Defines.h"		// Library for the project's definitions & macros.  
+#include "RenderBackend.h"	// Render backend interface.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  The code for the methods is
+//	detailed in the module's source file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class D3D9Backend : public RenderBackend
+{
+	public:
+		D3D9Backend(IDirect3DDevice9* Device);	// Class constructor.  
+		~D3D9Backend();							// Class destructor.  
+
+		const char* GetName();					// Reports what the backend is.  
+		int GetWidth();							// Reports the width drawn to.  
+		int GetHeight();						// Reports the height drawn to.  
+
+		int CreateMesh(const MeshView& Level);	// Makes a mesh, or reports -1.  
+		void DestroyMesh(int mesh);				// Frees a mesh.  
+		unsigned int GetFaceCount(int mesh);	// Reports a mesh's triangles.  
+		size_t GetMeshBytes(int mesh);			// Reports a mesh's memory.  
+
+		void BeginScene();						// Starts a frame.  
+		void EndScene();						// Finishes drawing a frame.  
+		void Present();							// Shows the finished frame.  
+		void Clear(unsigned int flags, unsigned int colour, float depth,
+				   unsigned int stencil);		// Clears the given buffers.  
+
+		void SetTransform(int type, const Matrix& Transform);	// Sets a transform.  
+		void GetTransform(int type, Matrix& Transform);			// Reports a transform.  
+		void SetMaterial(const RenderMaterial& Material);		// Sets the material.  
+		void SetLight(const RenderLight& Light);				// Sets the light.  
+		void SetRenderState(int state, unsigned int value);		// Sets a render state.  
+
+		void DrawSubset(int mesh, unsigned int subset);			// Draws a subset.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS OBJECTS
+	//////////////////////////////////////////////////////////////////////////////////////
+	private:
+		IDirect3DDevice9*			Device;		// Pointer to the main Direct3D device.  
+		std::vector<ID3DXMesh*>		Buffers;	// The D3DX mesh of every mesh made.  
+
+		Matrix		Transforms[TRANSFORM_COUNT];	// The transforms last set.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS DATA
+	//////////////////////////////////////////////////////////////////////////////////////
+		int			width, height;		// The size of the viewport.  
+};
+
+#endif
\ No newline at end of file
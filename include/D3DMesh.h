@@ -23,7 +23,9 @@
 #include <d3dx9.h>		// Extended library for DirectX 9.0c functionality.  
 #include "Defines.h"	// Library for the project's definitions & macros.  
 #include "D3DSetup.h"	// Direct3D settings class.  
-#include "ColourRGB.h"	// RGB Colour datatype class.  
+#include "MeshCache.h"	// Shared mesh cache.  
+#include "RenderQueue.h"	// Sorted draw queue.  
+#include "MeshDraw.h"		// Mesh submission.  
 
 //////////////////////////////////////////////////////////////////////////////////////////
 //	CLASS HEADER
@@ -37,29 +39,27 @@ class D3DMesh
 		~D3DMesh();		// Class destructor.  
 		
 		// Fundamental functions for functionality required in all derived classes.  
-		void Load(LPCTSTR Filename);					// Loads in a specified .x mesh.  
-		void ChangeColour(int id, ColourRGB* Colour);	// Changes the main colour.  
+		bool Load(LPCTSTR Filename);					// Loads in a specified mesh.  
+		void ChangeColour(int id);	// Changes the main colour.  
 
 		int GetColourID();		// Reports the assigned colour ID given to it.  
 
 	protected:
-		void RenderMesh();		// Handles the main mesh rendering.  
+		void RenderMesh(int pass, const Matrix& World);	// Queues the mesh to be drawn.  
 
 	//////////////////////////////////////////////////////////////////////////////////////
 	//	CLASS OBJECTS
 	//////////////////////////////////////////////////////////////////////////////////////
-		IDirect3DDevice9*	Device;			// Pointer to the main Direct3D device.  
+		RenderBackend*		Backend;		// Pointer to the backend drawing the mesh.  
 
-		ID3DXMesh*			Mesh;			// Pointer to the class's stored mesh.  
-		ID3DXBuffer*		MaterialBuffer;	// The mesh's material buffer.  
-
-		D3DMATERIAL9*		Material;		// The materials used in the mesh.  
+		const MeshAsset*	Asset;			// The mesh & materials, shared with the cache.  
+		DrawableMesh		Drawable;		// The mesh as the draw module sees it.  
 	
 	//////////////////////////////////////////////////////////////////////////////////////
 	//	CLASS DATA
 	//////////////////////////////////////////////////////////////////////////////////////
 		DWORD				numMaterials;	// The number of materials used in the mesh.  
-		int					colour;			// The ID of the main material's current colour.  
+		int					colour;			// The palette colour the mesh is drawn in.  
 };
 
 #endif
\ No newline at end of file
@@ -21,11 +21,43 @@
 #include <d3d9.h>		// Main library for DirectX 9.0c functionality.  
 #include <d3dx9.h>		// Extended library for DirectX 9.0c functionality.  
 #include <dinput.h>		// Main library for DirectInput 8.0 functionality.  
+#include <atomic>		// Standard atomic operations.  
+#include <thread>		// Standard thread library.  
 #include "Defines.h"	// Library for the project's definitions & macros.  
 #include "D3DSetup.h"	// Direct3D settings class.  
+#include "D3D9Backend.h"	// Direct3D render backend.  
+#include "CommandBuffer.h"	// Recorded frame commands.  
+#include "StateCache.h"		// Redundant state filter.  
+#include "MeshCache.h"	// Shared mesh cache.  
+#include "RenderQueue.h"	// Sorted draw queue.  
 #include "GameLogic.h"	// Game Logic class.  
 #include "GUI.h"		// GUI management class.  
-#include "Timer.h"		// Timer class.  
+#include "Clock.h"		// Monotonic clock interface.  
+#include "FrameScheduler.h"	// Frame pacing class.  
+#include "TripleBuffer.h"	// Lock-free snapshot hand-over.  
+#include "Replay.h"		// Session recording & playback.  
+#include "StartupTimeline.h"	// Startup timing.  
+#include "AssetLoader.h"	// Background mesh reading.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	Settings for recording sessions.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define REPLAY_FILE		"LastSession.tbr"	// Where each session played is recorded.  
+#define MAX_PLAY_SPEED	8					// The fastest a replay can be played.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	SNAPSHOT STRUCTURE
+//	Everything the render thread needs from the simulation thread to draw a frame: the
+//	game as it stood after the last tick run, & the simulation thread's own timings.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct FrameSnapshot
+{
+	SimState	State;		// The game after the last tick run.  
+	float		idle;		// Share of the simulation thread's time spent asleep.  
+	float		jitter;		// Mean error in the simulation thread's pass length.  
+	float		work;		// Mean time the simulation thread spent on each pass.  
+};
 
 //////////////////////////////////////////////////////////////////////////////////////////
 //	CLASS HEADER
@@ -35,36 +67,70 @@
 class D3DRenderer
 {
 	public:
-		D3DRenderer(HINSTANCE hInstance, HWND hWnd);	// Class constructor.  
+		// Class constructor.  
+		D3DRenderer(HINSTANCE hInstance, HWND hWnd, const char* CommandLine);
 
 		void Render();									// Main render loop.  
 
 	private:
 		// Startup functions, run once during initialisation.  
 		void Init();				// Main initialisation function.  
+		void ReadCommandLine(const char* CommandLine);	// Reads the launch options.  
 		void SetUpLighting();		// Sets up lighting.  
+		void SetUpCamera();			// Works out the view & projection matrices.  
+		void ReportStartup();		// Lists the time taken to start up.  
+		static void PublishMesh(const char* path, const MeshView* Mesh, const char* error,
+								void* context);	// Hands a mesh read at startup to the cache.  
+
+		// Functions run on the simulation thread.  
+		void Simulate();			// Main loop of the simulation thread.  
+		void Tick();				// Reads input & advances the game by a tick.  
+		void Publish();				// Hands the game's state to the render thread.  
 
 		// Functions for assisting rendering, called for each frame.  
-		void RenderFrame();			// Renders a frame.  
+		void RenderFrame(const FrameSnapshot& Snapshot);	// Renders a frame.  
 		void ClearBuffers();		// Clears the necessary buffers.  
 		void SetView();				// Sets the viewport matrix.  
 		void SetProjection();		// Sets the projection matrix.  
-		void CheckKeyInput();		// Reads keyboard input.  
-		void CheckMouseInput();		// Reads mouse input.  
+		void CheckKeyInput(TickInput& Input);	// Reads keyboard input.  
+		void CheckMouseInput(TickInput& Input);	// Reads mouse input.  
 
-		void Exit();				// Exits the game completely.  
+		void Exit();				// Asks for the game to exit completely.  
 
 		HINSTANCE hInstance;		// Handle to the application instance.  
 		HWND hWnd;					// Handle to the Win32 window.  
 
 		D3DSetup Setup;				// Direct3D settings object.  
+		D3D9Backend* Backend;		// Render backend everything is drawn through.  
+		StateCache* Tracker;		// Drops settings the backend already has.  
+		CommandBuffer* Commands;	// Records each frame for the render backend.  
+		MeshCache Cache;			// Shared mesh cache object.  
+		RenderQueue Drawing;		// Sorted draw queue object.  
 		GameLogic* Ring;			// Game logic object.  
 		GUISystem GUI;				// GUI object.  
 
 		IDirect3D9*			d3d;	// A pointer to the Direct3D interface.  
 		IDirect3DDevice9*	Device;	// A pointer to the Direct3D device.  
 
-		Timer				Timer;	// Timer management object.  
+		Matrix				Viewpoint;	// The camera's view matrix.  
+		Matrix				Projection;	// The camera's projection matrix.  
+
+		SystemClock			SystemTime;	// The system's high-resolution clock.  
+		FrameScheduler		Scheduler;	// Frame pacing object for the render thread.  
+		FrameScheduler		Stepper;	// Tick pacing object for the simulation thread.  
+		StartupTimeline		Startup;	// Times each part of starting up.  
+		AssetLoader			Loader;		// Reads the meshes while Direct3D is set up.  
+		int					firstFrame;	// The startup span for the first frame, if unended.  
+
+		std::thread			Simulator;	// The thread ticking the game.  
+		TripleBuffer<FrameSnapshot>*	Frames;	// Hands states to the render thread.  
+		std::atomic<bool>	quitting;	// Set once either thread wants the game to exit.  
+
+		ReplayWriter		Recorder;	// Records the session being played.  
+		ReplayReader		Player;		// Plays back a recorded session.  
+		char		replay[MAX_PATH];	// The replay to play back, if any.  
+		int			speed;				// How many times faster than normal to play it.  
+		bool		rewinding;			// Whether the rewind key is held.  
 };
 
 #endif
\ No newline at end of file
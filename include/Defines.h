@@ -82,12 +82,14 @@
 #define ERROR_DEVICE_MSG	"Unable to create Direct3D device."
 #define ERROR_FONTDEV_MSG	"Unable to create Direct3D font device."
 #define ERROR_INTERFC_MSG	"Unable to create Direct3D interface."
+#define ERROR_MESH_MSG		"Unable to create Direct3D mesh."
 
 // Captions for error windows.  The actual captions are fairly self-explanatory as to what 
 // each is for.
 #define ERROR_DEVICE_TTL	"CreateDevice() Failed"
 #define ERROR_FONTDEV_TTL	"D3DXCreateFont() Failed"
 #define ERROR_INTERFC_TTL	"Direct3DCreate9() Failed"
+#define ERROR_MESH_TTL		"Mesh Load Failed"
 
 
 
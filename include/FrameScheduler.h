@@ -0,0 +1,99 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	FRAME SCHEDULER MODULE																//
+//	Class used for pacing a thread's main loop.  The scheduler hands out fixed-length	//
+//	simulation ticks from an accumulator and waits out the rest of each frame by		//
+//	sleeping, only spinning for the last fraction of a millisecond to hit the target	//
+//	cadence accurately.  It also keeps track of how idle the CPU was, how long each		//
+//	frame spent working and how far each frame strayed from the target length.  Each	//
+//	thread paced needs a scheduler of its own.											//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _FRAMESCHEDULER_H_
+#define _FRAMESCHEDULER_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "Clock.h"		// Monotonic clock interface.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	Default settings for the scheduler.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define DEFAULT_JITTER_BOUND	(2 * NS_PER_MS)	// Time left to spin out after sleeping.  
+#define MAX_TICKS_PER_FRAME		8				// Cap on ticks caught up in a frame.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  The code for the methods is
+//	detailed in the module's source file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class FrameScheduler
+{
+	public:
+		FrameScheduler(Clock* Time);		// Class constructor.  
+
+		void SetFrameRate(int fps);			// Sets the target frames per second.  
+		void SetTickRate(int tps);			// Sets the simulation ticks per second.  
+		void SetJitterBound(long long ns);	// Sets how early to stop sleeping.  
+
+		void Reset();						// Starts timing from the present moment.  
+		int BeginFrame();					// Reports how many ticks are due this frame.  
+		void EndFrame();					// Waits until the next frame is due.  
+
+		// Functions to report the statistics of the last full second of frames.  
+		float GetIdlePercent();				// Share of time spent asleep.  
+		float GetJitter();					// Mean frame length error in milliseconds.  
+		float GetMaxJitter();				// Worst frame length error in milliseconds.  
+		float GetWorkTime();				// Mean time spent working in milliseconds.  
+		float GetMaxWorkTime();				// Worst time spent working in milliseconds.  
+
+	private:
+		void Record(long long frameLength, long long slept, long long busy);
+											// Updates the statistics.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS OBJECTS
+	//////////////////////////////////////////////////////////////////////////////////////
+		Clock*		Time;				// The clock used for all timing.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS DATA
+	//////////////////////////////////////////////////////////////////////////////////////
+		long long	frame_time;			// The length of each frame in nanoseconds.  
+		long long	tick_time;			// The length of each tick in nanoseconds.  
+		long long	jitter_bound;		// How long before a deadline sleeping stops.  
+
+		long long	deadline;			// The time the next frame is due to start.  
+		long long	frame_start;		// The time the current frame started.  
+		long long	accumulator;		// Time waiting to be handed out as ticks.  
+		long long	slept;				// Time spent asleep at the end of the last frame.  
+		long long	busy;				// Time spent working in the last frame.  
+		bool		timing;				// Whether a frame has begun since the reset.  
+
+		// Running totals for the statistics currently being gathered.  
+		int			frames;				// Frames counted so far.  
+		long long	elapsed;			// Total length of the counted frames.  
+		long long	asleep;				// Total time spent asleep.  
+		long long	error;				// Total distance from the target frame length.  
+		long long	worst;				// Largest distance from the target frame length.  
+		long long	working;			// Total time spent working.  
+		long long	worst_work;			// Longest time spent working in a frame.  
+
+		// Statistics from the last complete second of frames.  
+		float		idle_percent;		// Share of time spent asleep.  
+		float		jitter;				// Mean frame length error in milliseconds.  
+		float		max_jitter;			// Worst frame length error in milliseconds.  
+		float		work_time;			// Mean time spent working in milliseconds.  
+		float		max_work_time;		// Worst time spent working in milliseconds.  
+};
+
+#endif
\ No newline at end of file
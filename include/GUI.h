@@ -37,6 +37,12 @@ class GUISystem
 		bool CreateFont();							// Creates the font device.  
 
 		void RenderScore(int level, int score);		// Renders the score onto the screen.
+		void RenderTiming(float idle, float jitter, float work);	// Renders the frame timings.  
+		void RenderTicking(float idle, float jitter, float work);	// Renders the tick timings.  
+		void RenderDetail(const int* Faces, int levels);	// Renders triangles per level.  
+		void RenderBatching(int draws, int batches, int materials, int transforms,
+							int issued, int elided);
+													// Renders the draws made.  
 
 	//////////////////////////////////////////////////////////////////////////////////////
 	//	CLASS OBJECTS
@@ -46,6 +52,10 @@ class GUISystem
 		
 		TextBox* Level;		// Text box to store the current level.  
 		TextBox* Score;		// Text box to store the progress to the next level.  
+		TextBox* Timing;	// Text box to store the frame timing statistics.  
+		TextBox* Ticking;	// Text box to store the simulation timing statistics.  
+		TextBox* Detail;	// Text box to store the triangles drawn per level of detail.  
+		TextBox* Batching;	// Text box to store the draws & state changes made.  
 };
 
 #endif
\ No newline at end of file
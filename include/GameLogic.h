@@ -9,7 +9,8 @@
 //////////////////////////////////////////////////////////////////////////////////////////
 //	GAME LOGIC MODULE																	//
 //	The primary class for the game's logic algorithms.  The module handles the main		//
-//	organisation of the game.															//
+//	organisation of the game, drawing the ring & ball over the state held by the		//
+//	simulation module.																	//
 //////////////////////////////////////////////////////////////////////////////////////////
 #ifndef _GAMELOGIC_H_
 #define _GAMELOGIC_H_
@@ -23,6 +24,18 @@
 #include "D3DSetup.h"	// Direct3D settings class.
 #include "MeshRing.h"	// Ring block class.
 #include "MeshBall.h"	// Ball class.  
+#include "Simulation.h"	// Renderer-free game simulation.  
+#include "SnapshotRing.h"	// Fixed-size snapshot history.  
+#include "SceneGraph.h"	// Transform hierarchy.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	Settings for the game's history & the models it draws.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define REWIND_TICKS	1024	// Ticks of history kept for rewinding (8.5s at 120Hz).  
+#define BLOCK_MODEL		"Block.ms3d"	// The model drawn for each block.  
+#define BALL_MODEL		"Ball.ms3d"		// The model drawn for the ball.  
+#define BALL_Z			-2.5f	// How far the ball sits in front of the ring's centre.  
 
 //////////////////////////////////////////////////////////////////////////////////////////
 //	CLASS HEADER
@@ -32,23 +45,29 @@
 class GameLogic
 {
 	public:
-		GameLogic();			// Class constructor.  
+		GameLogic(const RandomStream& Random);	// Class constructor.  
 
-		bool Render();			// Renders all of the various elements of the game.  
+		bool Update();			// Advances the game's simulation by one tick.  
+		void Render(const SimState& State);	// Renders the game as it was in a state.  
 
 		void Rotate(float x);	// Moves the ring based on a given amount.  
+		void Apply(const TickInput& Input);	// Moves the ring by a tick's input.  
 
+		// Functions to store & go back through the game's history.  
+		void Save();						// Stores the state at the start of a tick.  
+		bool Rewind();						// Goes back to the last stored tick.  
+		void Restore(const SimState& State);	// Carries the game on from a state.  
+
+		const SimState& GetState();	// Reports the full state of the game.  
 		int GetLevel();			// Gets the current level.  
 		int GetScore();			// Gets the current progress towards the next level.  
 
 	private:
 		void Load();			// Loads in the various meshes.  
 
-		void DrawShadow();		// Draws the shadow of the ball on the ring.  
-		void ChangeColours();	// Changes the colours of the ball & ring.  
-		void IncreaseScore();	// Increases the score after a successful bounce.  
-
-		int GetBlockBelow();	// Reports the ID of the block below the ball.  
+		void Place(const SimState& State);	// Moves the scene's nodes to a state.  
+		void DrawShadow(float y);	// Draws the shadow of the ball on the ring.  
+		void SyncColours(const SimState& State);	// Matches the mesh colours to a state.  
 
 	//////////////////////////////////////////////////////////////////////////////////////
 	//	CLASS OBJECTS
@@ -58,16 +77,21 @@ class GameLogic
 		ColourRGB*	Colour[NUM_COLOURS];	// The six colours that are used in the game.  
 
 		// Objects used for shadow rendering.  
-		D3DXVECTOR4		LightRay;			// Vector to store a light ray.  
-		D3DXPLANE		BasePlane;			// Plane to act as calculate the geometry.  
-		D3DMATERIAL9	BlackMatter;		// Material used for drawing the shadows.  
+		Vector4			LightRay;			// Vector to store a light ray.  
+		Plane			BasePlane;			// Plane to act as calculate the geometry.  
+		RenderMaterial	BlackMatter;		// Material used for drawing the shadows.  
 
-	//////////////////////////////////////////////////////////////////////////////////////
-	//	CLASS DATA
-	//////////////////////////////////////////////////////////////////////////////////////
-		int level;		// The level of the game.  
-		int score;		// The score during the game.  
-		float x;
+		// Objects used for placing the models.  
+		SceneGraph		Scene;				// The ring, its blocks & the ball.  
+		int				ringNode;			// The node turning the whole ring.  
+		int				blockNode[NUM_BLOCKS];	// The node of each block on the ring.  
+		int				ballNode;			// The node of the ball.  
+		float			placedAngle;		// The ring's last rotation in the scene.  
+		float			placedHeight;		// The ball's height the scene was last given.  
+
+		Simulation		Sim;				// The game's rules & state.  
+
+		SnapshotRing<SimState, REWIND_TICKS>	History;	// The game's recent states.  
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,90 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MS3D PARSER MODULE																	//
+//	Reads meshes straight from MilkShape 3D .ms3d files, so the models can be used		//
+//	without exporting them first.  The vertex, triangle, group & material chunks are	//
+//	read in place from the mapped file, and the joints & animation that follow them		//
+//	are ignored.  Meshes are converted into the same space as the exported .x files.	//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _MS3DPARSER_H_
+#define _MS3DPARSER_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <stddef.h>		// Standard definitions, for size_t.  
+#include <vector>		// Standard vector container.  
+#include "MeshData.h"	// Flat mesh layout.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	Conversion from MilkShape's space to the one the game's models are exported in.  
+//	The exporter scales each model down by ten & mirrors it along the z-axis.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define MS3D_SCALE			0.1f		// The scale applied to every position.  
+#define MS3D_EXTENSION		".ms3d"		// The extension given to MilkShape files.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  The code for the methods is
+//	detailed in the module's source file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class MS3DParser
+{
+	public:
+		MS3DParser();								// Class constructor.  
+
+		bool Load(const char* path, MeshData& Mesh);	// Maps & parses a file.  
+		bool Parse(const char* Data, size_t size, MeshData& Mesh);	// Parses data.  
+
+		const char* GetError();						// Describes why parsing failed.  
+
+		static bool Matches(const char* path);		// Checks for a .ms3d file name.  
+
+	private:
+		// Functions for reading the file a piece at a time.  
+		const char* Take(size_t size);				// Steps over a given number of bytes.  
+		bool ReadWord(unsigned int& value);			// Reads a 16-bit count.  
+
+		// Functions for reading each chunk.  
+		bool ReadGroups();							// Reads the material of each group.  
+		bool ReadMaterials();						// Reads the materials.  
+		bool BuildMesh();							// Adds the triangles to the output.  
+
+		bool Fail(const char* Problem);				// Records an error.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS OBJECTS
+	//////////////////////////////////////////////////////////////////////////////////////
+		MeshData*				Output;			// The mesh being read into.  
+
+		// Scratch space, kept between files so that parsing doesn't allocate once warm.  
+		std::vector<int>		GroupMaterials;	// The material used by each group.  
+		std::vector<int>		First;			// First vertex made from each position.  
+		std::vector<int>		Next;			// Next vertex made from the same position.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS DATA
+	//////////////////////////////////////////////////////////////////////////////////////
+		const char*		Begin;			// The start of the file.  
+		const char*		Cursor;			// The next byte to be read.  
+		const char*		End;			// The end of the file.  
+
+		const char*		Positions;		// Where the vertex chunk lies in the file.  
+		const char*		Triangles;		// Where the triangle chunk lies in the file.  
+		unsigned int	numPositions;	// The number of vertices in the file.  
+		unsigned int	numTriangles;	// The number of triangles in the file.  
+
+		const char*		Error;			// Why parsing failed, if it did.  
+		char			Message[128];	// Space for building the error message.  
+};
+
+#endif
\ No newline at end of file
@@ -7,39 +7,53 @@
 //////////////////////////////////////////////////////////////////////////////////////////
 
 //////////////////////////////////////////////////////////////////////////////////////////
-//	TIMER MODULE																		//
-//	Class used for keeping time between frames.											//
+//	MAPPED FILE MODULE																	//
+//	Gives read-only access to a whole file by mapping it into memory, so that it can	//
+//	be parsed in place without copying it into a buffer first.  Uses the Win32 file		//
+//	mapping functions on Windows & mmap() elsewhere.									//
 //////////////////////////////////////////////////////////////////////////////////////////
-#ifndef _TIMER_H_
-#define _TIMER_H_
+#ifndef _MAPPEDFILE_H_
+#define _MAPPEDFILE_H_
 
 //////////////////////////////////////////////////////////////////////////////////////////
 //	LIBRARY INCLUDES
 //	The libraries & namespaces required for the module.  
 //////////////////////////////////////////////////////////////////////////////////////////
-#include <windows.h>		// Standard Win32 library.  
+#include <stddef.h>		// Standard definitions, for size_t.  
 
 //////////////////////////////////////////////////////////////////////////////////////////
 //	CLASS HEADER
-//	Declaration of all required class methods and data.  The code for the methods is 
+//	Declaration of all required class methods and data.  The code for the methods is
 //	detailed in the module's source file.  
 //////////////////////////////////////////////////////////////////////////////////////////
-class Timer
+class MappedFile
 {
 	public:
-		Timer();					// Class constructor.  
+		MappedFile();						// Class constructor.  
+		~MappedFile();						// Class destructor.  
 
-		void SetFrameRate(int fps);	// Sets the FPS for the application.  
-		void Reset();				// Resets the counter of time between frames.  
-		bool NextFrame();			// Checks whether to render the next frame.  
+		bool Open(const char* path);		// Maps the given file into memory.  
+		void Close();						// Unmaps the file.  
+
+		const char* GetData();				// Reports where the file starts in memory.  
+		size_t GetSize();					// Reports the size of the file in bytes.  
+
+	private:
+		MappedFile(const MappedFile&);				// Mappings can't be copied.  
+		MappedFile& operator=(const MappedFile&);
 
 	//////////////////////////////////////////////////////////////////////////////////////
-	//	CLASS OBJECTS
+	//	CLASS DATA
 	//////////////////////////////////////////////////////////////////////////////////////
-	private:
-		DWORD starting_point;		// The time since the last frame was renderer;  
+		const char*		Data;				// The start of the file in memory.  
+		size_t			size;				// The size of the file in bytes.  
 
-		int frame_time;				// The time in milliseconds for each frame.  
+#ifdef _WIN32
+		void*			File;				// Handle to the open file.  
+		void*			Mapping;			// Handle to the file's mapping.  
+#else
+		int				file;				// Descriptor of the open file.  
+#endif
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,355 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MATRIX MODULE																		//
+//	The vectors, planes & 4x4 matrices the game needs, with the handful of builders it	//
+//	uses, laid out the same as Direct3D's so that either can be handed to the other.	//
+//	Vectors are rows multiplied on the left, as in Direct3D, so a matrix's translation	//
+//	lies along its bottom row.  Everything lives in the header so that it can be		//
+//	inlined, & anything that needs no maths library can be built at compile time.		//
+//	Multiplying matrices & transforming points use SSE on x86 & NEON on ARM, adding up	//
+//	in the same order as the plain code so that every path gives exactly the same		//
+//	result; defining MATH_SCALAR forces the plain code everywhere.						//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _MATRIX_H_
+#define _MATRIX_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <math.h>			// Standard math library.  
+#include <type_traits>		// Standard type traits, for checking the types are plain data.  
+
+#if defined(MATH_SCALAR)
+	// The plain code is used everywhere.  
+#elif defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+	#define MATH_SSE
+	#include <xmmintrin.h>		// SSE intrinsics.  
+#elif defined(__ARM_NEON) || defined(_M_ARM) || defined(_M_ARM64)
+	#define MATH_NEON
+	#include <arm_neon.h>		// NEON intrinsics.  
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	VECTOR STRUCTURES
+//	Points & directions in three dimensions, & in four for those that need a w.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct Vector3
+{
+	float	x, y, z;				// The values.  
+
+	Vector3() = default;								// Leaves the values unset.  
+	constexpr Vector3(float x, float y, float z)		// Sets each value.  
+	: x(x), y(y), z(z) {}
+
+	static constexpr float Dot(const Vector3& A, const Vector3& B)	// Dot product.  
+	{
+		return A.x * B.x + A.y * B.y + A.z * B.z;
+	}
+	static constexpr Vector3 Cross(const Vector3& A, const Vector3& B)	// Cross product.  
+	{
+		return Vector3(A.y * B.z - A.z * B.y, A.z * B.x - A.x * B.z, A.x * B.y - A.y * B.x);
+	}
+	static Vector3 Normalise(const Vector3& A);			// Scales to a length of 1.  
+};
+
+struct Vector4
+{
+	float	x, y, z, w;				// The values.  
+
+	Vector4() = default;								// Leaves the values unset.  
+	constexpr Vector4(float x, float y, float z, float w)	// Sets each value.  
+	: x(x), y(y), z(z), w(w) {}
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PLANE STRUCTURE
+//	A plane of the points where ax + by + cz + d = 0.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct Plane
+{
+	float	a, b, c, d;				// The values.  
+
+	Plane() = default;									// Leaves the values unset.  
+	constexpr Plane(float a, float b, float c, float d)	// Sets each value.  
+	: a(a), b(b), c(c), d(d) {}
+
+	constexpr float Dot(const Vector4& V) const			// Measures a point against it.  
+	{
+		return a * V.x + b * V.y + c * V.z + d * V.w;
+	}
+	Plane Normalise() const;							// Makes the normal's length 1.  
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MATRIX STRUCTURE
+//	The sixteen values, row by row, along with functions to build the common matrices.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct Matrix
+{
+	float	m[4][4];				// The values, indexed by row then column.  
+
+	Matrix() = default;										// Leaves the values unset.  
+	constexpr Matrix(float _11, float _12, float _13, float _14,
+					 float _21, float _22, float _23, float _24,
+					 float _31, float _32, float _33, float _34,
+					 float _41, float _42, float _43, float _44)	// Sets each value.  
+	: m{ { _11, _12, _13, _14 }, { _21, _22, _23, _24 },
+		 { _31, _32, _33, _34 }, { _41, _42, _43, _44 } } {}
+
+	static constexpr Matrix Identity();						// Changes nothing.  
+	static constexpr Matrix Translation(float x, float y, float z);	// Moves by an offset.  
+	static Matrix Multiply(const Matrix& A, const Matrix& B);	// Applies A then B.  
+	static Matrix MultiplyScalar(const Matrix& A, const Matrix& B);	// The same, plainly.  
+	static Matrix RotationY(float angle);					// Turns about the y-axis.  
+	static Matrix LookAtLH(const Vector3& Eye, const Vector3& At, const Vector3& Up);
+															// A view.  
+	static Matrix PerspectiveFovLH(float fov, float aspect, float zn, float zf);
+															// A perspective projection.  
+	static Matrix Shadow(const Vector4& Light, const Plane& Base);	// Flattens onto a plane.  
+
+	Vector4 Transform(const float* In) const;				// Moves a point, keeping w.  
+	Vector4 TransformScalar(const float* In) const;			// The same, plainly.  
+	void TransformCoord(const float* In, float* Out) const;		// Moves a point.  
+	void TransformNormal(const float* In, float* Out) const;	// Turns a direction.  
+};
+
+static_assert(std::is_trivially_copyable<Matrix>::value && (sizeof(Matrix) == 64),
+			  "Matrices must be sixteen plain floats, as Direct3D's are.");
+static_assert(std::is_trivially_copyable<Vector4>::value && (sizeof(Vector4) == 16),
+			  "Vectors must be four plain floats.");
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	INLINE METHODS
+//	The code for the methods, kept in the header so that it can be inlined.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to scale a vector to a length of 1.  
+//////////////////////////////////////////////////////////////////////////////////////////
+inline Vector3 Vector3::Normalise(const Vector3& A)
+{
+	float length = sqrtf(Vector3::Dot(A, A));
+	return Vector3(A.x / length, A.y / length, A.z / length);
+}
+
+//	Function to scale a plane so that its normal has a length of 1, as
+//	D3DXPlaneNormalize().  
+//////////////////////////////////////////////////////////////////////////////////////////
+inline Plane Plane::Normalise() const
+{
+	float length = sqrtf(a * a + b * b + c * c);
+	return Plane(a / length, b / length, c / length, d / length);
+}
+
+//	Function to build a matrix that leaves everything as it is.  
+//////////////////////////////////////////////////////////////////////////////////////////
+inline constexpr Matrix Matrix::Identity()
+{
+	return Matrix(1.0f, 0.0f, 0.0f, 0.0f,
+				  0.0f, 1.0f, 0.0f, 0.0f,
+				  0.0f, 0.0f, 1.0f, 0.0f,
+				  0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+//	Function to build a move by the given offset.  
+//////////////////////////////////////////////////////////////////////////////////////////
+inline constexpr Matrix Matrix::Translation(float x, float y, float z)
+{
+	return Matrix(1.0f, 0.0f, 0.0f, 0.0f,
+				  0.0f, 1.0f, 0.0f, 0.0f,
+				  0.0f, 0.0f, 1.0f, 0.0f,
+				  x,    y,    z,    1.0f);
+}
+
+//	Function to combine two matrices into one that applies the first & then the second.  
+//	Each row of the result is the rows of the second matrix scaled by the first's row &
+//	added up, which the vector paths do four columns at a time.  
+//////////////////////////////////////////////////////////////////////////////////////////
+inline Matrix Matrix::Multiply(const Matrix& A, const Matrix& B)
+{
+#if defined(MATH_SSE)
+	__m128 Row0 = _mm_loadu_ps(B.m[0]);
+	__m128 Row1 = _mm_loadu_ps(B.m[1]);
+	__m128 Row2 = _mm_loadu_ps(B.m[2]);
+	__m128 Row3 = _mm_loadu_ps(B.m[3]);
+
+	Matrix Out;
+	for (int r = 0 ; r < 4 ; r++)
+	{
+		// Loads the first's row once & spreads each of its values across a register from
+		// there, rather than reading each value from memory by itself.  
+		__m128 In = _mm_loadu_ps(A.m[r]);
+		__m128 Sum = _mm_mul_ps(_mm_shuffle_ps(In, In, 0x00), Row0);
+		Sum = _mm_add_ps(Sum, _mm_mul_ps(_mm_shuffle_ps(In, In, 0x55), Row1));
+		Sum = _mm_add_ps(Sum, _mm_mul_ps(_mm_shuffle_ps(In, In, 0xaa), Row2));
+		Sum = _mm_add_ps(Sum, _mm_mul_ps(_mm_shuffle_ps(In, In, 0xff), Row3));
+		_mm_storeu_ps(Out.m[r], Sum);
+	}
+	return Out;
+#elif defined(MATH_NEON)
+	float32x4_t Row0 = vld1q_f32(B.m[0]);
+	float32x4_t Row1 = vld1q_f32(B.m[1]);
+	float32x4_t Row2 = vld1q_f32(B.m[2]);
+	float32x4_t Row3 = vld1q_f32(B.m[3]);
+
+	Matrix Out;
+	for (int r = 0 ; r < 4 ; r++)
+	{
+		float32x4_t Sum = vmulq_n_f32(Row0, A.m[r][0]);
+		Sum = vaddq_f32(Sum, vmulq_n_f32(Row1, A.m[r][1]));
+		Sum = vaddq_f32(Sum, vmulq_n_f32(Row2, A.m[r][2]));
+		Sum = vaddq_f32(Sum, vmulq_n_f32(Row3, A.m[r][3]));
+		vst1q_f32(Out.m[r], Sum);
+	}
+	return Out;
+#else
+	return Matrix::MultiplyScalar(A, B);
+#endif
+}
+
+//	Function to combine two matrices without the vector paths, which every path must
+//	match exactly.  
+//////////////////////////////////////////////////////////////////////////////////////////
+inline Matrix Matrix::MultiplyScalar(const Matrix& A, const Matrix& B)
+{
+	Matrix Out;
+	for (int r = 0 ; r < 4 ; r++)
+		for (int c = 0 ; c < 4 ; c++)
+			Out.m[r][c] = A.m[r][0] * B.m[0][c] + A.m[r][1] * B.m[1][c] +
+						  A.m[r][2] * B.m[2][c] + A.m[r][3] * B.m[3][c];
+	return Out;
+}
+
+//	Function to build a rotation about the y-axis by the given angle in radians, turning
+//	clockwise when looking down the axis towards the origin, as D3DXMatrixRotationY().  
+//////////////////////////////////////////////////////////////////////////////////////////
+inline Matrix Matrix::RotationY(float angle)
+{
+	float s = sinf(angle);
+	float c = cosf(angle);
+
+	return Matrix(c,    0.0f, -s,   0.0f,
+				  0.0f, 1.0f, 0.0f, 0.0f,
+				  s,    0.0f, c,    0.0f,
+				  0.0f, 0.0f, 0.0f, 1.0f);
+}
+
+//	Function to build a left-handed view from the eye towards a point, with the given
+//	direction as up, as D3DXMatrixLookAtLH().  
+//////////////////////////////////////////////////////////////////////////////////////////
+inline Matrix Matrix::LookAtLH(const Vector3& Eye, const Vector3& At, const Vector3& Up)
+{
+	Vector3 z = Vector3::Normalise(Vector3(At.x - Eye.x, At.y - Eye.y, At.z - Eye.z));
+	Vector3 x = Vector3::Normalise(Vector3::Cross(Up, z));	// At right angles to both.  
+	Vector3 y = Vector3::Cross(z, x);
+
+	return Matrix(x.x, y.x, z.x, 0.0f,
+				  x.y, y.y, z.y, 0.0f,
+				  x.z, y.z, z.z, 0.0f,
+				  -Vector3::Dot(x, Eye), -Vector3::Dot(y, Eye), -Vector3::Dot(z, Eye), 1.0f);
+}
+
+//	Function to build a left-handed perspective projection from the vertical field of
+//	view in radians, the width over the height & the near & far planes, putting depth in
+//	0 to 1, as D3DXMatrixPerspectiveFovLH().  
+//////////////////////////////////////////////////////////////////////////////////////////
+inline Matrix Matrix::PerspectiveFovLH(float fov, float aspect, float zn, float zf)
+{
+	float yScale = 1.0f / tanf(fov * 0.5f);
+
+	return Matrix(yScale / aspect, 0.0f,   0.0f,                  0.0f,
+				  0.0f,            yScale, 0.0f,                  0.0f,
+				  0.0f,            0.0f,   zf / (zf - zn),        1.0f,
+				  0.0f,            0.0f,   -zn * zf / (zf - zn),  0.0f);
+}
+
+//	Function to build a matrix that flattens geometry onto a plane as seen from a light
+//	(x, y, z, w), where a w of 0 is a light infinitely far off in that direction, as
+//	D3DXMatrixShadow().  
+//////////////////////////////////////////////////////////////////////////////////////////
+inline Matrix Matrix::Shadow(const Vector4& Light, const Plane& Base)
+{
+	Plane P = Base.Normalise();
+	float dot = P.Dot(Light);
+
+	const float L[4] = { Light.x, Light.y, Light.z, Light.w };
+	const float N[4] = { P.a, P.b, P.c, P.d };
+
+	Matrix Out;
+	for (int r = 0 ; r < 4 ; r++)
+		for (int c = 0 ; c < 4 ; c++)
+			Out.m[r][c] = ((r == c) ? dot : 0.0f) - N[r] * L[c];
+	return Out;
+}
+
+//	Function to move a point by the matrix, keeping the w it ends up with rather than
+//	dividing through by it, as is needed before clipping.  
+//////////////////////////////////////////////////////////////////////////////////////////
+inline Vector4 Matrix::Transform(const float* In) const
+{
+#if defined(MATH_SSE)
+	__m128 Sum = _mm_mul_ps(_mm_set1_ps(In[0]), _mm_loadu_ps(m[0]));
+	Sum = _mm_add_ps(Sum, _mm_mul_ps(_mm_set1_ps(In[1]), _mm_loadu_ps(m[1])));
+	Sum = _mm_add_ps(Sum, _mm_mul_ps(_mm_set1_ps(In[2]), _mm_loadu_ps(m[2])));
+	Sum = _mm_add_ps(Sum, _mm_loadu_ps(m[3]));
+
+	Vector4 Out;
+	_mm_storeu_ps(&Out.x, Sum);
+	return Out;
+#elif defined(MATH_NEON)
+	float32x4_t Sum = vmulq_n_f32(vld1q_f32(m[0]), In[0]);
+	Sum = vaddq_f32(Sum, vmulq_n_f32(vld1q_f32(m[1]), In[1]));
+	Sum = vaddq_f32(Sum, vmulq_n_f32(vld1q_f32(m[2]), In[2]));
+	Sum = vaddq_f32(Sum, vld1q_f32(m[3]));
+
+	Vector4 Out;
+	vst1q_f32(&Out.x, Sum);
+	return Out;
+#else
+	return this->TransformScalar(In);
+#endif
+}
+
+//	Function to move a point by the matrix without the vector paths, which every path
+//	must match exactly.  
+//////////////////////////////////////////////////////////////////////////////////////////
+inline Vector4 Matrix::TransformScalar(const float* In) const
+{
+	return Vector4(In[0] * m[0][0] + In[1] * m[1][0] + In[2] * m[2][0] + m[3][0],
+				   In[0] * m[0][1] + In[1] * m[1][1] + In[2] * m[2][1] + m[3][1],
+				   In[0] * m[0][2] + In[1] * m[1][2] + In[2] * m[2][2] + m[3][2],
+				   In[0] * m[0][3] + In[1] * m[1][3] + In[2] * m[2][3] + m[3][3]);
+}
+
+//	Function to move a point by the matrix, dividing through by w afterwards.  
+//////////////////////////////////////////////////////////////////////////////////////////
+inline void Matrix::TransformCoord(const float* In, float* Out) const
+{
+	Vector4 Moved = this->Transform(In);
+
+	Out[0] = Moved.x / Moved.w;
+	Out[1] = Moved.y / Moved.w;
+	Out[2] = Moved.z / Moved.w;
+}
+
+//	Function to turn a direction by the matrix, leaving out its translation.  
+//////////////////////////////////////////////////////////////////////////////////////////
+inline void Matrix::TransformNormal(const float* In, float* Out) const
+{
+	float x = In[0] * m[0][0] + In[1] * m[1][0] + In[2] * m[2][0];
+	float y = In[0] * m[0][1] + In[1] * m[1][1] + In[2] * m[2][1];
+	float z = In[0] * m[0][2] + In[1] * m[1][2] + In[2] * m[2][2];
+
+	Out[0] = x;
+	Out[1] = y;
+	Out[2] = z;
+}
+
+#endif
\ No newline at end of file
@@ -10,6 +10,8 @@
 //	BALL CLASS MODULE																	//
 //	The datatype class to handle the game's ball.  The class is derived from the		//
 //	Direct3D mesh class and also includes extra data & functions specific to the ball.	//
+//	The ball's motion itself is worked out by the simulation module; this class only	//
+//	draws the ball wherever the simulation says it is.									//
 //////////////////////////////////////////////////////////////////////////////////////////
 #ifndef _MESHBALL_H_
 #define _MESHBALL_H_
@@ -32,31 +34,9 @@ class BallMesh : public D3DMesh
 		BallMesh();					// Class constructor.  
 
 		// Functions to handle the ball's rendering.  
-		void Render();				// Renders the model onto the screen.  
-		void RenderShadow();		// Renders the ball's shadow via the stencil buffer.  
-
-		// Functions to modify the ball's behaviour.  
-		void Bounce();				// Launches the ball into the air again.  
-		void ChangeGravity();		// Modifies the gravity of the ball for harder levels.  
-
-		// Functions to check ball data for comparisons.  
-		bool Bounced();		// Checks whether the ball has bounced in the current frame.  
-		bool Fallen();		// Checks whether the ball has falled through the ring.  
-		float GetY();		// Reports the y-value of the ball.  
-
-	private:
-		void Translate();			// Sets the translation of the ball's mesh.  
-	//////////////////////////////////////////////////////////////////////////////////////
-	//	CLASS OBJECTS
-	//////////////////////////////////////////////////////////////////////////////////////
-		D3DXMATRIX	Translation;	// Matrix to store values for the translation.  
-
-	//////////////////////////////////////////////////////////////////////////////////////
-	//	CLASS DATA
-	//////////////////////////////////////////////////////////////////////////////////////
-		float		gravity;		// The gravitational constant in use by the ball.  
-		float		y;				// The position of the ball in the y-axis.  
-		int			t;				// The amount of time passed since the last bounce.  
+		void Render(const Matrix& World);	// Renders the model onto the screen.  
+		void RenderShadow(const Matrix& Shadow, const RenderMaterial* Matter);
+									// Renders the ball's shadow via the stencil buffer.  
 };
 
 #endif
\ No newline at end of file
@@ -0,0 +1,116 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MESH CACHE MODULE																	//
+//	Keeps a single copy of each mesh loaded by the game, however many objects draw it.	//
+//	Meshes are looked up first by the name they were loaded under & then by a			//
+//	fingerprint of their content, so the same model under two names is still only held	//
+//	once.  Each mesh is counted as it is handed out & freed once the last object using	//
+//	it lets it go.  The cache also counts the triangles drawn from each level of detail	//
+//	every frame.																		//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _MESHCACHE_H_
+#define _MESHCACHE_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <d3d9.h>		// Library for DirectX 9.0c functionality.  
+#include <d3dx9.h>		// Extended library for DirectX 9.0c functionality.  
+#include <vector>		// Standard vector container.  
+#include <string>		// Standard string class.  
+#include "Defines.h"	// Library for the project's definitions & macros.  
+#include "Singleton.h"	// Singleton class.  
+#include "MeshData.h"	// Flat mesh layout.  
+#include "RenderBackend.h"	// Render backend interface.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	Simplifies the call for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define Meshes		MeshCache::GetSingleton()
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	ASSET STRUCTURE
+//	A mesh held by the cache.  Everything in it is shared by every object drawing the
+//	mesh, so it is never changed once built; objects' own colours are put into the
+//	materials by the render queue as they are drawn.  Each level of detail is its own
+//	mesh in the render backend, with level 0 the full mesh, and all of them use the same
+//	materials.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct MeshAsset
+{
+	int							Lods[MESH_MAX_LODS];	// The backend's mesh of each level.  
+	float						Errors[MESH_MAX_LODS];	// How far each level strays.  
+	DWORD						numLods;		// The number of levels.  
+	RenderMaterial*				Materials;		// The materials as they were loaded.  
+	DWORD						numMaterials;	// The number of materials.  
+
+	unsigned long long			fingerprint;	// Checksum of the mesh's content.  
+	size_t						bytes;			// Memory taken up by the mesh.  
+	int							users;			// Objects currently using the mesh.  
+
+	std::vector<std::string>	Names;			// Every name it has been loaded under.  
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  The code for the methods is 
+//	detailed in the module's source file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class MeshCache : public CSingleton <MeshCache>
+{
+	public:
+		MeshCache();		// Class constructor.  
+		~MeshCache();		// Class destructor.  
+
+		const MeshAsset* Acquire(const char* path);	// Hands out a mesh, loading it if new.  
+		bool Publish(const char* path, const MeshView& Data);	// Adds a mesh read elsewhere.  
+		void Release(const MeshAsset* Asset);		// Lets go of a mesh handed out.  
+
+		void SetBackend(RenderBackend* Backend);	// Sets where meshes are made.  
+		RenderBackend* GetBackend();				// Reports where meshes are made.  
+
+		// Functions to report what the cache is holding.  
+		int GetAssetCount();		// Reports the number of meshes held.  
+		size_t GetResidentBytes();	// Reports the memory taken by every mesh held.  
+		void Report();				// Lists every mesh held to the debugger.  
+
+		// Functions to count the triangles drawn from each level of detail.  
+		void CountDrawn(DWORD level, DWORD faces);	// Adds to the current frame's count.  
+		void EndFrame();							// Keeps the counts of a whole frame.  
+		int GetDrawnFaces(DWORD level);				// Reports the last frame's count.  
+
+	private:
+		MeshAsset* FindName(const char* path);			// Looks for a name loaded before.  
+		MeshAsset* FindContent(unsigned long long fingerprint);	// Looks for a match.  
+		MeshAsset* Insert(const char* path, const MeshView& Data);	// Holds a new mesh.  
+		MeshAsset* Build(const MeshView& Data);			// Creates the backend's meshes.  
+		void Destroy(MeshAsset* Asset);					// Frees a mesh.  
+
+		static unsigned long long Fingerprint(const MeshView& Data);	// Hashes a mesh.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS OBJECTS
+	//////////////////////////////////////////////////////////////////////////////////////
+		std::vector<MeshAsset*>		Assets;		// Every mesh held.  
+		RenderBackend*				Backend;	// Where the meshes are made & drawn.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS DATA
+	//////////////////////////////////////////////////////////////////////////////////////
+		int		loads;			// Meshes read from disk.  
+		int		hits;			// Meshes handed out without being read again.  
+
+		int		drawing[MESH_MAX_LODS];	// Triangles drawn from each level this frame.  
+		int		drawn[MESH_MAX_LODS];	// Triangles drawn from each level last frame.  
+};
+
+#endif
\ No newline at end of file
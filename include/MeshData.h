@@ -0,0 +1,116 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MESH DATA MODULE																	//
+//	The layout a mesh is held in once it has been read from a file, before it is handed	//
+//	to the renderer.  Everything is kept in flat arrays: one vertex per unique			//
+//	combination of position & normal, three indices per triangle, and the material of	//
+//	each triangle.  Nothing here depends on Direct3D, so meshes can be read & worked	//
+//	on by the tools as well as the game.												//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _MESHDATA_H_
+#define _MESHDATA_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <vector>		// Standard vector container.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	Limits on the data stored for a mesh.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define MESH_TEXTURE_LENGTH		64		// Longest texture file name, with terminator.  
+#define MESH_MAX_LODS			4		// The most levels of detail a mesh may have.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	VERTEX STRUCTURE
+//	A single vertex, laid out to match the fixed-function XYZ | NORMAL | TEX1 format.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct MeshVertex
+{
+	float			position[3];			// The vertex's position.  
+	float			normal[3];				// The vertex's normal.  
+	float			uv[2];					// The vertex's texture co-ordinates.  
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MATERIAL STRUCTURE
+//	The colours & texture of one of the mesh's materials.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct MeshMaterial
+{
+	float			diffuse[4];				// The main colour, including alpha.  
+	float			power;					// The sharpness of the specular highlight.  
+	float			specular[3];			// The colour of the specular highlight.  
+	float			emissive[3];			// The colour given off by the material.  
+	char			texture[MESH_TEXTURE_LENGTH];	// The texture file, or empty.  
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LEVEL OF DETAIL STRUCTURE
+//	Where one level of detail lies in a mesh holding several.  Each level is a mesh in
+//	its own right, stored one after another in the same arrays, with its indices
+//	counting from its own first vertex.  Level 0 is the full mesh.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct MeshLod
+{
+	unsigned int	firstVertex;			// The level's first vertex.  
+	unsigned int	numVertices;			// The number of vertices in the level.  
+	unsigned int	firstFace;				// The level's first triangle.  
+	unsigned int	numFaces;				// The number of triangles in the level.  
+	float			error;					// Furthest it strays from the full mesh.  
+	unsigned int	reserved;				// Pads the level out.  
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	VIEW STRUCTURE
+//	A read-only look at a mesh held somewhere else, such as in a MeshData or straight
+//	out of a mapped file.  Anything that only reads a mesh takes one of these, so it
+//	doesn't matter where the mesh came from.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct MeshView
+{
+	const MeshVertex*		Vertices;		// Every vertex in the mesh.  
+	const unsigned int*		Indices;		// Three vertex indices for each triangle.  
+	const unsigned int*		Attributes;		// The material of each triangle.  
+	const MeshMaterial*		Materials;		// Every material in the mesh.  
+
+	unsigned int			numVertices;	// The number of vertices.  
+	unsigned int			numIndices;		// The number of indices.  
+	unsigned int			numFaces;		// The number of triangles.  
+	unsigned int			numMaterials;	// The number of materials.  
+
+	const MeshLod*			Lods;			// The levels of detail, if there are any.  
+	unsigned int			numLods;		// The number of levels listed.  
+
+	unsigned int GetLodCount() const;		// Reports the levels of detail held.  
+	MeshView GetLod(unsigned int level) const;	// Reports a view of one level.  
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MESH STRUCTURE
+//	A whole mesh.  Triangle n uses indices 3n to 3n + 2 & material attributes[n].  A
+//	mesh without any levels of detail listed is treated as having only the one.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct MeshData
+{
+	std::vector<MeshVertex>		Vertices;	// Every vertex in the mesh.  
+	std::vector<unsigned int>	Indices;	// Three vertex indices for each triangle.  
+	std::vector<unsigned int>	Attributes;	// The material of each triangle.  
+	std::vector<MeshMaterial>	Materials;	// Every material in the mesh.  
+	std::vector<MeshLod>		Lods;		// The levels of detail, if there are any.  
+
+	MeshView GetView() const;				// Reports a view of the mesh.  
+	void Clear();							// Empties the mesh.  
+	void AddLod(const MeshData& Level, float error);	// Adds a level of detail.  
+};
+
+#endif
\ No newline at end of file
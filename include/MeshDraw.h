@@ -0,0 +1,65 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MESH DRAW MODULE																	//
+//	Hands a mesh to the render queue.  It picks the level of detail the mesh's size on	//
+//	screen calls for, then queues each of that level's subsets under one world matrix.	//
+//	The game's meshes & the tools both draw through here, so the tools hand the queue	//
+//	exactly the draws the game does.													//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _MESHDRAW_H_
+#define _MESHDRAW_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "RenderBackend.h"	// Render backend interface.  
+#include "RenderQueue.h"	// Sorted draw queue.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	Settings for picking a level of detail.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define LOD_PIXEL_ERROR		0.5f	// How far on screen a coarser level may stray.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	DRAWABLE STRUCTURE
+//	What is needed to draw a mesh that has been made in a backend: the backend's mesh
+//	for each level of detail, how far each level strays from the full mesh, & the
+//	materials every level shares.  It only points at them, so they must outlast it.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct DrawableMesh
+{
+	const int*				Lods;			// The backend's mesh of each level.  
+	const float*			Errors;			// How far each level strays.  
+	unsigned int			numLods;		// The number of levels.  
+	const RenderMaterial*	Materials;		// The materials as they were loaded.  
+	unsigned int			numMaterials;	// The number of materials.  
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  The code for the methods is
+//	detailed in the module's source file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class MeshDraw
+{
+	public:
+		// Picks the level of detail to draw a mesh at.  
+		static unsigned int SelectLod(RenderBackend* Backend, const DrawableMesh& Mesh,
+									  const Matrix& World);
+
+		// Queues every subset of one level of a mesh to be drawn.  
+		static int Submit(RenderQueue& Drawing, int pass, const DrawableMesh& Mesh,
+						  unsigned int level, const Matrix& World,
+						  const RenderMaterial* Matter, int colour);
+};
+
+#endif
\ No newline at end of file
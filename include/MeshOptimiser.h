@@ -0,0 +1,80 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MESH OPTIMISER MODULE																//
+//	Reorders a mesh so that the graphics card does less work drawing it.  Triangles		//
+//	are put into an order that reuses recently transformed vertices, using Tom			//
+//	Forsyth's linear-speed vertex cache optimisation, and vertices are then renumbered	//
+//	in the order they are first used so that they are fetched from memory in order.		//
+//	Neither changes how the mesh looks; meshes are optimised when they are cooked.		//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _MESHOPTIMISER_H_
+#define _MESHOPTIMISER_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <vector>		// Standard vector container.  
+#include "MeshData.h"	// Flat mesh layout.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	Settings for the optimisation.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define OPTIMISE_CACHE_SIZE		32		// The cache size the triangle scores assume.  
+#define ANALYSE_CACHE_SIZE		16		// The FIFO cache size of the older cards measured.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	STATISTICS STRUCTURE
+//	How well a mesh's triangle order suits a vertex cache.  The ACMR is the vertices
+//	transformed per triangle, from 3 at worst down to around 0.5 for a regular grid,
+//	while the ATVR is the vertices transformed per vertex in the mesh, 1 at best.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct CacheStats
+{
+	float			acmr;			// The average cache miss ratio.  
+	float			atvr;			// The average transform to vertex ratio.  
+	int				misses;			// The vertices transformed in all.  
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  The code for the methods is
+//	detailed in the module's source file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class MeshOptimiser
+{
+	public:
+		void Optimise(MeshData& Mesh);		// Reorders the triangles & vertices.  
+
+		static CacheStats Analyse(const MeshView& Mesh, int cacheSize);	// Measures a mesh.  
+
+	private:
+		void OrderTriangles(unsigned int* Indices, int triangles, int vertices);	// Forsyth.  
+		void OrderVertices(MeshData& Mesh);		// Renumbers vertices by first use.  
+
+		static float VertexScore(int position, int remaining);	// Scores a vertex.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS OBJECTS
+	//////////////////////////////////////////////////////////////////////////////////////
+		// Scratch space, kept between meshes.  
+		std::vector<int>			Remaining;		// Triangles left to add using each vertex.  
+		std::vector<int>			Offsets;		// Where each vertex's triangles are listed.  
+		std::vector<int>			Adjacent;		// The triangles using each vertex.  
+		std::vector<int>			CachePosition;	// Where each vertex sits in the cache.  
+		std::vector<float>			Scores;			// The score of each vertex.  
+		std::vector<float>			TriangleScores;	// The score of each triangle.  
+		std::vector<char>			Added;			// Whether each triangle has been added.  
+		std::vector<unsigned int>	Ordered;		// The triangles' new order.  
+		std::vector<unsigned int>	Order;			// Sorting space.  
+};
+
+#endif
\ No newline at end of file
@@ -31,19 +31,14 @@ class RingBlock : public D3DMesh
 	public:
 		RingBlock(float displacement);	// Class constructor.  
 
-		void Render();					// Renders the block.  
+		void Render(const Matrix& World);	// Renders the block.  
 
-		void RotationY(float rad);		// Rotates the block around the y-axis.  
-
-	//////////////////////////////////////////////////////////////////////////////////////
-	//	CLASS OBJECTS
-	//////////////////////////////////////////////////////////////////////////////////////
-	private:
-		D3DXMATRIX	Rotation;			// Matrix to store values for the rotation.  
+		float GetDisplacement();		// Reports how far along the ring the block is.  
 
 	//////////////////////////////////////////////////////////////////////////////////////
 	//	CLASS DATA
 	//////////////////////////////////////////////////////////////////////////////////////
+	private:
 		float		displacement;		// Stores how far along the ring the specific
 										// block is (stored in radians).  
 };
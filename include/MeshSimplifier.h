@@ -0,0 +1,98 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MESH SIMPLIFIER MODULE																//
+//	Builds coarser versions of a mesh for drawing it when it is small on screen, or		//
+//	where the detail can't be seen at all, such as in a shadow.  Edges are collapsed	//
+//	one at a time, cheapest first, with the cost of each measured by Garland &			//
+//	Heckbert's quadric error metric, and the normals of the result are then rebuilt		//
+//	keeping the hard edges of the original.												//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _MESHSIMPLIFIER_H_
+#define _MESHSIMPLIFIER_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <vector>		// Standard vector container.  
+#include <queue>		// Standard priority queue.  
+#include "MeshData.h"	// Flat mesh layout.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	Settings for simplification & for building a chain of levels.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define LOD_MIN_FACES		48		// The fewest triangles a level is taken down to.  
+#define LOD_MIN_SAVING		0.75f	// Share of the last level's triangles a new one must beat.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  The code for the methods is
+//	detailed in the module's source file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class MeshSimplifier
+{
+	public:
+		float Simplify(const MeshView& Source, unsigned int target, MeshData& Out);	// Reduces.  
+
+	private:
+		// A symmetric 4x4 matrix measuring squared distance from a set of planes.  
+		struct Quadric
+		{
+			double		q[10];
+		};
+
+		// A possible collapse of one point into another, & what it was worth when found.  
+		struct Candidate
+		{
+			double			cost;		// The error the collapse would add.  
+			int				from;		// The point that would be removed.  
+			int				to;			// The point it would be moved onto.  
+			unsigned int	fromStamp;	// The points' stamps when the cost was worked out.  
+			unsigned int	toStamp;
+
+			bool operator<(const Candidate& Other) const { return cost > Other.cost; }
+		};
+
+		void Weld(const MeshView& Source);				// Merges vertices by position.  
+		void BuildQuadrics();							// Sums the planes at each point.  
+		void AddPlane(int point, const double* Plane, double weight);	// Adds a plane.  
+		double Cost(int from, int to);					// Scores a collapse.  
+		void Consider(int from, int to);				// Queues a collapse.  
+		bool Collapse(int from, int to);				// Checks & carries out a collapse.  
+		void BuildOutput(const MeshView& Source, MeshData& Out);	// Rebuilds the mesh.  
+		float MeasureError(const MeshData& Out);		// Finds the furthest point strayed.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS OBJECTS
+	//////////////////////////////////////////////////////////////////////////////////////
+		std::vector<float>				Points;			// Three values per welded position.  
+		std::vector<int>				PointOf;		// The point each vertex was welded to.  
+		std::vector<int>				FirstVertex;	// The first vertex at each point.  
+		std::vector<int>				NextVertex;		// The next vertex at the same point.  
+		std::vector<char>				Smooth;			// Whether each point had one normal.  
+		std::vector<char>				Removed;		// Whether each point is gone.  
+		std::vector<unsigned int>		Stamps;			// Bumped whenever a point changes.  
+		std::vector<Quadric>			Quadrics;		// The planes summed at each point.  
+		std::vector<std::vector<int> >	PointTriangles;	// The triangles using each point.  
+
+		std::vector<int>				Triangles;		// Three points per triangle.  
+		std::vector<unsigned int>		Materials;		// The material of each triangle.  
+		std::vector<char>				Alive;			// Whether each triangle is left.  
+
+		std::priority_queue<Candidate>	Queue;			// Collapses, cheapest first.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS DATA
+	//////////////////////////////////////////////////////////////////////////////////////
+		unsigned int	faces;			// The triangles left.  
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,109 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	NULL BACKEND MODULE																	//
+//	A backend that draws nothing, & only counts what it is asked to do: the calls of	//
+//	each kind, the triangles drawn, the command bytes handed to it, & how many of the	//
+//	calls setting a state, transform, material or light changed anything.  This lets	//
+//	the draw calls & state changes of each frame be tracked without a graphics card.	//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _NULLBACKEND_H_
+#define _NULLBACKEND_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <vector>			// Standard vector container.  
+#include "RenderBackend.h"	// Render backend interface.  
+#include "CommandBuffer.h"	// Recorded frame commands, for the kinds of call.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	DRAW STATISTICS STRUCTURE
+//	What was asked of the backend over a frame, or over every frame.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct DrawStats
+{
+	int			calls[COMMAND_COUNT];	// The calls of each kind, by command.  
+	long long	triangles;				// The triangles drawn.  
+	long long	bytes;					// The command bytes consumed.  
+	int			changes;				// Settings calls that changed something.  
+	int			redundant;				// Settings calls that changed nothing.  
+	int			frames;					// The frames presented.  
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  The code for the methods is
+//	detailed in the module's source file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class NullBackend : public RenderBackend
+{
+	public:
+		NullBackend(int width, int height);		// Class constructor.  
+
+		const char* GetName();					// Reports what the backend is.  
+		int GetWidth();							// Reports the width drawn to.  
+		int GetHeight();						// Reports the height drawn to.  
+
+		int CreateMesh(const MeshView& Level);	// Keeps a mesh's subset sizes.  
+		void DestroyMesh(int mesh);				// Forgets a mesh.  
+		unsigned int GetFaceCount(int mesh);	// Reports a mesh's triangles.  
+		size_t GetMeshBytes(int mesh);			// Reports no memory.  
+
+		void BeginScene();						// Counts the start of a frame.  
+		void EndScene();						// Counts the end of drawing.  
+		void Present();							// Finishes the frame's counts.  
+		void Clear(unsigned int flags, unsigned int colour, float depth,
+				   unsigned int stencil);		// Counts a clear.  
+
+		void SetTransform(int type, const Matrix& Transform);	// Counts a transform.  
+		void GetTransform(int type, Matrix& Transform);			// Reports a transform.  
+		void SetMaterial(const RenderMaterial& Material);		// Counts a material.  
+		void SetLight(const RenderLight& Light);				// Counts a light.  
+		void SetRenderState(int state, unsigned int value);		// Counts a render state.  
+
+		void DrawSubset(int mesh, unsigned int subset);			// Counts a draw.  
+
+		// Functions for counting recorded frames.  
+		void CountBytes(size_t bytes);			// Counts command bytes handed over.  
+		void ResetStats();						// Starts the counts afresh.  
+		const DrawStats& GetFrame();			// Reports the last frame's counts.  
+		const DrawStats& GetTotal();			// Reports the counts of every frame.  
+
+		static int GetCallCount(const DrawStats& Stats);	// Adds up every call.  
+
+	private:
+		void Count(int command, bool changed);	// Counts a call.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS OBJECTS
+	//////////////////////////////////////////////////////////////////////////////////////
+		std::vector< std::vector<unsigned int> >	Subsets;	// Each mesh's subset sizes.  
+
+		Matrix				Transforms[TRANSFORM_COUNT];	// The transforms set.  
+		RenderMaterial		Material;		// The material set.  
+		RenderLight			Lamp;			// The light set.  
+		unsigned int		States[STATE_COUNT];	// The render states set.  
+
+		DrawStats			Current;		// The frame being drawn's counts.  
+		DrawStats			Frame;			// The last finished frame's counts.  
+		DrawStats			Total;			// Every finished frame's counts.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS DATA
+	//////////////////////////////////////////////////////////////////////////////////////
+		int				width, height;		// The size of the frame in pixels.  
+		bool			setTransform[TRANSFORM_COUNT];	// Whether each transform is set.  
+		bool			setState[STATE_COUNT];	// Whether each render state is set.  
+		bool			setMaterial;		// Whether a material is set.  
+		bool			setLight;			// Whether a light is set.  
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,55 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	RANDOM STREAM MODULE																//
+//	Seeded random number streams for the game's colour picking.  Each stream is a		//
+//	xoshiro256** generator holding all of its state itself, so any number of sessions	//
+//	can draw numbers at once without sharing anything, and a session started from the	//
+//	same seed always sees the same numbers.  Streams can be told apart either by a		//
+//	stream number mixed into the seed, or by jumping a stream 2^128 or 2^192 steps		//
+//	ahead, which guarantees they never overlap.											//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _RANDOM_H_
+#define _RANDOM_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  The code for the methods is
+//	detailed in the module's source file.  The class is kept as plain data with no
+//	virtual functions so that it can be copied along with the rest of a session's state.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class RandomStream
+{
+	public:
+		RandomStream();											// Class constructor.  
+		RandomStream(unsigned long long seed);					// Seeded constructor.  
+		RandomStream(unsigned long long seed, unsigned long long stream);
+
+		void Seed(unsigned long long seed, unsigned long long stream);	// Reseeds.  
+
+		unsigned long long Next();		// Generates the next 64-bit value.  
+		int Below(int n);				// Generates a value from 0 to n - 1.  
+
+		void Jump();					// Moves the stream 2^128 values ahead.  
+		void LongJump();				// Moves the stream 2^192 values ahead.  
+		void SetState(const unsigned long long* State);	// Sets the raw state.  
+
+		// Gives the stream of a numbered worker, split off from one seed by jumping.  
+		static RandomStream ForWorker(unsigned long long seed, int worker);
+
+	private:
+		void Apply(const unsigned long long* Polynomial);	// Runs a jump polynomial.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS DATA
+	//////////////////////////////////////////////////////////////////////////////////////
+		unsigned long long	s[4];		// The generator's 256 bits of state.  
+};
+
+#endif
\ No newline at end of file
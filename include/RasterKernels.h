@@ -0,0 +1,82 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	RASTER KERNELS MODULE																//
+//	The inner loops of the software backend, which fill in one triangle within one		//
+//	tile.  The plain C++ kernel checks a pixel at a time & is kept as the reference the	//
+//	others are measured against; the SSE2 & AVX2 kernels check 4 & 8 pixels at a time,	//
+//	giving exactly the same pixels as the plain one.  The fastest kernel the processor	//
+//	can run is picked when the program starts.											//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _RASTERKERNELS_H_
+#define _RASTERKERNELS_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	The kernels, from slowest to fastest.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define RASTER_SCALAR		0		// One pixel at a time, on any processor.  
+#define RASTER_SSE2			1		// Four pixels at a time.  
+#define RASTER_AVX2			2		// Eight pixels at a time.  
+#define RASTER_KERNELS		3
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	JOB STRUCTURE
+//	A triangle to be filled in within a tile.  Each edge & value is a plane, a x + b y +
+//	c, with c taken at the tile's corner so that only small offsets are added to it.  
+//	Stencilled pixels are only drawn where the stencil is still 0, & add one to it when
+//	they are, as D3DSetup::SetStencilBuffer() sets Direct3D up to do.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct RasterJob
+{
+	float			Edges[3][3];	// Each edge, positive inside the triangle.  
+	int				topLeft[3];		// Whether each edge takes pixels lying exactly on it.  
+	float			Planes[6][3];	// The planes of z, 1 / w & r, g, b & a over w.  
+
+	int				x0, y0;			// The tile's corner.  
+	int				left, top;		// The first pixel to check.  
+	int				right, bottom;	// The last pixel to check.  
+	bool			depth;			// Whether the depth buffer is tested & written.  
+	bool			blend;			// Whether the colour is blended by its alpha.  
+	bool			stencil;		// Whether the stencil buffer is tested & counted.  
+
+	unsigned int*	Colour;			// The colour buffer.  
+	float*			Depth;			// The depth buffer.  
+	unsigned char*	Stencil;		// The stencil buffer.  
+	int				width;			// The pixels in a row of either buffer.  
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	TYPE DEFINITIONS
+//	A kernel fills in a job & reports the pixels found inside the triangle.  
+//////////////////////////////////////////////////////////////////////////////////////////
+typedef long long (*RasterKernel)(const RasterJob& Job);
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  The code for the methods is
+//	detailed in the module's source file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class RasterKernels
+{
+	public:
+		static int GetBest();					// Picks the fastest kernel that runs here.  
+		static bool IsSupported(int kernel);	// Checks whether a kernel runs here.  
+		static RasterKernel Get(int kernel);	// Reports a kernel's function.  
+		static const char* GetName(int kernel);	// Reports a kernel's name.  
+		static int GetLanes(int kernel);		// Reports the pixels checked at a time.  
+
+	private:
+		static long long FillScalar(const RasterJob& Job);	// The reference kernel.  
+		static long long FillSSE2(const RasterJob& Job);	// The SSE2 kernel.  
+		static long long FillAVX2(const RasterJob& Job);	// The AVX2 kernel.  
+		static int FillPixel(const RasterJob& Job, int x, int y);	// Fills a single pixel.  
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,122 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	RENDER BACKEND MODULE																//
+//	The interface everything drawn goes through, so that the game isn't tied to			//
+//	Direct3D.  It covers the few parts of the fixed-function pipeline the game uses:	//
+//	meshes, the three transforms, materials, a single point light, the stencil buffer	//
+//	for shadows & drawing a mesh's subsets.  The types here are laid out the same as	//
+//	Direct3D's own, so its backend can pass them straight through.						//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _RENDERBACKEND_H_
+#define _RENDERBACKEND_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <stddef.h>		// Standard definitions, for size_t.  
+#include "Matrix.h"		// 4x4 matrices.  
+#include "MeshData.h"	// Flat mesh layout.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	The transforms, render states & buffers a backend knows about.  Colours are packed
+//	as 0xAARRGGBB.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define TRANSFORM_WORLD			0		// Moves a mesh into the world.  
+#define TRANSFORM_VIEW			1		// Moves the world in front of the camera.  
+#define TRANSFORM_PROJECTION	2		// Flattens the view onto the screen.  
+#define TRANSFORM_COUNT			3
+
+#define STATE_LIGHTING			0		// Whether vertices are lit (1) or left white (0).  
+#define STATE_AMBIENT			1		// The colour of the light falling everywhere.  
+#define STATE_BLEND				2		// Whether drawing is blended by alpha.  
+#define STATE_DEPTH				3		// Whether the depth buffer is tested & written.  
+#define STATE_STENCIL			4		// Whether drawing only marks each pixel once.  
+#define STATE_COUNT				5
+
+#define CLEAR_TARGET			0x1		// Clears the colour of every pixel.  
+#define CLEAR_DEPTH				0x2		// Clears the depth buffer.  
+#define CLEAR_STENCIL			0x4		// Clears the stencil buffer.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	COLOUR STRUCTURE
+//	A colour with each channel from 0 to 1, as D3DCOLORVALUE.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct RenderColour
+{
+	float	r, g, b, a;
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MATERIAL STRUCTURE
+//	How a surface reacts to light, as D3DMATERIAL9.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct RenderMaterial
+{
+	RenderColour	Diffuse;		// The colour lit by the light, including alpha.  
+	RenderColour	Ambient;		// The colour lit by the ambient light.  
+	RenderColour	Specular;		// The colour of highlights.  
+	RenderColour	Emissive;		// The colour given off whatever the light.  
+	float			power;			// The sharpness of highlights.  
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIGHT STRUCTURE
+//	A point light, shining equally in every direction out to its range, & fading with
+//	distance d by 1 / (attenuation[0] + attenuation[1] d + attenuation[2] d squared).  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct RenderLight
+{
+	RenderColour	Diffuse;		// The colour of the light.  
+	float			position[3];	// Where the light sits in the world.  
+	float			range;			// The furthest the light reaches.  
+	float			attenuation[3];	// How the light fades with distance.  
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  Each backend's code is detailed
+//	in its own module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class RenderBackend
+{
+	public:
+		virtual ~RenderBackend() {}						// Class destructor.  
+
+		virtual const char* GetName() = 0;				// Reports what the backend is.  
+		virtual int GetWidth() = 0;						// Reports the width drawn to.  
+		virtual int GetHeight() = 0;					// Reports the height drawn to.  
+
+		// Functions for handling meshes, which are known by the number given when made.  
+		// Faces are grouped into a subset for each material, as D3DX meshes.  
+		virtual int CreateMesh(const MeshView& Level) = 0;	// Makes a mesh, or reports -1.  
+		virtual void DestroyMesh(int mesh) = 0;			// Frees a mesh.  
+		virtual unsigned int GetFaceCount(int mesh) = 0;	// Reports a mesh's triangles.  
+		virtual size_t GetMeshBytes(int mesh) = 0;		// Reports a mesh's memory.  
+
+		// Functions for drawing a frame.  
+		virtual void BeginScene() = 0;					// Starts a frame.  
+		virtual void EndScene() = 0;					// Finishes drawing a frame.  
+		virtual void Present() = 0;						// Shows the finished frame.  
+		virtual void Clear(unsigned int flags, unsigned int colour, float depth,
+						   unsigned int stencil) = 0;	// Clears the given buffers.  
+
+		// Functions for setting how things are drawn.  
+		virtual void SetTransform(int type, const Matrix& Transform) = 0;
+		virtual void GetTransform(int type, Matrix& Transform) = 0;
+		virtual void SetMaterial(const RenderMaterial& Material) = 0;
+		virtual void SetLight(const RenderLight& Light) = 0;
+		virtual void SetRenderState(int state, unsigned int value) = 0;
+
+		virtual void DrawSubset(int mesh, unsigned int subset) = 0;	// Draws a subset.  
+};
+
+#endif
\ No newline at end of file
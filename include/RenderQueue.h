@@ -0,0 +1,121 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	RENDER QUEUE MODULE																	//
+//	Collects every draw of a frame so that they can be sorted before any reach the		//
+//	render backend.  Objects hand in a small packet for each subset they want drawn,	//
+//	and once the scene has been walked the packets are sorted by the state they need,	//
+//	so that materials & matrices shared by neighbouring draws are only set once.		//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _RENDERQUEUE_H_
+#define _RENDERQUEUE_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <vector>		// Standard vector container.  
+#include "Defines.h"	// Library for the project's definitions & macros.  
+#include "Singleton.h"	// Singleton class.  
+#include "ColourRGB.h"	// RGB Colour datatype class.  
+#include "RenderBackend.h"	// Render backend interface.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	Simplifies the call for the module, & lays out the passes & the sort key.  Passes are
+//	drawn in order, each with its own render states.  Draws of the same subset of a mesh
+//	in the same material sit next to each other in the key's order, making one batch that
+//	only changes matrix & colour from one draw to the next.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define Queue				RenderQueue::GetSingleton()
+
+#define RENDER_PASS_SCENE	0		// Drawn first, against the depth buffer.  
+#define RENDER_PASS_SHADOW	1		// Drawn to the stencil buffer, ignoring depth.  
+#define RENDER_PASS_CASTERS	2		// Drawn over the shadows they cast.  
+
+#define PALETTE_NONE		-1		// Draws with the material as it was loaded.  
+
+#define KEY_PASS_SHIFT		28		// The top 4 bits hold the pass.  
+#define KEY_MESH_SHIFT		20		// The next 8 bits hold the mesh.  
+#define KEY_MATERIAL_SHIFT	12		// The next 8 bits hold the material.  
+#define KEY_SUBSET_SHIFT	4		// The next 8 bits hold the subset.  
+#define KEY_FIELD_MASK		0xff	// The largest mesh, material or subset number.  
+#define KEY_COLOUR_MASK		0xf		// The bottom 4 bits hold the colour, all set for none.  
+#define KEY_BATCH_MASK		0xfffffff0	// The fields a batch shares.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PACKET STRUCTURE
+//	A single subset waiting to be drawn.  The material is pointed to rather than copied,
+//	so it must last until the queue is flushed.  The colour is an entry in the queue's
+//	palette, put in place of the material's own when it is drawn.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct DrawPacket
+{
+	int						mesh;		// The backend's mesh to draw from.  
+	unsigned int			subset;		// The subset of the mesh to draw.  
+	const RenderMaterial*	Material;	// The material to draw it with.  
+	int						transform;	// The world matrix to draw it with.  
+	int						colour;		// The palette colour to draw it in, if any.  
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  The code for the methods is
+//	detailed in the module's source file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class RenderQueue : public CSingleton <RenderQueue>
+{
+	public:
+		RenderQueue();		// Class constructor.  
+
+		// Functions for handing in draws.  
+		void SetColour(int index, const ColourRGB& Colour);	// Fills in the palette.  
+		int AddTransform(const Matrix& World);		// Holds a world matrix for draws.  
+		void Submit(int pass, int mesh, unsigned int subset, const RenderMaterial* Material,
+					int colour, int transform);		// Queues a subset to be drawn.  
+		void Flush(RenderBackend* Backend);			// Sorts & draws everything queued.  
+
+		// Functions to report the last flush.  
+		int GetDrawCount();			// Reports the subsets drawn.  
+		int GetBatchCount();		// Reports the runs of draws sharing their state.  
+		int GetMaterialCount();		// Reports the materials set.  
+		int GetTransformCount();	// Reports the world matrices set.  
+
+	private:
+		int FindMaterial(const RenderMaterial* Material);	// Numbers a material for sorting.  
+		int FindMesh(int mesh);							// Numbers a mesh for sorting.  
+		void BeginPass(RenderBackend* Backend, int pass);	// Sets a pass's render states.  
+		void EndPass(RenderBackend* Backend, int pass);		// Restores a pass's render states.  
+
+		static void Sort(std::vector<unsigned long long>& Keys,
+						 std::vector<unsigned long long>& Scratch);	// Radix sorts keys.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS OBJECTS
+	//////////////////////////////////////////////////////////////////////////////////////
+		std::vector<DrawPacket>				Packets;	// Every draw queued.  
+		std::vector<Matrix>					Transforms;	// Every world matrix queued.  
+		std::vector<unsigned long long>		Keys;		// Sort keys, with packet numbers.  
+		std::vector<unsigned long long>		Scratch;	// Room for sorting the keys.  
+		std::vector<const RenderMaterial*>	Materials;	// Distinct materials this frame.  
+		std::vector<int>					Models;		// Distinct meshes this frame.  
+
+		RenderColour	Palette[NUM_COLOURS];	// The colours objects may be drawn in.  
+		RenderMaterial	Tinted;					// A material with a palette colour put in.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS DATA
+	//////////////////////////////////////////////////////////////////////////////////////
+		int		draws;			// Subsets drawn by the last flush.  
+		int		batches;		// Runs of draws sharing their state in the last flush.  
+		int		materials;		// Materials set by the last flush.  
+		int		transforms;		// World matrices set by the last flush.  
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,180 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	REPLAY MODULE																		//
+//	Records a session's input to a compact binary file & plays it back.  Since the		//
+//	simulation is fully deterministic, the seed & the input for each tick are all that	//
+//	is needed to rebuild a session exactly.  Runs of identical ticks are stored once	//
+//	with a count, and mouse movement is stored as the change from the tick before.		//
+//	Full copies of the state are stored at regular intervals along with an index at	//
+//	the end of the file, so that playback can jump to any tick without replaying the	//
+//	whole session up to it.  Recording hands its output to a background thread, so the	//
+//	thread running the game never waits on the disk.									//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _REPLAY_H_
+#define _REPLAY_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>				// Standard I/O library.  
+#include <vector>				// Standard vector container.  
+#include <thread>				// Standard thread library.  
+#include <mutex>				// Standard mutex library.  
+#include <condition_variable>	// Standard condition variables.  
+#include "Simulation.h"			// Renderer-free game simulation.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	Settings for the replay files.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define REPLAY_MAGIC		0x52424154	// "TABR", marking the start of a replay file.  
+#define REPLAY_END_MAGIC	0x45424154	// "TABE", marking the end of a replay file.  
+#define REPLAY_VERSION		1			// The version of the file layout.  
+#define REPLAY_KEYFRAME		600			// Ticks between stored states (5s at 120Hz).  
+#define REPLAY_BUFFER		65536		// Bytes gathered before handing to the disk.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	FILE HEADER
+//	Stored at the start of every replay.  The file is written in the machine's own byte
+//	order & with its own layout of SimState, so replays are only meant to be played back
+//	by the same build that recorded them; the state size is kept to catch mismatches.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct ReplayHeader
+{
+	unsigned int		magic;			// Always REPLAY_MAGIC.  
+	unsigned int		version;		// Always REPLAY_VERSION.  
+	unsigned int		interval;		// Ticks between stored states.  
+	unsigned int		stateSize;		// The size of SimState when recorded.  
+	unsigned long long	seed;			// The seed of the session's colour generator.  
+	unsigned long long	stream;			// The stream number of the colour generator.  
+	SimParams			Params;			// The session's tuning values.  
+	unsigned int		reserved;		// Pads the header to a multiple of 8 bytes.  
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	FILE FOOTER
+//	Stored at the very end of every replay, after the index of stored states.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct ReplayFooter
+{
+	unsigned long long	index;			// The file offset of the index.  
+	unsigned int		keyframes;		// The number of stored states.  
+	unsigned int		ticks;			// The length of the session in ticks.  
+	unsigned int		reserved;		// Pads the footer to a multiple of 8 bytes.  
+	unsigned int		magic;			// Always REPLAY_END_MAGIC.  
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  The code for the methods is
+//	detailed in the module's source file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Records a session to a replay file.  Input is encoded into a buffer in memory, and
+//	each full buffer is swapped with a second one being written out by a background
+//	thread.  If the background thread is still busy when a buffer fills, the buffer is
+//	simply allowed to grow until the next swap, so recording never blocks.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class ReplayWriter
+{
+	public:
+		ReplayWriter();							// Class constructor.  
+		~ReplayWriter();						// Class destructor.  
+
+		// Starts recording a session to the given file.  
+		bool Open(const char* path, unsigned long long seed, unsigned long long stream,
+					const SimParams& Params);
+		void Record(const SimState& State, const TickInput& Input);	// Records a tick.  
+		void Close();							// Finishes the file off.  
+
+		bool IsOpen();							// Checks whether a file is being recorded.  
+
+	private:
+		void Put(const void* Data, size_t size);	// Adds bytes to the file.  
+		void PutNumber(unsigned long long value);	// Adds a variable-length number.  
+		void EndRun();							// Adds the run of ticks in progress.  
+		void Hand(bool wait);					// Hands the buffer to the disk thread.  
+		void WriteLoop();						// The disk thread's main loop.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS OBJECTS
+	//////////////////////////////////////////////////////////////////////////////////////
+		FILE*						File;		// The file being recorded to.  
+		std::thread					Disk;		// The thread writing buffers out.  
+		std::mutex					Lock;		// Guards the handover between threads.  
+		std::condition_variable		Wake;		// Signals a change in the handover.  
+
+		std::vector<unsigned char>	Front;		// The buffer being filled by the game.  
+		std::vector<unsigned char>	Back;		// The buffer being written out.  
+		std::vector<unsigned long long>	Index;	// File offsets of the stored states.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS DATA
+	//////////////////////////////////////////////////////////////////////////////////////
+		bool				backFull;			// Whether the back buffer awaits writing.  
+		bool				closing;			// Whether the disk thread should finish.  
+
+		unsigned long long	offset;				// Bytes added to the file so far.  
+		unsigned int		ticks;				// Ticks recorded so far.  
+
+		TickInput			Run;				// The input repeated in the current run.  
+		unsigned int		runLength;			// Ticks in the current run.  
+		int					mouse;				// The mouse movement last stored.  
+};
+
+//	Plays a session back from a replay file.  The whole file is read into memory up
+//	front, and input is then decoded a tick at a time as it's asked for.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class ReplayReader
+{
+	public:
+		ReplayReader();							// Class constructor.  
+
+		bool Open(const char* path);			// Reads in a replay file.  
+
+		// Functions to report how the recorded session was set up.  
+		RandomStream GetStream();				// The session's colour generator.  
+		SimParams GetParams();					// The session's tuning values.  
+		int GetTicks();							// The length of the session in ticks.  
+		int GetTick();							// The tick that will be read next.  
+		int GetKeyframes();						// The number of stored states.  
+		int GetInterval();						// Ticks between stored states.  
+		int GetSize();							// The size of the file in bytes.  
+
+		bool GetKeyframe(int id, SimState& State);	// Reads a stored state.  
+
+		bool Next(TickInput& Input);			// Reads the input for the next tick.  
+		bool Seek(Simulation& Sim, int tick);	// Moves the session to a given tick.  
+		bool MoveTo(int tick);					// Moves reading to a given tick.  
+
+	private:
+		bool ReadNumber(unsigned long long& value);	// Reads a variable-length number.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS OBJECTS
+	//////////////////////////////////////////////////////////////////////////////////////
+		std::vector<unsigned char>	Data;		// The whole file.  
+		ReplayHeader				Header;		// The file's header.  
+		ReplayFooter				Footer;		// The file's footer.  
+		const unsigned long long*	Index;		// File offsets of the stored states.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS DATA
+	//////////////////////////////////////////////////////////////////////////////////////
+		size_t				cursor;				// The offset of the next byte to decode.  
+		size_t				end;				// The offset the input ends at.  
+		int					tick;				// The tick that will be read next.  
+
+		TickInput			Run;				// The input repeated in the current run.  
+		unsigned int		runLength;			// Ticks left in the current run.  
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,72 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	SCENE GRAPH MODULE																	//
+//	A hierarchy of transforms, where each node's world matrix is its own local matrix	//
+//	followed by its parent's world matrix.  Setting a node's local matrix only marks it	//
+//	as changed; the world matrices of the changed nodes & everything beneath them are	//
+//	worked out again when the graph is next updated, and the rest are left as they		//
+//	were.  A node's parent must be added before it, so the nodes are kept in one block	//
+//	of memory in an order where a single pass from the front updates every parent		//
+//	before its children.																//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _SCENEGRAPH_H_
+#define _SCENEGRAPH_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <vector>			// Standard vector container.  
+#include "Matrix.h"			// 4x4 matrices.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	The parent given to a node at the top of the graph.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define SCENE_ROOT			-1
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  The code for the methods is
+//	detailed in the module's source file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class SceneGraph
+{
+	public:
+		SceneGraph();							// Class constructor.  
+
+		int AddNode(int parent, const Matrix& Local);	// Adds a node beneath another.  
+		void SetLocal(int node, const Matrix& Local);	// Moves a node.  
+		const Matrix& GetLocal(int node);		// Reports a node's local matrix.  
+		const Matrix& GetWorld(int node);		// Reports a node's world matrix.  
+
+		void Update();							// Works out the changed world matrices.  
+		void Clear();							// Removes every node.  
+
+		int GetNodeCount();						// Reports the number of nodes.  
+		int GetUpdateCount();					// Reports the matrices last worked out.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS OBJECTS
+	//////////////////////////////////////////////////////////////////////////////////////
+	private:
+		std::vector<Matrix>			Locals;		// Each node's own matrix.  
+		std::vector<Matrix>			Worlds;		// Each node's matrix in the world.  
+		std::vector<int>			Parents;	// Each node's parent, or SCENE_ROOT.  
+		std::vector<unsigned char>	Dirty;		// Whether each node has changed.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS DATA
+	//////////////////////////////////////////////////////////////////////////////////////
+		bool			changed;			// Whether any node has changed.  
+		int				updated;			// Matrices worked out in the last update.  
+};
+
+#endif
\ No newline at end of file
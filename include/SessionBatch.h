@@ -0,0 +1,113 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	SESSION BATCH MODULE																//
+//	Runs large batches of independent headless sessions for tuning the game's			//
+//	constants.  Each session is played by a controller over the simulation module, the	//
+//	sessions are spread across every core by the task pool, and the results are		//
+//	gathered into histograms of how the sessions played out.							//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _SESSIONBATCH_H_
+#define _SESSIONBATCH_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <vector>			// Standard resizable array.  
+#include "Simulation.h"		// Renderer-free game simulation.  
+#include "Controller.h"		// Headless player classes.  
+#include "Trajectory.h"		// Precomputed ball flights.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	Sizes of the batch's histograms & work units.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define BATCH_LEVELS		64		// Levels tracked; later ones share the last bucket.  
+#define BATCH_FLIGHTS		512		// Flight lengths tracked in ticks.  
+#define BATCH_CHUNK			256		// Sessions handed to a worker at a time.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	SETTINGS STRUCTURE
+//	Everything that decides what a batch runs.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct BatchSettings
+{
+	int				sessions;		// The number of sessions to run.  
+	int				threads;		// Workers to use, or 0 for one per core.  
+	unsigned long long seed;		// Seed that every session's stream is made from.  
+	int				maxTicks;		// Ticks a session may last before being stopped.  
+	bool			eventDriven;	// Whether steady stretches are jumped over.  
+
+	SimParams		Params;			// The tuning values being tested.  
+
+	bool			idle;			// Whether sessions are left unplayed.  
+	int				reaction;		// The bot's reaction time in ticks.  
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	RESULTS STRUCTURE
+//	Counts gathered over a batch.  Each worker fills in its own copy, which are added
+//	together once the batch is done.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct BatchResults
+{
+	long long		sessions;						// Sessions finished.  
+	long long		ticks;							// Ticks simulated.  
+	long long		timedOut;						// Sessions stopped at maxTicks.  
+	unsigned long long	checksum;					// Sum of the final states' hashes.  
+
+	long long		levelReached[BATCH_LEVELS];		// Sessions ending at each level.  
+	long long		bounces[BATCH_LEVELS];			// Bounces made at each level.  
+	long long		flights[BATCH_FLIGHTS];			// Bounces after each flight length.  
+
+	void Clear();									// Zeroes every count.  
+	void Merge(const BatchResults& Other);			// Adds another set of counts.  
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  The code for the methods is
+//	detailed in the module's source file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class SessionBatch
+{
+	public:
+		SessionBatch(const BatchSettings& Settings);	// Class constructor.  
+		~SessionBatch();								// Class destructor.  
+
+		void Run();								// Runs every session in the batch.  
+
+		const BatchResults& GetResults();		// Reports the combined results.  
+		int GetThreadCount();					// Reports the workers used.  
+		double GetSeconds();					// Reports how long the batch took.  
+		double GetSessionsPerSecond();			// Reports the batch's throughput.  
+
+	private:
+		static void RunChunk(int chunk, int worker, void* context);	// Runs a task.  
+		void RunSession(const RandomStream& Random, int worker);	// Plays a session.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS OBJECTS
+	//////////////////////////////////////////////////////////////////////////////////////
+		BatchSettings				Settings;		// What the batch runs.  
+		BatchResults				Results;		// The combined results.  
+		std::vector<BatchResults*>	WorkerResults;	// Each worker's own results.  
+		std::vector<Controller*>	Controllers;	// Each worker's own controller.  
+		std::vector<RandomStream>	Streams;		// The stream each chunk starts from.  
+		FlightCache*				Flights;		// Flights shared by every session.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS DATA
+	//////////////////////////////////////////////////////////////////////////////////////
+		int							threads;		// The number of workers used.  
+		double						seconds;		// How long the batch took to run.  
+};
+
+#endif
\ No newline at end of file
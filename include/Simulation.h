@@ -0,0 +1,145 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	SIMULATION MODULE																	//
+//	The renderer-free core of the game.  The module owns every value that decides how a	//
+//	session plays out (ring angle, ball motion, colours, score & level) and advances	//
+//	them one fixed tick at a time.  It has no Direct3D or Win32 dependencies, so it can	//
+//	be run headless on any platform.													//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _SIMULATION_H_
+#define _SIMULATION_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <math.h>		// Standard math library.  
+#include "Defines.h"	// Library for the project's definitions & macros.  
+#include "Random.h"		// Seeded random number streams.  
+#include "Trajectory.h"	// Precomputed ball flights.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	TUNING STRUCTURE
+//	The constants that shape the ball's motion.  By default they are taken from
+//	Defines.h, but a session can be given its own values for tuning.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct SimParams
+{
+	float			initialGravity;				// The gravity at the start of a game.  
+	float			gravIncrease;				// Share of gravity added per level.  
+	float			launchVelocity;				// The velocity of the ball at launch.  
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	STATE STRUCTURE
+//	The complete state of a session.  Kept as plain data so that it can be copied around
+//	freely by anything that needs to inspect or store it.  The colour generator is kept
+//	first & the reserved field rounds the rest up to whole 8-byte words, so the
+//	structure holds no padding & its bytes can be hashed, compared or saved directly.
+//	The reserved field must always be 0.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct SimState
+{
+	RandomStream	Random;						// State of the colour generator.  
+
+	float			x;							// The rotation displacement of the ring.  
+	float			y;							// The position of the ball in the y-axis.  
+	int				t;							// Ticks passed since the last bounce.  
+	float			gravity;					// The gravitational constant of the ball.  
+
+	int				ballColour;					// The colour ID of the ball.  
+	int				blockColour[NUM_BLOCKS];	// The colour ID of each ring block.  
+
+	int				level;						// The level of the game.  
+	int				score;						// The progress towards the next level.  
+	int				bounces;					// Successful bounces over the session.  
+	int				ticks;						// Ticks played over the session.  
+	int				reserved;					// Fills the last word; always 0.  
+};
+
+static_assert(sizeof(SimState) == sizeof(RandomStream) + 3 * sizeof(float) +
+			  (7 + NUM_BLOCKS) * sizeof(int), "SimState must hold no padding.");
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	INPUT STRUCTURE
+//	Everything the player did in a single tick: which of the turning keys were held &
+//	how far the mouse moved.  Recording these along with the session's seed is enough to
+//	play the whole session back exactly.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define INPUT_LEFT		0x01	// A key turning the ring left was held.  
+#define INPUT_RIGHT		0x02	// A key turning the ring right was held.  
+
+struct TickInput
+{
+	int				keys;						// The INPUT_ flags for held keys.  
+	int				mouse;						// The mouse's movement along the x-axis.  
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  The code for the methods is
+//	detailed in the module's source file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class Simulation
+{
+	public:
+		Simulation(const RandomStream& Random);	// Class constructor.  
+		Simulation(const RandomStream& Random, const SimParams& Params);	// Tuned.  
+
+		static SimParams Defaults();	// Reports the tuning values from Defines.h.  
+		static int BlockBelow(float x);	// The block below the ball at a given angle.  
+
+		void ShareFlights(FlightCache* Flights);	// Uses flights built elsewhere.  
+
+		void Reset(const RandomStream& Random);	// Starts a fresh session.  
+		bool Tick();					// Advances the session by a single tick.  
+		int FastForward(int ticks, float x);	// Jumps ahead to the next event.  
+
+		void Rotate(float x);			// Moves the ring based on a given amount.  
+		void Apply(const TickInput& Input);	// Moves the ring by a tick's input.  
+		void Restore(const SimState& State);	// Carries on from a stored state.  
+
+		// Functions to check session data for comparisons & rendering.  
+		const SimState& GetState();		// Reports the full state of the session.  
+		float GetAngle();				// Reports the rotation of the ring.  
+		float GetBallY();				// Reports the y-value of the ball.  
+		int GetBallColour();			// Reports the colour ID of the ball.  
+		int GetBlockColour(int id);		// Reports the colour ID of a given block.  
+		int GetBlockBelow();			// Reports the ID of the block below the ball.  
+		int GetLevel();					// Gets the current level.  
+		int GetScore();					// Gets the current progress to the next level.  
+		int GetBounces();				// Gets the number of successful bounces.  
+
+		bool Bounced();		// Checks whether the ball is touching the ring this tick.  
+		bool Fallen();		// Checks whether the ball has fallen through the ring.  
+
+		// Functions to look ahead along the ball's flight.  
+		int TicksToImpact();	// Ticks until the ball next touches the ring.  
+		int TicksToFall();		// Ticks until the ball will have fully fallen.  
+
+	private:
+		void Translate();		// Moves the ball along its arc by one tick.  
+		void Bounce();			// Launches the ball into the air again.  
+		void ChangeGravity();	// Modifies the gravity of the ball for harder levels.  
+		void ChangeColours();	// Changes the colours of the ball & ring.  
+		void IncreaseScore();	// Increases the score after a successful bounce.  
+
+		Trajectory* OnFlight();	// Finds the stored flight the state lies on.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS DATA
+	//////////////////////////////////////////////////////////////////////////////////////
+		SimState	State;		// The full state of the session.  
+		SimParams	Params;		// The tuning values in use by the session.  
+		Trajectory	Flight;		// The flight for the current gravity.  
+		FlightCache* Flights;	// Flights shared with other sessions, if any.  
+};
+
+#endif
\ No newline at end of file
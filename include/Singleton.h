@@ -10,8 +10,7 @@ template <typename T> class CSingleton
 		// Sets up the one and only instance
 		CSingleton()
 		{
-			int offset = (int)(T*)1 - (int)(CSingleton<T>*)(T*)1;
-			ms_Singleton = (T*)((int)this + offset);
+			ms_Singleton = static_cast<T*>(this);
 		}
 
 		// Destroys the one and only instance
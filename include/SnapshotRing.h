@@ -0,0 +1,101 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	SNAPSHOT RING MODULE																//
+//	A fixed-size history of snapshots, kept in a ring so that the newest always			//
+//	replaces the oldest once it's full.  All of the storage is part of the object		//
+//	itself, so saving & restoring are plain copies that never touch the heap.  Only		//
+//	plain data can be stored, as snapshots are copied around bit for bit.				//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _SNAPSHOTRING_H_
+#define _SNAPSHOTRING_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <type_traits>	// Standard type traits, for checking snapshots are plain data.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration & code of the class.  As a template, the whole class lives in the
+//	header.  The capacity must be a power of two so that positions wrap with a mask.  
+//////////////////////////////////////////////////////////////////////////////////////////
+template <typename T, int N> class SnapshotRing
+{
+	static_assert((N > 0) && ((N & (N - 1)) == 0), "Capacity must be a power of two.");
+	static_assert(std::is_trivially_copyable<T>::value, "Snapshots must be plain data.");
+
+	public:
+		// Class constructor.  
+		SnapshotRing()
+		{
+			this->Clear();
+		}
+
+		// Forgets every snapshot.  
+		void Clear()
+		{
+			head = 0;
+			count = 0;
+		}
+
+		// Stores a snapshot, replacing the oldest if the ring is full.  
+		void Push(const T& Item)
+		{
+			Items[head] = Item;
+			head = (head + 1) & (N - 1);
+			if (count < N)
+				count++;
+		}
+
+		// Takes back the newest snapshot.  Returns false if there are none left.  
+		bool Pop(T& Item)
+		{
+			if (count == 0)
+				return false;
+
+			head = (head - 1) & (N - 1);
+			count--;
+			Item = Items[head];
+			return true;
+		}
+
+		// Reads a snapshot without removing it, counting back from the newest at 0.  
+		bool Peek(int age, T& Item) const
+		{
+			if ((age < 0) || (age >= count))
+				return false;
+
+			Item = Items[(head - 1 - age) & (N - 1)];
+			return true;
+		}
+
+		// Reports the number of snapshots stored.  
+		int GetCount() const
+		{
+			return count;
+		}
+
+		// Reports the most snapshots that can be stored.  
+		static int GetCapacity()
+		{
+			return N;
+		}
+
+	private:
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS DATA
+	//////////////////////////////////////////////////////////////////////////////////////
+		T		Items[N];		// The snapshots, wrapping around the ring.  
+		int		head;			// The position the next snapshot is stored at.  
+		int		count;			// The number of snapshots stored.  
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,170 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	SOFTWARE BACKEND MODULE																//
+//	Draws frames on the CPU into memory, so the game can be rendered where there is no	//
+//	Direct3D.  Vertices are lit & projected as each subset is drawn, and the triangles	//
+//	are set up & sorted into the tiles of the screen they touch.  Once the frame is		//
+//	finished, the tiles are filled in on every core at once, each tile by one thread	//
+//	from start to end, so no two threads ever touch the same pixel.  The stencil buffer	//
+//	keeps a byte for each pixel & works as Direct3D is set up to, so the ball's shadow	//
+//	only darkens each pixel once.														//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _SOFTWAREBACKEND_H_
+#define _SOFTWAREBACKEND_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <vector>			// Standard vector container.  
+#include "RenderBackend.h"	// Render backend interface.  
+#include "TaskPool.h"		// Work-stealing thread pool.  
+#include "Clock.h"			// Monotonic clock interface.  
+#include "RasterKernels.h"	// Triangle filling kernels.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	Settings for splitting the screen up.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define TILE_SIZE			64		// The width & height of a tile in pixels.  
+#define SUBPIXEL_STEPS		16.0f	// Vertices are snapped to 1/16th of a pixel.  
+#define NEAR_W				0.0001f	// Triangles nearer the eye than this are dropped.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	TRIANGLE STRUCTURE
+//	A triangle set up for filling in.  Each edge & each value carried across the triangle
+//	is a plane over the screen, a x + b y + c, found once here rather than for each pixel.  
+//	Colours are carried divided by w, with 1 / w alongside, so that they are corrected
+//	for perspective as Direct3D does.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct SoftTriangle
+{
+	double			Edges[3][3];	// Each edge, positive inside the triangle.  
+	bool			topLeft[3];		// Whether each edge is a top or left edge.  
+	double			Planes[6][3];	// The planes of z, 1 / w & r, g, b & a over w.  
+	int				box[4];			// The pixels it covers: left, top, right & bottom.  
+	unsigned int	states;			// The render states it was drawn with.  
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	TIMING STRUCTURE
+//	How long the parts of a frame took, in nanoseconds, & how much work there was.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct SoftTiming
+{
+	long long		geometry;		// Lighting, projecting & setting up triangles.  
+	long long		raster;			// Clearing & filling in the tiles.  
+	long long		frame;			// From the start of the frame to its end.  
+
+	int				triangles;		// Triangles drawn.  
+	int				culled;			// Triangles facing away, off screen or too near.  
+	int				binned;			// Triangles placed in tiles, counted once per tile.  
+	long long		pixels;			// Pixels filled in, before depth testing.  
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  The code for the methods is
+//	detailed in the module's source file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class SoftwareBackend : public RenderBackend
+{
+	public:
+		SoftwareBackend(int width, int height, int threads);	// Class constructor.  
+
+		const char* GetName();					// Reports what the backend is.  
+		int GetWidth();							// Reports the width drawn to.  
+		int GetHeight();						// Reports the height drawn to.  
+
+		int CreateMesh(const MeshView& Level);	// Makes a mesh, or reports -1.  
+		void DestroyMesh(int mesh);				// Frees a mesh.  
+		unsigned int GetFaceCount(int mesh);	// Reports a mesh's triangles.  
+		size_t GetMeshBytes(int mesh);			// Reports a mesh's memory.  
+
+		void BeginScene();						// Starts a frame.  
+		void EndScene();						// Fills in the frame's tiles.  
+		void Present();							// Finishes the frame's timing.  
+		void Clear(unsigned int flags, unsigned int colour, float depth,
+				   unsigned int stencil);		// Clears the given buffers.  
+
+		void SetTransform(int type, const Matrix& Transform);	// Sets a transform.  
+		void GetTransform(int type, Matrix& Transform);			// Reports a transform.  
+		void SetMaterial(const RenderMaterial& Material);		// Sets the material.  
+		void SetLight(const RenderLight& Light);				// Sets the light.  
+		void SetRenderState(int state, unsigned int value);		// Sets a render state.  
+
+		void DrawSubset(int mesh, unsigned int subset);			// Draws a subset.  
+
+		// Functions for getting at the finished frame.  
+		const unsigned int* GetPixels();		// Reports the frame as 0x00RRGGBB.  
+		bool WritePPM(const char* path);		// Saves the frame as a .ppm image.  
+		const SoftTiming& GetTiming();			// Reports the last frame's timings.  
+		int GetThreadCount();					// Reports the threads filling tiles.  
+		bool SetKernel(int kernel);				// Chooses the raster kernel.  
+		int GetKernel();						// Reports the raster kernel in use.  
+
+	private:
+		// A mesh, with its faces sorted into subsets.  
+		struct SoftMesh
+		{
+			std::vector<MeshVertex>		Vertices;	// Every vertex.  
+			std::vector<unsigned int>	Indices;	// Three indices per face, by subset.  
+			std::vector<unsigned int>	Subsets;	// Each subset's first face & count.  
+			bool						live;		// Whether the mesh is still held.  
+		};
+
+		void Light(const SoftMesh& Mesh);	// Lights & projects a mesh's vertices.  
+		void Setup(const float* A, const float* B, const float* C);	// Sets up a triangle.  
+		void Bin(int triangle);				// Places a triangle in the tiles it touches.  
+		void Rasterise();					// Fills in every tile.  
+		void FillTile(int tile, int worker);	// Fills in one tile.  
+
+		static void FillTask(int task, int worker, void* context);	// Runs FillTile().  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS OBJECTS
+	//////////////////////////////////////////////////////////////////////////////////////
+		std::vector<SoftMesh>			Models;		// Every mesh made.  
+		std::vector<unsigned int>		Colour;		// The colour of each pixel.  
+		std::vector<float>				Depth;		// The depth of each pixel.  
+		std::vector<unsigned char>		Stencil;	// The stencil of each pixel.  
+		std::vector<int>				Marked;		// Each tile's whole stencil + 1, or 0.  
+
+		std::vector<float>				Projected;	// Each vertex lit & projected.  
+		std::vector<SoftTriangle>		Triangles;	// Every triangle waiting to be filled.  
+		std::vector< std::vector<int> >	Bins;		// The triangles touching each tile.  
+		std::vector<long long>			Filled;		// Pixels filled by each thread.  
+
+		Matrix				Transforms[TRANSFORM_COUNT];	// The transforms set.  
+		RenderMaterial		Material;		// The material set.  
+		RenderLight			Lamp;			// The light set.  
+		unsigned int		States[STATE_COUNT];	// The render states set.  
+
+		TaskPool			Workers;		// The threads filling in tiles.  
+		SystemClock			Time;			// Times each part of the frame.  
+		SoftTiming			Timing;			// The last finished frame's timings.  
+		SoftTiming			Current;		// The frame being drawn's timings.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS DATA
+	//////////////////////////////////////////////////////////////////////////////////////
+		int				width, height;		// The size of the frame in pixels.  
+		int				tilesWide, tilesHigh;	// The number of tiles across & down.  
+
+		unsigned int	clearFlags;			// Buffers waiting to be cleared.  
+		unsigned int	clearColour;		// The colour to clear to.  
+		float			clearDepth;			// The depth to clear to.  
+		unsigned char	clearStencil;		// The stencil to clear to.  
+
+		long long		frameStart;			// When the frame was started.  
+		int				kernel;				// The raster kernel filling in tiles.  
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,79 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	STARTUP TIMELINE MODULE																//
+//	Records how long each part of starting the game takes, from launch to the first		//
+//	frame.  Parts may run side by side on different threads, so each is kept as its		//
+//	own span of time with the thread it ran on, rather than as one list of steps.		//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _STARTUPTIMELINE_H_
+#define _STARTUPTIMELINE_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <mutex>		// Standard mutual exclusion locks.  
+#include <thread>		// Standard thread library, for telling threads apart.  
+#include <vector>		// Standard vector container.  
+#include "Clock.h"		// Monotonic clock interface.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	Limits on the timeline.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define SPAN_NAME_LENGTH	48		// Longest span name, with terminator.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	SPAN STRUCTURE
+//	A single part of startup.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct TimelineSpan
+{
+	char			Name[SPAN_NAME_LENGTH];	// What was being done.  
+	long long		start;					// When it started, from the timeline's start.  
+	long long		end;					// When it ended, or -1 while still going.  
+	bool			worker;					// Whether it ran away from the main thread.  
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  The code for the methods is
+//	detailed in the module's source file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class StartupTimeline
+{
+	public:
+		StartupTimeline(Clock* Time);		// Class constructor.  
+
+		void Start();						// Marks the start, on the main thread.  
+		int Begin(const char* Name);		// Starts a span on the calling thread.  
+		void End(int span);					// Ends a span.  
+
+		// Functions to report the timeline.  
+		int GetSpanCount();					// Reports the number of spans.  
+		long long GetLength();				// Reports when the last span ended.  
+		void Format(int span, char* Line, int length);	// Describes a span.  
+
+	private:
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS OBJECTS
+	//////////////////////////////////////////////////////////////////////////////////////
+		Clock*						Time;	// The clock used for all timing.  
+		std::mutex					Lock;	// Guards the spans.  
+		std::vector<TimelineSpan>	Spans;	// Every span so far.  
+		std::thread::id				Main;	// The thread the timeline was started on.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS DATA
+	//////////////////////////////////////////////////////////////////////////////////////
+		long long					start;	// When the timeline was started.  
+};
+
+#endif
\ No newline at end of file
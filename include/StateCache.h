@@ -0,0 +1,100 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	STATE CACHE MODULE																	//
+//	A backend that sits in front of another & keeps a copy of every render state,		//
+//	transform, material & light set on it.  Anything set again to what it already is is	//
+//	dropped rather than passed on, and the calls passed on & dropped are counted.		//
+//	Until something has been set through the cache its value isn't known, so the first	//
+//	set is always passed on.															//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _STATECACHE_H_
+#define _STATECACHE_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "RenderBackend.h"	// Render backend interface.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	The kinds of setting the cache counts.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define CACHE_STATE				0		// SetRenderState().  
+#define CACHE_TRANSFORM			1		// SetTransform().  
+#define CACHE_MATERIAL			2		// SetMaterial().  
+#define CACHE_LIGHT				3		// SetLight().  
+#define CACHE_KINDS				4
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  The code for the methods is
+//	detailed in the module's source file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class StateCache : public RenderBackend
+{
+	public:
+		StateCache(RenderBackend* Target);		// Class constructor.  
+
+		const char* GetName();					// Reports what the backend is.  
+		int GetWidth();							// Reports the target's width.  
+		int GetHeight();						// Reports the target's height.  
+
+		int CreateMesh(const MeshView& Level);	// Makes a mesh in the target.  
+		void DestroyMesh(int mesh);				// Frees a mesh in the target.  
+		unsigned int GetFaceCount(int mesh);	// Reports a mesh's triangles.  
+		size_t GetMeshBytes(int mesh);			// Reports a mesh's memory.  
+
+		void BeginScene();						// Starts a frame.  
+		void EndScene();						// Finishes drawing a frame.  
+		void Present();							// Shows the finished frame.  
+		void Clear(unsigned int flags, unsigned int colour, float depth,
+				   unsigned int stencil);		// Clears the given buffers.  
+
+		void SetTransform(int type, const Matrix& Transform);	// Sets a changed transform.  
+		void GetTransform(int type, Matrix& Transform);			// Reports a transform.  
+		void SetMaterial(const RenderMaterial& Material);		// Sets a changed material.  
+		void SetLight(const RenderLight& Light);				// Sets a changed light.  
+		void SetRenderState(int state, unsigned int value);		// Sets a changed state.  
+
+		void DrawSubset(int mesh, unsigned int subset);			// Draws a subset.  
+
+		// Functions for the cache itself.  
+		void Forget();							// Forgets everything held.  
+		void ResetCounts();						// Starts the counts afresh.  
+		int GetIssued(int kind);				// Reports the calls passed on.  
+		int GetElided(int kind);				// Reports the calls dropped.  
+
+	private:
+		void Count(int kind, bool issued);		// Counts a call.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS OBJECTS
+	//////////////////////////////////////////////////////////////////////////////////////
+		RenderBackend*		Target;			// The backend calls are passed on to.  
+
+		Matrix				Transforms[TRANSFORM_COUNT];	// The transforms set.  
+		RenderMaterial		Material;		// The material set.  
+		RenderLight			Lamp;			// The light set.  
+		unsigned int		States[STATE_COUNT];	// The render states set.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS DATA
+	//////////////////////////////////////////////////////////////////////////////////////
+		bool			knownTransform[TRANSFORM_COUNT];	// Whether each transform is held.  
+		bool			knownState[STATE_COUNT];	// Whether each render state is held.  
+		bool			knownMaterial;		// Whether the material is held.  
+		bool			knownLight;			// Whether the light is held.  
+
+		int				issued[CACHE_KINDS];	// The calls of each kind passed on.  
+		int				elided[CACHE_KINDS];	// The calls of each kind dropped.  
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,88 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	TASK POOL MODULE																	//
+//	A work-stealing thread pool for spreading large numbers of independent tasks over	//
+//	every core.  The worker threads are started once & sleep between runs.  Each worker	//
+//	starts a run with its own share of the tasks, and once it has run out it steals		//
+//	from the other end of another worker's queue, so uneven task lengths never leave	//
+//	cores sitting idle.																	//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _TASKPOOL_H_
+#define _TASKPOOL_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <deque>		// Standard double-ended queue.  
+#include <mutex>		// Standard mutual exclusion locks.  
+#include <condition_variable>	// Standard condition variables.  
+#include <thread>		// Standard thread library.  
+#include <vector>		// Standard resizable array.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	TYPE DEFINITIONS
+//	The function run for each task.  It is given the task's index, the index of the
+//	worker running it (for per-worker results) & the context passed to Run().  
+//////////////////////////////////////////////////////////////////////////////////////////
+typedef void (*TaskFunction)(int task, int worker, void* context);
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  The code for the methods is
+//	detailed in the module's source file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class TaskPool
+{
+	public:
+		TaskPool(int threads);		// Class constructor.  
+		~TaskPool();				// Class destructor.  
+
+		// Runs the given number of tasks & waits for all of them to finish.  
+		void Run(int tasks, TaskFunction Function, void* context);
+
+		int GetThreadCount();		// Reports the number of workers.  
+		int GetSteals();			// Reports the tasks stolen during the last run.  
+
+	private:
+		void Wait(int worker);		// Main loop of each worker thread.  
+		void Work(int worker);		// Runs tasks until there are none left.  
+		bool Pop(int worker, int& task);	// Takes a task from a worker's own queue.  
+		bool Steal(int worker, int& task);	// Takes a task from another worker's queue.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS OBJECTS
+	//////////////////////////////////////////////////////////////////////////////////////
+		// Each worker's queue of tasks, along with the lock guarding it.  
+		struct WorkQueue
+		{
+			std::mutex		Lock;
+			std::deque<int>	Tasks;
+			int				steals;		// Tasks this worker has stolen.  
+		};
+
+		std::vector<WorkQueue*>	Queues;	// The queue for each worker.  
+		std::vector<std::thread>	Threads;	// Every worker besides the first.  
+		std::mutex					Lock;		// Guards the handover of each run.  
+		std::condition_variable		Wake;		// Signals a new run or the pool closing.  
+		std::condition_variable		Done;		// Signals the workers finishing a run.  
+
+		TaskFunction		Function;	// The function run for each task.  
+		void*				context;	// The context passed to each task.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS DATA
+	//////////////////////////////////////////////////////////////////////////////////////
+		int				run;			// The number of runs started.  
+		int				busy;			// Worker threads still on the current run.  
+		bool			closing;		// Whether the worker threads should finish.  
+};
+
+#endif
\ No newline at end of file
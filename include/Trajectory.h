@@ -0,0 +1,96 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	TRAJECTORY MODULE																	//
+//	The flight of the ball from one launch.  Every flight starts from y = 0 at t = 0	//
+//	and only depends on the gravity in use, so the heights are worked out once per		//
+//	gravity & then looked up, letting the simulation jump straight from one event to	//
+//	the next.  The closed form of the motion is used to predict where the events fall,	//
+//	while the stored heights are built with the same per-tick sum as the simulation	//
+//	so that jumping gives bit-identical results to stepping.							//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _TRAJECTORY_H_
+#define _TRAJECTORY_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <vector>		// Standard resizable array.  
+#include "Defines.h"	// Library for the project's definitions & macros.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	The heights the game's rules are checked against, & the longest flight stored.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define CONTACT_TOP			0.0f		// Highest point the ball touches the ring at.  
+#define CONTACT_BOTTOM		-0.5f		// Point the ball has passed through the ring.  
+#define FALLEN_DEPTH		-5.0f		// Depth at which the ball has fully fallen.  
+#define MAX_FLIGHT_TICKS	(1 << 20)	// Longest flight that is stored.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  The code for the methods is
+//	detailed in the module's source file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class Trajectory
+{
+	public:
+		Trajectory();								// Class constructor.  
+
+		void Build(float gravity, float velocity);	// Works out a flight's heights.  
+		bool Matches(float gravity, float velocity);// Checks the flight is up to date.  
+
+		float Height(int t);			// Reports the stored height at a given tick.  
+		double Estimate(double t);		// Reports the closed-form height at a tick.  
+		double EstimateTick(double y);	// Reports the closed-form tick for a height.  
+
+		int GetContact();		// First tick the ball is touching the ring.  
+		int GetPassed();		// First tick the ball is below the ring.  
+		int GetFallen();		// First tick the ball has fully fallen.  
+		int GetLength();		// Number of ticks stored.  
+
+	private:
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS OBJECTS
+	//////////////////////////////////////////////////////////////////////////////////////
+		std::vector<float>	Heights;	// The ball's height at each tick of the flight.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS DATA
+	//////////////////////////////////////////////////////////////////////////////////////
+		float	gravity;		// The gravity the flight was built for.  
+		float	velocity;		// The launch velocity the flight was built for.  
+
+		int		contact;		// First tick the ball is touching the ring.  
+		int		passed;			// First tick the ball is below the ring.  
+		int		fallen;			// First tick the ball has fully fallen.  
+};
+
+//	A set of flights for each level of a game, built once & then shared read-only
+//	between any number of sessions with the same tuning values.  The gravity at each
+//	level is stepped up with the same sum as the simulation uses.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class FlightCache
+{
+	public:
+		// Class constructor.  Builds the flights for the given number of levels.  
+		FlightCache(float initialGravity, float gravIncrease, float velocity, int levels);
+
+		// Finds the flight for a level, if it is stored & matches the given values.  
+		Trajectory* Find(int level, float gravity, float velocity);
+
+	private:
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS OBJECTS
+	//////////////////////////////////////////////////////////////////////////////////////
+		std::vector<Trajectory>	Flights;	// The flight for each level, from level 1.  
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,112 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	TRIPLE BUFFER MODULE																//
+//	Template class for handing snapshots from one thread to another without either ever	//
+//	waiting.  Of the three slots, the writer owns one & the reader another, with the	//
+//	third sitting in the middle holding the newest snapshot published.  Publishing		//
+//	swaps the writer's slot with the middle one, & reading swaps the middle slot with	//
+//	the reader's if anything new is in it, so each side only ever touches a slot the	//
+//	other can't.  The reader always gets the newest whole snapshot, & snapshots it was	//
+//	too slow to see are simply skipped.													//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _TRIPLEBUFFER_H_
+#define _TRIPLEBUFFER_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <atomic>		// Standard atomic operations.  
+#include <type_traits>	// Standard type traits, for checking snapshots are plain data.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	The parts of the word saying which slot is in the middle.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define TRIPLE_INDEX		3		// Picks out the slot in the middle.  
+#define TRIPLE_FRESH		4		// Set when the middle slot hasn't been read yet.  
+#define TRIPLE_LINE_BYTES	64		// Slots are kept this far apart so that the two
+									// threads don't fight over a cache line.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration & code of the class.  As a template, the whole class lives in the
+//	header.  Only one thread may write & only one may read.  
+//////////////////////////////////////////////////////////////////////////////////////////
+template <typename T> class TripleBuffer
+{
+	static_assert(std::is_trivially_copyable<T>::value, "Snapshots must be plain data.");
+
+	public:
+		// Class constructor.  Every slot starts out as the given snapshot, so the reader
+		// has something to read before anything is published.  
+		TripleBuffer(const T& First)
+		{
+			for (int i = 0 ; i < 3 ; i++)
+				Slots[i].Item = First;
+
+			write = 0;
+			read = 1;
+			Middle.store(2);
+		}
+
+		// Reports the slot the writer fills in.  It belongs to the writer alone until
+		// published.  
+		T& GetWriteSlot()
+		{
+			return Slots[write].Item;
+		}
+
+		// Hands the filled slot over as the newest snapshot, taking back whichever slot
+		// was in the middle to fill next.  
+		void Publish()
+		{
+			write = Middle.exchange(write | TRIPLE_FRESH, std::memory_order_acq_rel) & TRIPLE_INDEX;
+		}
+
+		// Picks up the newest snapshot, if one has been published since the last time.  
+		// Returns false if the reader already has the newest.  
+		bool Acquire()
+		{
+			if (!(Middle.load(std::memory_order_relaxed) & TRIPLE_FRESH))
+				return false;
+
+			read = Middle.exchange(read, std::memory_order_acq_rel) & TRIPLE_INDEX;
+			return true;
+		}
+
+		// Reports the snapshot the reader holds.  It stays the same until the next
+		// Acquire().  
+		const T& GetReadSlot() const
+		{
+			return Slots[read].Item;
+		}
+
+	private:
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS OBJECTS
+	//////////////////////////////////////////////////////////////////////////////////////
+		struct alignas(TRIPLE_LINE_BYTES) Slot
+		{
+			T	Item;
+		};
+
+		Slot				Slots[3];	// The three snapshots.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS DATA
+	//////////////////////////////////////////////////////////////////////////////////////
+		alignas(TRIPLE_LINE_BYTES) std::atomic<int>	Middle;	// The middle slot & whether
+														// it is fresh.  
+		alignas(TRIPLE_LINE_BYTES) int	write;		// The writer's slot.  
+		alignas(TRIPLE_LINE_BYTES) int	read;		// The reader's slot.  
+};
+
+#endif
\ No newline at end of file
@@ -0,0 +1,92 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	VERTEX PACKER MODULE																//
+//	Squeezes vertices into less than half the space for storing on disk.  Positions are	//
+//	kept as 16-bit fractions of the mesh's bounding box, normals are folded onto an		//
+//	octahedron & kept as two 16-bit values, and texture co-ordinates are kept as half-	//
+//	precision floats.  Packed vertices are unpacked again before being handed to		//
+//	Direct3D, so packing only saves space on disk & is left for meshes where that		//
+//	matters more than the time taken to open them.										//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _VERTEXPACKER_H_
+#define _VERTEXPACKER_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "MeshData.h"	// Flat mesh layout.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	The most a packed vertex may stray from the one it was packed from.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define PACK_MAX_POSITION	0.0001f		// Distance from the original position.  
+#define PACK_MAX_NORMAL		0.05f		// Angle from the original normal, in degrees.  
+#define PACK_MAX_UV			0.001f		// Distance from the original co-ordinates.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PACKED VERTEX STRUCTURE
+//	A vertex in 14 bytes rather than 32.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct PackedVertex
+{
+	unsigned short	position[3];			// Fractions of the bounding box.  
+	short			normal[2];				// The normal folded onto an octahedron.  
+	unsigned short	uv[2];					// Half-precision texture co-ordinates.  
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	BOUNDS STRUCTURE
+//	The box packed positions are fractions of.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct PackedBounds
+{
+	float			origin[3];				// The box's lowest corner.  
+	float			extent[3];				// The box's size along each axis.  
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	ERROR STRUCTURE
+//	How far a set of packed vertices strays from the originals, at its worst.  
+//////////////////////////////////////////////////////////////////////////////////////////
+struct PackedError
+{
+	float			position;				// Distance from the original position.  
+	float			normal;					// Angle from the original normal, in degrees.  
+	float			uv;						// Distance from the original co-ordinates.  
+};
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  The code for the methods is
+//	detailed in the module's source file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class VertexPacker
+{
+	public:
+		static PackedBounds Measure(const MeshVertex* Vertices, unsigned int count);	// Boxes.  
+		static void Pack(const MeshVertex* Vertices, unsigned int count,
+						 const PackedBounds& Bounds, PackedVertex* Out);		// Packs.  
+		static void Unpack(const PackedVertex* Vertices, unsigned int count,
+						   const PackedBounds& Bounds, MeshVertex* Out);		// Unpacks.  
+
+		static PackedError Compare(const MeshVertex* Original, const MeshVertex* Unpacked,
+								   unsigned int count);		// Measures the damage done.  
+		static bool WithinLimits(const PackedError& Error);	// Checks it against the limits.  
+
+	private:
+		static void PackNormal(const float* Normal, short* Out);		// Folds a normal.  
+		static void UnpackNormal(const short* Packed, float* Out);		// Unfolds a normal.  
+		static unsigned short PackHalf(float value);					// Halves a float.  
+		static float UnpackHalf(unsigned short half);					// Widens a half.  
+};
+
+#endif
\ No newline at end of file
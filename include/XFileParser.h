@@ -0,0 +1,101 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	X FILE PARSER MODULE																//
+//	Reads meshes from DirectX .x files in the text format, without needing D3DX.  The	//
+//	file is read in a single pass straight from memory, picking up each Mesh along		//
+//	with its MeshNormals, MeshTextureCoords & MeshMaterialList, and anything else is	//
+//	skipped over.  Frames are searched for meshes, but their transforms are ignored.	//
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifndef _XFILEPARSER_H_
+#define _XFILEPARSER_H_
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <stddef.h>		// Standard definitions, for size_t.  
+#include <vector>		// Standard vector container.  
+#include <string>		// Standard string class.  
+#include "MeshData.h"	// Flat mesh layout.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//	Declaration of all required class methods and data.  The code for the methods is
+//	detailed in the module's source file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+class XFileParser
+{
+	public:
+		XFileParser();								// Class constructor.  
+
+		bool Load(const char* path, MeshData& Mesh);	// Maps & parses a file.  
+		bool Parse(const char* Text, size_t size, MeshData& Mesh);	// Parses text.  
+
+		const char* GetError();						// Describes why parsing failed.  
+
+	private:
+		// Functions for reading the text a piece at a time.  
+		void SkipSpace();							// Skips spaces, separators & comments.  
+		bool Peek(char c);							// Checks the next character.  
+		bool Expect(char c);						// Reads a given character.  
+		bool ReadName(std::string& Name);			// Reads an identifier.  
+		bool ReadInt(int& value);					// Reads a whole number.  
+		bool ReadFloat(float& value);				// Reads a decimal number.  
+		bool ReadFloats(float* Values, int count);	// Reads a run of decimal numbers.  
+		bool ReadString(char* Text, int length);	// Reads a quoted string.  
+		bool OpenBlock();							// Reads an optional name & a brace.  
+		bool SkipBlock();							// Skips a block & everything in it.  
+
+		// Functions for reading each kind of block.  
+		bool ReadBlocks(bool nested);				// Reads blocks until the end.  
+		bool ReadMesh();							// Reads a Mesh block.  
+		bool ReadNormals();							// Reads a MeshNormals block.  
+		bool ReadTextureCoords();					// Reads a MeshTextureCoords block.  
+		bool ReadMaterialList();					// Reads a MeshMaterialList block.  
+		bool ReadMaterial(MeshMaterial& Material);	// Reads a Material block.  
+		bool ReadFaces(std::vector<int>& Faces, int vertices);	// Reads a face list.  
+
+		void BuildMesh();							// Adds the mesh just read to the output.  
+		bool Fail(const char* Problem);				// Records an error.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS OBJECTS
+	//////////////////////////////////////////////////////////////////////////////////////
+		MeshData*					Output;			// The mesh being read into.  
+
+		// The mesh currently being read, as laid out in the file.  
+		std::vector<float>			Positions;		// Three values per position.  
+		std::vector<float>			Normals;		// Three values per normal.  
+		std::vector<float>			TextureCoords;	// Two values per position.  
+		std::vector<int>			Faces;			// Each face's size, then its positions.  
+		std::vector<int>			NormalFaces;	// Each face's size, then its normals.  
+		std::vector<int>			FaceMaterials;	// The material of each face.  
+		std::vector<MeshMaterial>	Materials;		// The mesh's materials.  
+
+		// Materials defined outside of any mesh, to be referred to by name.  
+		std::vector<std::string>	SharedNames;	// The name of each material.  
+		std::vector<MeshMaterial>	Shared;			// The materials themselves.  
+
+		// Scratch space for matching up positions & normals into vertices.  
+		std::vector<int>			First;			// First vertex made from each position.  
+		std::vector<int>			Next;			// Next vertex made from the same position.  
+		std::vector<int>			VertexNormals;	// The normal each vertex was made with.  
+
+	//////////////////////////////////////////////////////////////////////////////////////
+	//	CLASS DATA
+	//////////////////////////////////////////////////////////////////////////////////////
+		const char*		Begin;			// The start of the text.  
+		const char*		Cursor;			// The next character to be read.  
+		const char*		End;			// The end of the text.  
+		const char*		Error;			// Why parsing failed, if it did.  
+		char			Message[128];	// Space for building the error message.  
+};
+
+#endif
\ No newline at end of file
@@ -55,8 +55,8 @@ int WINAPI WinMain(HINSTANCE hInstance, HINSTANCE hPrevInstance, LPSTR lpCmdLine
 	HWND hWnd = Win32.InitialiseWindow(SCREEN_WIDTH, SCREEN_HEIGHT, hInstance, nCmdShow);
 
 	// Creates the renderer object and sends to the class handles for the application's instance
-	// and window.  
-	D3DRenderer Direct3D(hInstance, hWnd);
+	// and window, along with the options it was launched with.  
+	D3DRenderer Direct3D(hInstance, hWnd, lpCmdLine);
 
 	Direct3D.Render();		// Starts off the render loop.  Will not leave it until the renderer
 							// decides to bail out.  
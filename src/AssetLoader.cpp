@@ -0,0 +1,194 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	ASSET LOADER MODULE																	//
+//	Reads & decodes meshes on worker threads, so that the main thread can get on with	//
+//	setting up Direct3D at the same time.  Each mesh asked for is read on its own		//
+//	thread, and the results are handed back to the main thread through a function		//
+//	given by the caller, as only the main thread may make Direct3D objects from them.	//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "AssetLoader.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>			// Standard I/O library, for copying errors.  
+#include <string.h>			// Standard string functions.  
+#include "XFileParser.h"	// .x text file parser.  
+#include "MS3DParser.h"		// MilkShape model parser.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	SOURCE METHODS
+//	Methods for reading a single mesh.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to read the mesh for the given file, from its cooked copy if there is one
+//	or else from the model itself.  A cooked copy can also have every byte checked, and
+//	one that fails is passed over for the model.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool MeshSource::Read(const char* path, bool verify)
+{
+	char Cooked[512];				// The name of the cooked copy.  
+	CookedMesh::CookedPath(path, Cooked, sizeof(Cooked));
+
+	Error[0] = '\0';
+	memset(&View, 0, sizeof(View));
+
+	if (Mapped.Open(Cooked) && (!verify || Mapped.Verify()))
+	{
+		View = Mapped.GetView();
+		return true;
+	}
+
+	XFileParser Parser;				// The .x file reader.  
+	MS3DParser Binary;				// The .ms3d file reader.  
+
+	if (MS3DParser::Matches(path))
+	{
+		if (!Binary.Load(path, Data))
+		{
+			snprintf(Error, sizeof(Error), "%s", Binary.GetError());
+			return false;
+		}
+	}
+	else if (!Parser.Load(path, Data))
+	{
+		snprintf(Error, sizeof(Error), "%s", Parser.GetError());
+		return false;
+	}
+
+	View = Data.GetView();
+	return true;
+}
+
+//	Function to report the mesh read.  The view is only good while the source lasts.  
+//////////////////////////////////////////////////////////////////////////////////////////
+const MeshView& MeshSource::GetView()
+{
+	return View;
+}
+
+//	Function to describe why reading failed.  The parsers' own messages go with them, so
+//	a copy is kept.  
+//////////////////////////////////////////////////////////////////////////////////////////
+const char* MeshSource::GetError()
+{
+	return Error[0] ? Error : "No error.";
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Class constructor.  The timeline may be NULL if the reads needn't be timed.  
+//////////////////////////////////////////////////////////////////////////////////////////
+AssetLoader::AssetLoader(StartupTimeline* Timeline)
+{
+	this->Timeline = Timeline;
+}
+
+//	Class destructor.  Waits for any reads still going, as they write into the jobs.  
+//////////////////////////////////////////////////////////////////////////////////////////
+AssetLoader::~AssetLoader()
+{
+	for (size_t i = 0 ; i < Jobs.size() ; i++)
+	{
+		if (Jobs[i]->Done.valid())
+			Jobs[i]->Done.wait();
+		delete Jobs[i];
+	}
+}
+
+//	Function to start reading the mesh for the given file on a thread of its own.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void AssetLoader::Request(const char* path)
+{
+	AssetJob* Job = new AssetJob;
+	Job->Path = path;
+	Job->published = false;
+	Job->Done = std::async(std::launch::async, &AssetLoader::Read, Job, Timeline);
+
+	Jobs.push_back(Job);
+}
+
+//	Function to hand every mesh that has finished reading since the last call to the
+//	given function, without waiting on those still going.  Must be called from the main
+//	thread.  Reports the number of meshes still being read.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int AssetLoader::Publish(PublishFunction Function, void* context)
+{
+	int waiting = 0;
+
+	for (size_t i = 0 ; i < Jobs.size() ; i++)
+	{
+		AssetJob* Job = Jobs[i];
+		if (Job->published)
+			continue;
+
+		if (Job->Done.wait_for(std::chrono::seconds(0)) == std::future_status::ready)
+			this->Hand(Job, Function, context);
+		else
+			waiting++;
+	}
+
+	return waiting;
+}
+
+//	Function to wait for every mesh still being read & hand each on as it finishes.  
+//	Must be called from the main thread.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void AssetLoader::Finish(PublishFunction Function, void* context)
+{
+	for (size_t i = 0 ; i < Jobs.size() ; i++)
+		if (!Jobs[i]->published)
+			this->Hand(Jobs[i], Function, context);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PRIVATE METHODS
+//	Methods called from within the class for better organisation of the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function run on each worker thread to read its mesh.  Every byte of a cooked copy is
+//	checked, as the time is spent away from the main thread.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool AssetLoader::Read(AssetJob* Job, StartupTimeline* Timeline)
+{
+	int span = -1;
+	if (Timeline)
+	{
+		std::string Name = "Read " + Job->Path;
+		span = Timeline->Begin(Name.c_str());
+	}
+
+	bool read = Job->Source.Read(Job->Path.c_str(), true);
+
+	if (Timeline)
+		Timeline->End(span);
+	return read;
+}
+
+//	Function to wait for a mesh to finish reading & hand it to the given function.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void AssetLoader::Hand(AssetJob* Job, PublishFunction Function, void* context)
+{
+	bool read = Job->Done.get();
+	Job->published = true;
+
+	if (read)
+		Function(Job->Path.c_str(), &Job->Source.GetView(), NULL, context);
+	else
+		Function(Job->Path.c_str(), NULL, Job->Source.GetError(), context);
+}
\ No newline at end of file
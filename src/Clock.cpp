@@ -0,0 +1,128 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLOCK MODULE																		//
+//	A small interface over a monotonic high-resolution clock.  Anything that needs to	//
+//	keep time is given a clock rather than reading the system's directly, so that a		//
+//	stand-in clock can be swapped in when running away from the real hardware.  The		//
+//	manual clock is one such stand-in, moving only when told to so timing code can be	//
+//	checked against known times.														//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "Clock.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <chrono>		// Standard high-resolution clocks.  
+#include <thread>		// Standard thread library, for sleeping.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to report the current time.  The steady clock is used as it never jumps
+//	backwards when the system time is changed.  
+//////////////////////////////////////////////////////////////////////////////////////////
+long long SystemClock::Now()
+{
+	return std::chrono::duration_cast<std::chrono::nanoseconds>(
+				std::chrono::steady_clock::now().time_since_epoch()).count();
+}
+
+//	Function to put the thread to sleep for the given time.  The operating system will
+//	often oversleep by up to a scheduler quantum, so callers needing accuracy should
+//	leave a margin and spin out the remainder.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void SystemClock::Sleep(long long ns)
+{
+	std::this_thread::sleep_for(std::chrono::nanoseconds(ns));
+}
+
+//	Function to give up the thread's time slice while spinning on the clock.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void SystemClock::Pause()
+{
+	std::this_thread::yield();
+}
+
+//	Class constructor.  The manual clock starts a second in, so that times just before
+//	the start are still positive, with no oversleep & pauses of a microsecond.  
+//////////////////////////////////////////////////////////////////////////////////////////
+ManualClock::ManualClock()
+{
+	this->now			= NS_PER_SECOND;
+	this->oversleep		= 0;
+	this->pause_length	= NS_PER_MS / 1000;
+	this->asleep		= 0;
+	this->pauses		= 0;
+}
+
+//	Function to report the time the clock has been moved on to.  
+//////////////////////////////////////////////////////////////////////////////////////////
+long long ManualClock::Now()
+{
+	return this->now;
+}
+
+//	Function to sleep for the given time, waking late by the oversleep set.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void ManualClock::Sleep(long long ns)
+{
+	this->now += ns + this->oversleep;
+	this->asleep += ns + this->oversleep;
+}
+
+//	Function to pause while spinning, moving the clock on by the length of a pause.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void ManualClock::Pause()
+{
+	this->now += this->pause_length;
+	this->pauses++;
+}
+
+//	Function to move the clock on by the given time, standing in for work being done.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void ManualClock::Advance(long long ns)
+{
+	this->now += ns;
+}
+
+//	Function to set how much later than asked each sleep wakes, as a real timer would.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void ManualClock::SetOversleep(long long ns)
+{
+	this->oversleep = ns;
+}
+
+//	Function to set how far each pause moves the clock on.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void ManualClock::SetPauseLength(long long ns)
+{
+	this->pause_length = ns;
+}
+
+//	Function to report the total time spent asleep.  
+//////////////////////////////////////////////////////////////////////////////////////////
+long long ManualClock::GetSleepTime()
+{
+	return this->asleep;
+}
+
+//	Function to report how many pauses have been made while spinning.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int ManualClock::GetPauseCount()
+{
+	return this->pauses;
+}
\ No newline at end of file
@@ -0,0 +1,344 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	COMMAND BUFFER MODULE																//
+//	A backend that records a frame's drawing instead of drawing it, to be handed on to	//
+//	another backend in one go.  Each call is packed into a single block of memory as a	//
+//	byte saying what it was, followed by its values; the block is kept from frame to	//
+//	frame, so once it has grown to fit a frame nothing more is allocated.  Meshes are	//
+//	made straight away in the backend being recorded for, as they outlive any one		//
+//	frame.																				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "CommandBuffer.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <string.h>			// Standard memory functions.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Class constructor.  Meshes are made in the given backend, & calls are replayed to it
+//	when submitted.  
+//////////////////////////////////////////////////////////////////////////////////////////
+CommandBuffer::CommandBuffer(RenderBackend* Target)
+{
+	this->Target = Target;
+	this->used = 0;
+	this->commands = 0;
+
+	Arena.resize(COMMAND_START_BYTES);
+
+	for (int i = 0 ; i < TRANSFORM_COUNT ; i++)
+		Transforms[i] = Matrix::Identity();
+}
+
+//	Function to report what the backend is.  
+//////////////////////////////////////////////////////////////////////////////////////////
+const char* CommandBuffer::GetName()
+{
+	return "Command buffer";
+}
+
+//	Function to report the width of the target in pixels.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int CommandBuffer::GetWidth()
+{
+	return Target->GetWidth();
+}
+
+//	Function to report the height of the target in pixels.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int CommandBuffer::GetHeight()
+{
+	return Target->GetHeight();
+}
+
+//	Function to make a mesh in the target straight away.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int CommandBuffer::CreateMesh(const MeshView& Level)
+{
+	return Target->CreateMesh(Level);
+}
+
+//	Function to free a mesh in the target straight away.  Any draws of it still recorded
+//	are passed over by the target when replayed.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void CommandBuffer::DestroyMesh(int mesh)
+{
+	Target->DestroyMesh(mesh);
+}
+
+//	Function to report the number of triangles in a mesh.  
+//////////////////////////////////////////////////////////////////////////////////////////
+unsigned int CommandBuffer::GetFaceCount(int mesh)
+{
+	return Target->GetFaceCount(mesh);
+}
+
+//	Function to report the memory a mesh takes up.  
+//////////////////////////////////////////////////////////////////////////////////////////
+size_t CommandBuffer::GetMeshBytes(int mesh)
+{
+	return Target->GetMeshBytes(mesh);
+}
+
+//	Function to record the start of a frame.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void CommandBuffer::BeginScene()
+{
+	this->Reserve(COMMAND_BEGIN, 0);
+}
+
+//	Function to record the end of drawing a frame.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void CommandBuffer::EndScene()
+{
+	this->Reserve(COMMAND_END, 0);
+}
+
+//	Function to record the frame being shown.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void CommandBuffer::Present()
+{
+	this->Reserve(COMMAND_PRESENT, 0);
+}
+
+//	Function to record a clear.  The flags only ever need a byte.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void CommandBuffer::Clear(unsigned int flags, unsigned int colour, float depth,
+						  unsigned int stencil)
+{
+	unsigned char* Data = this->Reserve(COMMAND_CLEAR, 1 + sizeof(colour) + sizeof(depth) +
+													   sizeof(stencil));
+	Data[0] = (unsigned char)flags;
+	memcpy(Data + 1, &colour, sizeof(colour));
+	memcpy(Data + 1 + sizeof(colour), &depth, sizeof(depth));
+	memcpy(Data + 1 + sizeof(colour) + sizeof(depth), &stencil, sizeof(stencil));
+}
+
+//	Function to record a transform, keeping a copy so that it can be read back before
+//	the frame is submitted.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void CommandBuffer::SetTransform(int type, const Matrix& Transform)
+{
+	if ((type < 0) || (type >= TRANSFORM_COUNT))
+		return;
+
+	Transforms[type] = Transform;
+
+	unsigned char* Data = this->Reserve(COMMAND_TRANSFORM, 1 + sizeof(Matrix));
+	Data[0] = (unsigned char)type;
+	memcpy(Data + 1, &Transform, sizeof(Matrix));
+}
+
+//	Function to report the transform last recorded.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void CommandBuffer::GetTransform(int type, Matrix& Transform)
+{
+	if ((type >= 0) && (type < TRANSFORM_COUNT))
+		Transform = Transforms[type];
+}
+
+//	Function to record a material.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void CommandBuffer::SetMaterial(const RenderMaterial& Material)
+{
+	memcpy(this->Reserve(COMMAND_MATERIAL, sizeof(Material)), &Material, sizeof(Material));
+}
+
+//	Function to record a light.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void CommandBuffer::SetLight(const RenderLight& Light)
+{
+	memcpy(this->Reserve(COMMAND_LIGHT, sizeof(Light)), &Light, sizeof(Light));
+}
+
+//	Function to record a render state.  There are few enough states for a byte.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void CommandBuffer::SetRenderState(int state, unsigned int value)
+{
+	if ((state < 0) || (state >= STATE_COUNT))
+		return;
+
+	unsigned char* Data = this->Reserve(COMMAND_STATE, 1 + sizeof(value));
+	Data[0] = (unsigned char)state;
+	memcpy(Data + 1, &value, sizeof(value));
+}
+
+//	Function to record a draw.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void CommandBuffer::DrawSubset(int mesh, unsigned int subset)
+{
+	unsigned char* Data = this->Reserve(COMMAND_DRAW, sizeof(mesh) + sizeof(subset));
+	memcpy(Data, &mesh, sizeof(mesh));
+	memcpy(Data + sizeof(mesh), &subset, sizeof(subset));
+}
+
+//	Function to hand everything recorded to the target, then empty the buffer.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void CommandBuffer::Submit()
+{
+	this->Replay(*Target);
+	this->Reset();
+}
+
+//	Function to make each recorded call on a backend, in the order recorded.  The buffer
+//	is left as it is, so it can be replayed again.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void CommandBuffer::Replay(RenderBackend& Backend)
+{
+	const unsigned char* Data = &Arena[0];
+	const unsigned char* End = Data + used;
+
+	while (Data < End)
+	{
+		int command = *Data++;
+
+		switch (command)
+		{
+			case COMMAND_BEGIN:
+				Backend.BeginScene();
+				break;
+
+			case COMMAND_END:
+				Backend.EndScene();
+				break;
+
+			case COMMAND_PRESENT:
+				Backend.Present();
+				break;
+
+			case COMMAND_CLEAR:
+			{
+				unsigned int colour, stencil;
+				float depth;
+				memcpy(&colour, Data + 1, sizeof(colour));
+				memcpy(&depth, Data + 1 + sizeof(colour), sizeof(depth));
+				memcpy(&stencil, Data + 1 + sizeof(colour) + sizeof(depth), sizeof(stencil));
+				Backend.Clear(Data[0], colour, depth, stencil);
+				Data += 1 + sizeof(colour) + sizeof(depth) + sizeof(stencil);
+				break;
+			}
+
+			case COMMAND_TRANSFORM:
+			{
+				Matrix Transform;
+				memcpy(&Transform, Data + 1, sizeof(Matrix));
+				Backend.SetTransform(Data[0], Transform);
+				Data += 1 + sizeof(Matrix);
+				break;
+			}
+
+			case COMMAND_MATERIAL:
+			{
+				RenderMaterial Material;
+				memcpy(&Material, Data, sizeof(Material));
+				Backend.SetMaterial(Material);
+				Data += sizeof(Material);
+				break;
+			}
+
+			case COMMAND_LIGHT:
+			{
+				RenderLight Light;
+				memcpy(&Light, Data, sizeof(Light));
+				Backend.SetLight(Light);
+				Data += sizeof(Light);
+				break;
+			}
+
+			case COMMAND_STATE:
+			{
+				unsigned int value;
+				memcpy(&value, Data + 1, sizeof(value));
+				Backend.SetRenderState(Data[0], value);
+				Data += 1 + sizeof(value);
+				break;
+			}
+
+			case COMMAND_DRAW:
+			{
+				int mesh;
+				unsigned int subset;
+				memcpy(&mesh, Data, sizeof(mesh));
+				memcpy(&subset, Data + sizeof(mesh), sizeof(subset));
+				Backend.DrawSubset(mesh, subset);
+				Data += sizeof(mesh) + sizeof(subset);
+				break;
+			}
+
+			default:
+				return;		// The buffer is damaged, so nothing after this can be trusted.  
+		}
+	}
+}
+
+//	Function to empty the buffer.  The memory is kept for the next frame.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void CommandBuffer::Reset()
+{
+	this->used = 0;
+	this->commands = 0;
+}
+
+//	Function to report the bytes recorded since the buffer was last emptied.  
+//////////////////////////////////////////////////////////////////////////////////////////
+size_t CommandBuffer::GetBytes()
+{
+	return this->used;
+}
+
+//	Function to report the calls recorded since the buffer was last emptied.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int CommandBuffer::GetCommandCount()
+{
+	return this->commands;
+}
+
+//	Function to report the memory set aside for recording.  
+//////////////////////////////////////////////////////////////////////////////////////////
+size_t CommandBuffer::GetCapacity()
+{
+	return Arena.size();
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PRIVATE METHODS
+//	Methods called from within the class for better organisation of the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to write a call's byte & make room for its values, reporting where they go.  
+//	The arena is doubled whenever it runs out, so it soon stops growing.  
+//////////////////////////////////////////////////////////////////////////////////////////
+unsigned char* CommandBuffer::Reserve(int command, size_t bytes)
+{
+	if (used + 1 + bytes > Arena.size())
+	{
+		size_t size = Arena.size() * 2;
+		while (used + 1 + bytes > size)
+			size *= 2;
+		Arena.resize(size);
+	}
+
+	unsigned char* Data = &Arena[used];
+	Data[0] = (unsigned char)command;
+
+	used += 1 + bytes;
+	commands++;
+	return Data + 1;
+}
\ No newline at end of file
@@ -0,0 +1,181 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CONTROLLER MODULE																	//
+//	Classes that stand in for the player when a session is run without a window.  A	//
+//	controller looks at the simulation each tick and decides how far to turn the ring,	//
+//	in the same steps the keyboard would.												//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "Controller.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Class constructor.  The reaction is how many ticks the bot waits after the colours
+//	change before it starts turning the ring.  
+//////////////////////////////////////////////////////////////////////////////////////////
+BotController::BotController(int reaction)
+{
+	this->reaction = reaction;
+	this->Reset();
+}
+
+//	Function to prepare the bot for a fresh session.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void BotController::Reset()
+{
+	this->waiting = this->reaction;
+	this->bounces = 0;
+}
+
+//	Function to pick the rotation for the coming tick.  The rotation is given in the
+//	same sense as Simulation::Rotate, so a positive value turns the ring's angle down.  
+//////////////////////////////////////////////////////////////////////////////////////////
+float BotController::Control(Simulation& Sim)
+{
+	this->Observe(Sim);		// Checks whether the colours have changed.  
+
+	// Does nothing until the bot has reacted.  
+	if (this->waiting > 0)
+	{
+		this->waiting--;
+		return 0.0f;
+	}
+
+	// Lets go of the keys once the right block is below the ball.  
+	if (Sim.GetBlockColour(Sim.GetBlockBelow()) == Sim.GetBallColour())
+		return 0.0f;
+
+	// Otherwise holds the key that turns towards the target.  
+	if (BotController::TargetAngle(Sim) > Sim.GetAngle())
+		return -KEY_ROTATION;
+	return KEY_ROTATION;
+}
+
+//	Function to report how many of the coming ticks the bot will keep the same turn
+//	for, & what that turn is: none for the rest of its reaction time, or for every tick
+//	until the colours next change if the ring is already in place, & otherwise the held
+//	key until the right block comes below the ball.  The key's turns are counted out one
+//	at a time from the current angle, so they round just as Control() would see them.
+//	The ring heads for the nearest matching block & stops inside it, well short of the
+//	block's centre, so the key held never changes along the way.  The count gives up
+//	after a full turn of the ring, in case no block matches.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int BotController::Hold(Simulation& Sim, float& x)
+{
+	this->Observe(Sim);		// Checks whether the colours have changed.  
+
+	x = 0.0f;
+	if (this->waiting > 0)
+		return this->waiting;
+
+	float angle = Sim.GetAngle();
+	if (Sim.GetBlockColour(Simulation::BlockBelow(angle)) == Sim.GetBallColour())
+		return HOLD_FOREVER;
+
+	// Picks the key as Control() would, then turns until the ball is over a match.  
+	x = (BotController::TargetAngle(Sim) > angle) ? -KEY_ROTATION : KEY_ROTATION;
+
+	int ticks = 0;
+	do
+	{
+		angle -= x;
+		ticks++;
+	}
+	while ((ticks < HOLD_TURN_LIMIT) &&
+		   (Sim.GetBlockColour(Simulation::BlockBelow(angle)) != Sim.GetBallColour()));
+
+	return ticks;
+}
+
+//	Function to let the given number of ticks pass as if Control() had been called for
+//	each of them while the bot held its turn.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void BotController::Skip(int ticks)
+{
+	this->waiting = (ticks < this->waiting) ? (this->waiting - ticks) : 0;
+}
+
+//	Function to find the ring angle closest to the current one that places a block of
+//	the ball's colour below the ball.  The block below is picked by flooring the angle
+//	(see Simulation::GetBlockBelow), so block k covers the angles [k, k + 1) once the
+//	30 degree offset is taken away, repeating every 6 radians.  
+//////////////////////////////////////////////////////////////////////////////////////////
+float BotController::TargetAngle(Simulation& Sim)
+{
+	float x = Sim.GetAngle();
+	float best = x;					// The closest target found so far.  
+	float distance = 1000.0f;		// How far the closest target is from the ring.  
+
+	for (int i = 0 ; i < NUM_BLOCKS ; i++)			// For each block in the ring...  
+	{
+		if (Sim.GetBlockColour(i) != Sim.GetBallColour())	// Skip the wrong colours.  
+			continue;
+
+		// Finds the copy of the block's centre nearest to the current angle.  
+		float centre = (i + 0.5f) - (PI / 6);
+		centre += 6.0f * floor((x - centre) / 6.0f + 0.5f);
+
+		float d = fabs(centre - x);
+		if (d < distance)
+		{
+			distance = d;
+			best = centre;
+		}
+	}
+
+	return best;
+}
+
+//	Function to start reacting to a new set of colours whenever the ball has bounced
+//	since the bot last looked.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void BotController::Observe(Simulation& Sim)
+{
+	if (Sim.GetBounces() != this->bounces)
+	{
+		this->bounces = Sim.GetBounces();
+		this->waiting = this->reaction;
+	}
+}
+
+//	Function to prepare the idle controller for a fresh session.  There is nothing to
+//	prepare.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void IdleController::Reset()
+{
+}
+
+//	Function to pick the rotation for the coming tick, which is always none.  
+//////////////////////////////////////////////////////////////////////////////////////////
+float IdleController::Control(Simulation&)
+{
+	return 0.0f;
+}
+
+//	Function to report how many of the coming ticks pass without input, which is all of
+//	them.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int IdleController::Hold(Simulation&, float& x)
+{
+	x = 0.0f;
+	return HOLD_FOREVER;
+}
+
+//	Function to let ticks pass without input.  There is nothing to keep track of.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void IdleController::Skip(int)
+{
+}
\ No newline at end of file
@@ -0,0 +1,364 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	COOKED MESH MODULE																	//
+//	A binary mesh format made to be used straight from a memory mapping.  A cooked file	//
+//	is a small header followed by the vertex, index, attribute, material & level of		//
+//	detail arrays laid out exactly as MeshData holds them, each starting on a 64-byte	//
+//	boundary, so loading one is no more than mapping it & checking the header.  The		//
+//	vertices may instead be packed into less than half the space on disk, but as the	//
+//	fixed-function pipeline can't read them packed they are unpacked into a copy on		//
+//	loading, which costs the mapping its zero-copy open; packing is only done when		//
+//	asked for, & the shipped models are left unpacked.  Files are cooked from models	//
+//	ahead of time by TABTool.															//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "CookedMesh.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <stddef.h>		// Standard definitions, for offsetof.  
+#include <stdio.h>		// Standard I/O library.  
+#include <string.h>		// Standard string functions.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE CHECKS
+//	The file is read as it lies, so the layouts it was written with must not change
+//	without the version being raised.  
+//////////////////////////////////////////////////////////////////////////////////////////
+static_assert(sizeof(MeshVertex) == 32, "MeshVertex layout has changed.");
+static_assert(sizeof(MeshMaterial) == 108, "MeshMaterial layout has changed.");
+static_assert(sizeof(MeshLod) == 24, "MeshLod layout has changed.");
+static_assert(sizeof(PackedVertex) == 14, "PackedVertex layout has changed.");
+static_assert(sizeof(CookedHeader) == 144, "CookedHeader layout has changed.");
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Class constructor.  
+//////////////////////////////////////////////////////////////////////////////////////////
+CookedMesh::CookedMesh()
+{
+	this->Header = NULL;
+	this->Error = NULL;
+}
+
+//	Function to map a cooked mesh & check that it can be used.  Only the header & the
+//	short list of levels are checked here - the header's checksum, its version & that
+//	every section & level lies inside the file - so opening costs the same however large
+//	the mesh is.  The data itself can be checked as well with Verify().  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool CookedMesh::Open(const char* path)
+{
+	unsigned int Strides[COOKED_SECTIONS] =
+		{ sizeof(MeshVertex), sizeof(unsigned int), sizeof(unsigned int), sizeof(MeshMaterial),
+		  sizeof(MeshLod) };
+
+	this->Close();
+	Error = NULL;
+
+	if (!File.Open(path))
+		return this->Fail("Unable to open the cooked mesh.");
+	if (File.GetSize() < sizeof(CookedHeader))
+		return this->Fail("Cooked mesh is too small.");
+
+	Header = (const CookedHeader*)File.GetData();
+
+	if ((Header->magic != COOKED_MAGIC) || (Header->headerSize != sizeof(CookedHeader)))
+		return this->Fail("Not a cooked mesh.");
+	if (Header->version != COOKED_VERSION)
+		return this->Fail("Cooked mesh is from another version.");
+	if (Header->headerChecksum != CookedMesh::Checksum(Header, offsetof(CookedHeader, headerChecksum)))
+		return this->Fail("Cooked mesh header is damaged.");
+	if (Header->fileSize != File.GetSize())
+		return this->Fail("Cooked mesh is the wrong size.");
+	if (Header->flags & ~COOKED_PACKED)
+		return this->Fail("Cooked mesh uses an unknown layout.");
+
+	if (this->IsPacked())
+		Strides[COOKED_VERTICES] = sizeof(PackedVertex);
+
+	for (int i = 0 ; i < COOKED_SECTIONS ; i++)
+	{
+		const CookedSection& Section = Header->Sections[i];
+
+		if ((Section.stride != Strides[i]) || (Section.offset % COOKED_ALIGNMENT) ||
+			(Section.offset + (unsigned long long)Section.count * Section.stride > Header->fileSize))
+			return this->Fail("Cooked mesh section is out of place.");
+	}
+
+	// Checks that the sections agree with each other.  
+	const CookedSection* Sections = Header->Sections;
+	if ((Sections[COOKED_INDICES].count != Sections[COOKED_ATTRIBUTES].count * 3) ||
+		(Sections[COOKED_VERTICES].count == 0) || (Sections[COOKED_MATERIALS].count == 0) ||
+		(Sections[COOKED_LODS].count > MESH_MAX_LODS))
+		return this->Fail("Cooked mesh sections don't match.");
+
+	// Checks that each level of detail lies inside the arrays.  
+	const MeshLod* Lods = (const MeshLod*)(File.GetData() + Sections[COOKED_LODS].offset);
+	for (unsigned int i = 0 ; i < Sections[COOKED_LODS].count ; i++)
+	{
+		unsigned long long vertices = (unsigned long long)Lods[i].firstVertex + Lods[i].numVertices;
+		unsigned long long faces = (unsigned long long)Lods[i].firstFace + Lods[i].numFaces;
+
+		if ((vertices > Sections[COOKED_VERTICES].count) ||
+			(faces > Sections[COOKED_ATTRIBUTES].count) || (Lods[i].numFaces == 0))
+			return this->Fail("Cooked mesh level of detail is out of place.");
+	}
+
+	return true;
+}
+
+//	Function to unmap the mesh.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void CookedMesh::Close()
+{
+	File.Close();
+	Header = NULL;
+	Unpacked.clear();
+}
+
+//	Function to check the whole of the mesh's data against the checksum it was cooked
+//	with, along with every index & attribute, for when a file may have been damaged
+//	without its header being touched.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool CookedMesh::Verify()
+{
+	if (!Header)
+		return false;
+
+	const char* Data = File.GetData() + sizeof(CookedHeader);
+	if (Header->dataChecksum != CookedMesh::Checksum(Data, File.GetSize() - sizeof(CookedHeader)))
+		return this->Fail("Cooked mesh data is damaged.");
+
+	// Each level's indices count from its own first vertex, so are checked level by level.  
+	MeshView Mesh = this->GetView();
+	for (unsigned int level = 0 ; level < Mesh.GetLodCount() ; level++)
+	{
+		MeshView View = Mesh.GetLod(level);
+
+		for (unsigned int i = 0 ; i < View.numIndices ; i++)
+			if (View.Indices[i] >= View.numVertices)
+				return this->Fail("Cooked mesh index out of range.");
+		for (unsigned int i = 0 ; i < View.numFaces ; i++)
+			if (View.Attributes[i] >= View.numMaterials)
+				return this->Fail("Cooked mesh material out of range.");
+	}
+
+	return true;
+}
+
+//	Function to report a view of the mapped mesh.  The view points straight into the
+//	mapping, so it is only good until the mesh is closed.  Packed vertices are unpacked
+//	the first time a view is asked for & kept alongside the mapping.  
+//////////////////////////////////////////////////////////////////////////////////////////
+MeshView CookedMesh::GetView()
+{
+	MeshView View;
+	memset(&View, 0, sizeof(View));
+
+	if (!Header)
+		return View;
+
+	const char* Data = File.GetData();
+	const CookedSection* Sections = Header->Sections;
+
+	View.Vertices		= (const MeshVertex*)(Data + Sections[COOKED_VERTICES].offset);
+	View.Indices		= (const unsigned int*)(Data + Sections[COOKED_INDICES].offset);
+	View.Attributes		= (const unsigned int*)(Data + Sections[COOKED_ATTRIBUTES].offset);
+	View.Materials		= (const MeshMaterial*)(Data + Sections[COOKED_MATERIALS].offset);
+	View.Lods			= (const MeshLod*)(Data + Sections[COOKED_LODS].offset);
+
+	if (this->IsPacked())
+	{
+		if (Unpacked.empty())
+		{
+			Unpacked.resize(Sections[COOKED_VERTICES].count);
+			VertexPacker::Unpack((const PackedVertex*)(Data + Sections[COOKED_VERTICES].offset),
+								 Sections[COOKED_VERTICES].count, Header->Bounds, &Unpacked[0]);
+		}
+		View.Vertices	= &Unpacked[0];
+	}
+
+	View.numVertices	= Sections[COOKED_VERTICES].count;
+	View.numIndices		= Sections[COOKED_INDICES].count;
+	View.numFaces		= Sections[COOKED_ATTRIBUTES].count;
+	View.numMaterials	= Sections[COOKED_MATERIALS].count;
+	View.numLods		= Sections[COOKED_LODS].count;
+
+	return View;
+}
+
+//	Function to report whether the mesh's vertices were packed when it was cooked.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool CookedMesh::IsPacked()
+{
+	return Header && (Header->flags & COOKED_PACKED);
+}
+
+//	Function to report the checksum the mesh's data was cooked with.  As it covers the
+//	whole mesh, it doubles as a cheap fingerprint of the mesh's content.  
+//////////////////////////////////////////////////////////////////////////////////////////
+unsigned long long CookedMesh::GetChecksum()
+{
+	return Header ? Header->dataChecksum : 0;
+}
+
+//	Function to report the size of the mapped file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+size_t CookedMesh::GetSize()
+{
+	return File.GetSize();
+}
+
+//	Function to describe why opening or verifying failed.  
+//////////////////////////////////////////////////////////////////////////////////////////
+const char* CookedMesh::GetError()
+{
+	return Error ? Error : "No error.";
+}
+
+//	Function to cook a mesh into the given file, packing its vertices if asked to.  Each
+//	section is padded out to the next 64-byte boundary so that every array starts on a
+//	cache line once mapped.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool CookedMesh::Write(const char* path, const MeshView& Mesh, bool packed)
+{
+	const void* Arrays[COOKED_SECTIONS] =
+		{ Mesh.Vertices, Mesh.Indices, Mesh.Attributes, Mesh.Materials, Mesh.Lods };
+	const unsigned int Counts[COOKED_SECTIONS] =
+		{ Mesh.numVertices, Mesh.numIndices, Mesh.numFaces, Mesh.numMaterials, Mesh.numLods };
+	unsigned int Strides[COOKED_SECTIONS] =
+		{ sizeof(MeshVertex), sizeof(unsigned int), sizeof(unsigned int), sizeof(MeshMaterial),
+		  sizeof(MeshLod) };
+
+	CookedHeader Header;
+	memset(&Header, 0, sizeof(Header));
+	Header.magic		= COOKED_MAGIC;
+	Header.version		= COOKED_VERSION;
+	Header.headerSize	= sizeof(CookedHeader);
+
+	// Packs the vertices inside the box around every level.  
+	std::vector<PackedVertex> Packed;
+	if (packed)
+	{
+		Header.flags	= COOKED_PACKED;
+		Header.Bounds	= VertexPacker::Measure(Mesh.Vertices, Mesh.numVertices);
+
+		Packed.resize(Mesh.numVertices);
+		if (Mesh.numVertices)
+			VertexPacker::Pack(Mesh.Vertices, Mesh.numVertices, Header.Bounds, &Packed[0]);
+
+		Arrays[COOKED_VERTICES] = Packed.empty() ? NULL : &Packed[0];
+		Strides[COOKED_VERTICES] = sizeof(PackedVertex);
+	}
+
+	// Lays the sections out one after another, each on a fresh boundary.  
+	unsigned long long offset = sizeof(CookedHeader);
+	for (int i = 0 ; i < COOKED_SECTIONS ; i++)
+	{
+		offset = (offset + COOKED_ALIGNMENT - 1) & ~(unsigned long long)(COOKED_ALIGNMENT - 1);
+
+		Header.Sections[i].offset = offset;
+		Header.Sections[i].count = Counts[i];
+		Header.Sections[i].stride = Strides[i];
+
+		offset += (unsigned long long)Counts[i] * Strides[i];
+	}
+	Header.fileSize = offset;
+
+	// Builds the file in memory, so the checksums can be worked out before writing.  
+	std::vector<char> Blob((size_t)offset, 0);
+	for (int i = 0 ; i < COOKED_SECTIONS ; i++)
+		if (Counts[i])
+			memcpy(&Blob[(size_t)Header.Sections[i].offset], Arrays[i], Counts[i] * Strides[i]);
+
+	Header.dataChecksum = CookedMesh::Checksum(&Blob[sizeof(CookedHeader)], Blob.size() - sizeof(CookedHeader));
+	Header.headerChecksum = CookedMesh::Checksum(&Header, offsetof(CookedHeader, headerChecksum));
+	memcpy(&Blob[0], &Header, sizeof(Header));
+
+	FILE* Out = fopen(path, "wb");
+	if (!Out)
+		return false;
+
+	bool written = (fwrite(&Blob[0], 1, Blob.size(), Out) == Blob.size());
+	return (fclose(Out) == 0) && written;
+}
+
+//	Function to give the name of the cooked file for a model, which is the model's own
+//	name with its extension swapped for the cooked one.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void CookedMesh::CookedPath(const char* path, char* Cooked, int length)
+{
+	snprintf(Cooked, length, "%s", path);
+
+	char* Extension = strrchr(Cooked, '.');
+	char* Folder = strrchr(Cooked, '/');
+	char* Back = strrchr(Cooked, '\\');
+	if (Back > Folder)
+		Folder = Back;
+
+	if (Extension && (Extension > Folder))
+		*Extension = '\0';
+
+	size_t used = strlen(Cooked);
+	snprintf(Cooked + used, length - used, "%s", COOKED_EXTENSION);
+}
+
+//	Function to work out a 64-bit checksum of the given data.  It takes eight bytes at a
+//	time, mixing each word in with a multiply & a rotate, so checking a mesh costs far
+//	less than reading it would.  
+//////////////////////////////////////////////////////////////////////////////////////////
+unsigned long long CookedMesh::Checksum(const void* Data, size_t size)
+{
+	const unsigned char* Bytes = (const unsigned char*)Data;
+	unsigned long long hash = 0x9e3779b97f4a7c15ULL ^ size;
+
+	size_t i = 0;
+	for ( ; i + 8 <= size ; i += 8)
+	{
+		unsigned long long word;
+		memcpy(&word, Bytes + i, 8);
+
+		hash ^= word * 0xff51afd7ed558ccdULL;
+		hash = ((hash << 31) | (hash >> 33)) * 0xc4ceb9fe1a85ec53ULL;
+	}
+
+	// Mixes in any bytes left over.  
+	unsigned long long tail = 0;
+	memcpy(&tail, Bytes + i, size - i);
+	hash ^= tail * 0xff51afd7ed558ccdULL;
+
+	hash ^= hash >> 33;
+	hash *= 0xff51afd7ed558ccdULL;
+	hash ^= hash >> 33;
+	return hash;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PRIVATE METHODS
+//	Methods called from within the class for better organisation of the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to record an error & unmap the file.  Always returns false so that it can
+//	be returned straight from a failed check.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool CookedMesh::Fail(const char* Message)
+{
+	this->Close();
+	Error = Message;
+	return false;
+}
\ No newline at end of file
@@ -0,0 +1,283 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	DIRECT3D BACKEND MODULE																//
+//	Draws through the Direct3D device made by the settings class.  Each call is handed	//
+//	more or less straight to the device, as the backend's types are laid out the same	//
+//	as Direct3D's; meshes are kept as D3DX meshes, one for each mesh made.				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "D3D9Backend.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <string.h>			// Standard memory functions.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	Checks that the backend's types can be handed to Direct3D as they are.  Either
+//	array has a negative size, & fails to compile, if the layouts ever part.  
+//////////////////////////////////////////////////////////////////////////////////////////
+typedef char MaterialMatchesD3D[(sizeof(RenderMaterial) == sizeof(D3DMATERIAL9)) ? 1 : -1];
+typedef char MatrixMatchesD3D[(sizeof(Matrix) == sizeof(D3DMATRIX)) ? 1 : -1];
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Class constructor.  The size drawn to is taken from the device's viewport.  
+//////////////////////////////////////////////////////////////////////////////////////////
+D3D9Backend::D3D9Backend(IDirect3DDevice9* Device)
+{
+	this->Device = Device;
+
+	D3DVIEWPORT9 Viewport;					// The area being drawn to.  
+	Device->GetViewport(&Viewport);
+	this->width = (int)Viewport.Width;
+	this->height = (int)Viewport.Height;
+
+	for (int i = 0 ; i < TRANSFORM_COUNT ; i++)
+		Transforms[i] = Matrix::Identity();
+}
+
+//	Class destructor.  Frees any meshes still held.  
+//////////////////////////////////////////////////////////////////////////////////////////
+D3D9Backend::~D3D9Backend()
+{
+	for (size_t i = 0 ; i < Buffers.size() ; i++)
+		this->DestroyMesh((int)i);
+}
+
+//	Function to report what the backend is.  
+//////////////////////////////////////////////////////////////////////////////////////////
+const char* D3D9Backend::GetName()
+{
+	return "Direct3D 9";
+}
+
+//	Function to report the width of the viewport in pixels.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int D3D9Backend::GetWidth()
+{
+	return this->width;
+}
+
+//	Function to report the height of the viewport in pixels.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int D3D9Backend::GetHeight()
+{
+	return this->height;
+}
+
+//	Function to create the Direct3D mesh for a single level of detail.  The vertices are
+//	copied straight in, as MeshVertex matches the XYZ | NORMAL | TEX1 layout, and 16-bit
+//	indices are used whenever the level is small enough.  The faces are then sorted by
+//	material so that each subset is drawn in one go, as D3DXLoadMeshFromX() used to do.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int D3D9Backend::CreateMesh(const MeshView& Level)
+{
+	DWORD numVertices = Level.numVertices;
+	DWORD numFaces = Level.numFaces;
+	bool wide = (numVertices > 0xffff);		// Whether 32-bit indices are needed.  
+	ID3DXMesh* Mesh = NULL;
+
+	// Creates an empty mesh of the right size.  
+	if (FAILED(D3DXCreateMeshFVF(	numFaces,
+									numVertices,
+									D3DXMESH_SYSTEMMEM | (wide ? D3DXMESH_32BIT : 0),
+									D3DFVF_XYZ | D3DFVF_NORMAL | D3DFVF_TEX1,
+									Device,
+									&Mesh)))
+	{
+		MessageBox(0, ERROR_MESH_MSG, ERROR_MESH_TTL, 0);
+		return -1;
+	}
+
+	// Fills the vertex buffer.  
+	void* Buffer;
+	Mesh->LockVertexBuffer(0, &Buffer);
+	memcpy(Buffer, Level.Vertices, numVertices * sizeof(MeshVertex));
+	Mesh->UnlockVertexBuffer();
+
+	// Fills the index buffer, narrowing each index if 16-bit indices are in use.  
+	Mesh->LockIndexBuffer(0, &Buffer);
+	if (wide)
+		memcpy(Buffer, Level.Indices, Level.numIndices * sizeof(unsigned int));
+	else
+	{
+		WORD* Indices = (WORD*)Buffer;
+		for (DWORD i = 0 ; i < Level.numIndices ; i++)
+			Indices[i] = (WORD)Level.Indices[i];
+	}
+	Mesh->UnlockIndexBuffer();
+
+	// Fills the material of each face.  
+	DWORD* Attributes;
+	Mesh->LockAttributeBuffer(0, &Attributes);
+	memcpy(Attributes, Level.Attributes, numFaces * sizeof(DWORD));
+	Mesh->UnlockAttributeBuffer();
+
+	// Groups the faces into a subset for each material.  
+	Mesh->OptimizeInplace(D3DXMESHOPT_ATTRSORT, NULL, NULL, NULL, NULL);
+
+	Buffers.push_back(Mesh);
+	return (int)Buffers.size() - 1;
+}
+
+//	Function to free a mesh.  Its number isn't handed out again.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void D3D9Backend::DestroyMesh(int mesh)
+{
+	if ((mesh < 0) || (mesh >= (int)Buffers.size()) || !Buffers[mesh])
+		return;
+
+	Buffers[mesh]->Release();
+	Buffers[mesh] = NULL;
+}
+
+//	Function to report the number of triangles in a mesh.  
+//////////////////////////////////////////////////////////////////////////////////////////
+unsigned int D3D9Backend::GetFaceCount(int mesh)
+{
+	if ((mesh < 0) || (mesh >= (int)Buffers.size()) || !Buffers[mesh])
+		return 0;
+	return Buffers[mesh]->GetNumFaces();
+}
+
+//	Function to work out the memory a mesh takes up in its three buffers.  
+//////////////////////////////////////////////////////////////////////////////////////////
+size_t D3D9Backend::GetMeshBytes(int mesh)
+{
+	if ((mesh < 0) || (mesh >= (int)Buffers.size()) || !Buffers[mesh])
+		return 0;
+
+	ID3DXMesh* Mesh = Buffers[mesh];
+	bool wide = (Mesh->GetOptions() & D3DXMESH_32BIT) != 0;
+
+	return Mesh->GetNumVertices() * Mesh->GetNumBytesPerVertex() +
+		   Mesh->GetNumFaces() * 3 * (wide ? sizeof(DWORD) : sizeof(WORD)) +
+		   Mesh->GetNumFaces() * sizeof(DWORD);
+}
+
+//	Function to start rendering the 3D scene.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void D3D9Backend::BeginScene()
+{
+	Device->BeginScene();
+}
+
+//	Function to end rendering the 3D scene.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void D3D9Backend::EndScene()
+{
+	Device->EndScene();
+}
+
+//	Function to display the created frame.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void D3D9Backend::Present()
+{
+	Device->Present(NULL, NULL, NULL, NULL);
+}
+
+//	Function to clear the given buffers, all in a single call to the device.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void D3D9Backend::Clear(unsigned int flags, unsigned int colour, float depth,
+						unsigned int stencil)
+{
+	DWORD clear = 0;
+	if (flags & CLEAR_TARGET)
+		clear |= D3DCLEAR_TARGET;
+	if (flags & CLEAR_DEPTH)
+		clear |= D3DCLEAR_ZBUFFER;
+	if (flags & CLEAR_STENCIL)
+		clear |= D3DCLEAR_STENCIL;
+
+	Device->Clear(0, NULL, clear, colour, depth, stencil);
+}
+
+//	Function to set one of the transforms, keeping a copy so that it can be read back
+//	without asking the device.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void D3D9Backend::SetTransform(int type, const Matrix& Transform)
+{
+	static const D3DTRANSFORMSTATETYPE Types[TRANSFORM_COUNT] =
+		{ D3DTS_WORLD, D3DTS_VIEW, D3DTS_PROJECTION };
+
+	if ((type < 0) || (type >= TRANSFORM_COUNT))
+		return;
+
+	Transforms[type] = Transform;
+	Device->SetTransform(Types[type], (const D3DMATRIX*)&Transform);
+}
+
+//	Function to report one of the transforms.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void D3D9Backend::GetTransform(int type, Matrix& Transform)
+{
+	if ((type >= 0) && (type < TRANSFORM_COUNT))
+		Transform = Transforms[type];
+}
+
+//	Function to set the material.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void D3D9Backend::SetMaterial(const RenderMaterial& Material)
+{
+	Device->SetMaterial((const D3DMATERIAL9*)&Material);
+}
+
+//	Function to set the light as light #0 & activate it.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void D3D9Backend::SetLight(const RenderLight& Light)
+{
+	D3DLIGHT9 Lamp;							// A struct for a Direct3D light.  
+	ZeroMemory(&Lamp, sizeof(Lamp));
+
+	Lamp.Type			= D3DLIGHT_POINT;
+	Lamp.Diffuse.r		= Light.Diffuse.r;
+	Lamp.Diffuse.g		= Light.Diffuse.g;
+	Lamp.Diffuse.b		= Light.Diffuse.b;
+	Lamp.Diffuse.a		= Light.Diffuse.a;
+	Lamp.Position.x		= Light.position[0];
+	Lamp.Position.y		= Light.position[1];
+	Lamp.Position.z		= Light.position[2];
+	Lamp.Range			= Light.range;
+	Lamp.Attenuation0	= Light.attenuation[0];
+	Lamp.Attenuation1	= Light.attenuation[1];
+	Lamp.Attenuation2	= Light.attenuation[2];
+
+	Device->SetLight(0, &Lamp);
+	Device->LightEnable(0, true);
+}
+
+//	Function to set one of the render states on the device.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void D3D9Backend::SetRenderState(int state, unsigned int value)
+{
+	static const D3DRENDERSTATETYPE States[STATE_COUNT] =
+		{ D3DRS_LIGHTING, D3DRS_AMBIENT, D3DRS_ALPHABLENDENABLE, D3DRS_ZENABLE,
+		  D3DRS_STENCILENABLE };
+
+	if ((state >= 0) && (state < STATE_COUNT))
+		Device->SetRenderState(States[state], value);
+}
+
+//	Function to draw a subset of a mesh.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void D3D9Backend::DrawSubset(int mesh, unsigned int subset)
+{
+	if ((mesh >= 0) && (mesh < (int)Buffers.size()) && Buffers[mesh])
+		Buffers[mesh]->DrawSubset(subset);
+}
\ No newline at end of file
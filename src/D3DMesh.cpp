@@ -23,73 +23,63 @@
 //	Methods called by other classes.  
 //////////////////////////////////////////////////////////////////////////////////////////
 
-//	Class constructor.  When initialised, the function gets a pointer to the application's
-//	main Direct3D device and stores the pointer in the class for use in other functions.  
+//	Class constructor.  When initialised, the function gets a pointer to the render
+//	backend the meshes are made in and stores the pointer in the class for use in other
+//	functions.  
 //////////////////////////////////////////////////////////////////////////////////////////
 D3DMesh::D3DMesh()
 {
-	this->Device = Settings.GetDevice();
+	this->Backend = Meshes.GetBackend();
+
+	this->Asset = NULL;
+	this->numMaterials = 0;
+	this->Drawable.numLods = 0;
+	this->Drawable.numMaterials = 0;
+	this->colour = PALETTE_NONE;
 }
 
-//	Class destructor.  When initialised, the function makes sure that the stored mesh is
-//	removed to prevent a memory leak.  
+//	Class destructor.  When initialised, the function makes sure that the shared mesh is
+//	handed back to the cache to prevent a memory leak.  
 //////////////////////////////////////////////////////////////////////////////////////////
 D3DMesh::~D3DMesh()
 {
-	Mesh->Release();
+	if (Asset)
+		Meshes.Release(Asset);
 }
 
-//	Function to load in the class's .x mesh.  
+//	Function to load in the class's mesh.  The mesh & its materials come from the cache,
+//	so every object loading the same model shares one copy of them; each object's colour
+//	is only put into the materials as it is drawn.  
 //////////////////////////////////////////////////////////////////////////////////////////
-void D3DMesh::Load(LPCTSTR Filename)
+bool D3DMesh::Load(LPCTSTR Filename)
 {
-	// Loads a mesh in from an .x file.  
-	D3DXLoadMeshFromX(	Filename,				// Name of the .x file.  
-						D3DXMESH_SYSTEMMEM,		// Loads the mesh into system memory
-						this->Device,			// The application's Direct3D Device
-						NULL,					// Adjacency isn't being used.  
-						&this->MaterialBuffer,	// Materials are placed in the given buffer.  
-						NULL,					// Effect instances aren't being used.  
-						&this->numMaterials,	// Reports number of materials in the mesh.  
-						&this->Mesh);			// Stores the mesh in this place.  
-
-	// A temporary pointer calls the pointer for the material buffer.  
-	D3DXMATERIAL* TempMaterial = (D3DXMATERIAL*) MaterialBuffer->GetBufferPointer();
-
-	// Creates a material buffer for each material in the mesh.  
-	Material = new D3DMATERIAL9[numMaterials];
-
-	// Stores the necessary colour values for each material in the mesh.  
-	for (DWORD i = 0 ; i < this->numMaterials ; i++)	// For each material...
-	{
-		// Material info is retrieved from the relevant D3D material in the temp material
-		// buffer...
-		Material[i]			= TempMaterial[i].MatD3D;
-		Material[i].Ambient = Material[i].Diffuse;	// Then the ambient is made the same 
-			// as the diffuse (a common workaround due to limitations in Direct3D to date.  
-	}
+	const MeshAsset* Loaded = Meshes.Acquire(Filename);
+	if (!Loaded)
+		return false;
+
+	if (Asset)
+		Meshes.Release(Asset);
+	Asset = Loaded;
+
+	this->numMaterials = Asset->numMaterials;
+
+	// Points the drawing at the cache's copy of the mesh.  
+	Drawable.Lods = Asset->Lods;
+	Drawable.Errors = Asset->Errors;
+	Drawable.numLods = Asset->numLods;
+	Drawable.Materials = Asset->Materials;
+	Drawable.numMaterials = Asset->numMaterials;
+
+	return true;
 }
 
-//	Function to change the main colour of the mesh.  The function changes the colour of
-//	the stored material, as well as the id of the colour used (this is used later for
-//	comparison operations).  
+//	Function to change the main colour of the mesh to the given palette colour.  Only
+//	the id is stored; the render queue puts the colour into every material used in the
+//	mesh as it is drawn (although all should be the same due to how the models are
+//	coded).  The id is also used later for comparison operations.  
 //////////////////////////////////////////////////////////////////////////////////////////
-void D3DMesh::ChangeColour(int id, ColourRGB* Colour)
+void D3DMesh::ChangeColour(int id)
 {
-	// Changes the colour for each material used in the mesh (although all should be the
-	// same due to how the models are coded.  
-	for (DWORD i = 0 ; i < this->numMaterials ; i++)	// For each subset in the mesh...
-	{
-		// Overwrite the RGB values of the materials with the given colour.  Alpha is
-		// intentional omitted - This is because the alpha value is already read from the
-		// mesh and it isn't desired for it to be overwritten with another value.  
-		Material[i].Diffuse.r = Colour->r;
-		Material[i].Diffuse.g = Colour->g;
-		Material[i].Diffuse.b = Colour->b;
-		Material[i].Ambient = Material[i].Diffuse;	// Makes ambient the same as diffuse
-													// (Again, the same workaround.)
-	}
-
 	this->colour = id;	// Stores the ID of the given colour in the class.  
 }
 
@@ -108,16 +98,16 @@ int D3DMesh::GetColourID()
 // only of real use in the derived classes.  
 //////////////////////////////////////////////////////////////////////////////////////////
 
-//	Function to render the mesh.  Each derived class added their own required code to just
-//	before this function (e.g. matrix uploading).
+//	Function to render the mesh.  Each derived class works out its own world matrix (e.g.
+//	its rotation) & passes it in.  The subsets are handed to the render queue rather than
+//	drawn straight away, so they are drawn once the whole scene has been sorted.  The
+//	level of detail is picked & the subsets queued by the mesh draw module, which the
+//	tools draw through as well.  
 //////////////////////////////////////////////////////////////////////////////////////////
-void D3DMesh::RenderMesh()
+void D3DMesh::RenderMesh(int pass, const Matrix& World)
 {
-	// Draws each subset of the mesh to make the full model.  
-	for (DWORD i = 0 ; i < this->numMaterials ; i++)	// For each subset in the mesh...
-	{
-		Device->SetMaterial(&Material[i]);				// Set the material as required.
+	DWORD level = MeshDraw::SelectLod(Backend, Drawable, World);	// Picks the level.  
+	int mesh = MeshDraw::Submit(Queue, pass, Drawable, level, World, NULL, colour);
 
-		Mesh->DrawSubset(i);							// Then draw the subset.  
-	}
+	Meshes.CountDrawn(level, Backend->GetFaceCount(mesh));
 }
\ No newline at end of file
@@ -16,6 +16,15 @@
 //////////////////////////////////////////////////////////////////////////////////////////
 #include "D3DRenderer.h"
 
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>			// Standard I/O library, for reading the command line.  
+#include <string.h>			// Standard string functions.  
+#include <mmsystem.h>		// Win32 multimedia library, for the system timer resolution.  
+#pragma comment(lib, "winmm.lib")
+
 //////////////////////////////////////////////////////////////////////////////////////////
 //	PUBLIC METHODS
 //	Methods called by other classes.  
@@ -24,44 +33,79 @@
 //	Class constructor.  The function retrieves handles from the main function and
 //	initialises the other Direct3D components.  
 //////////////////////////////////////////////////////////////////////////////////////////
-D3DRenderer::D3DRenderer(HINSTANCE hInstance, HWND hWnd)
+D3DRenderer::D3DRenderer(HINSTANCE hInstance, HWND hWnd, const char* CommandLine)
+: Scheduler(&SystemTime), Stepper(&SystemTime), Startup(&SystemTime), Loader(&Startup)
 {
 	// Stores handles to the application instance and window.  
 	this->hWnd		= hWnd;
 	this->hInstance = hInstance;
 
+	this->rewinding = false;			// The rewind key starts off released.  
+	this->quitting = false;				// Nothing has asked to exit yet.  
+	this->ReadCommandLine(CommandLine);	// Picks up any replay to play back.  
+
 	this->Init();	// Initialises the full Direct3D setup.  
 }
 
-//	Function to hold the main render loop.  
+//	Function to hold the main render loop.  The game is ticked on a thread of its own,
+//	which hands a snapshot of the game to this one after each pass, so a slow frame
+//	never holds up the ticks & a slow tick never holds up the frames.  Each pass of the
+//	loop handles the waiting window messages, picks up the newest snapshot, renders a
+//	frame from it and then sleeps until the next frame is due.  
 //////////////////////////////////////////////////////////////////////////////////////////
 void D3DRenderer::Render()
 {
 	MSG msg;				// Holds Win32 event messages
+	bool posted = false;	// Whether the quit message has been sent.  
 
-	Timer.SetFrameRate(120);	// Sets the frame rate to 120 frames per second.  
+	Scheduler.SetFrameRate(120);	// Sets the frame rate to 120 frames per second.  
+	Stepper.SetFrameRate(120);		// Runs the simulation in 120 passes per second...
+	Stepper.SetTickRate(120 * speed);	// at 120 ticks per second, or faster when
+										// playing back a replay.  
+
+	// Asks Windows for a 1ms timer resolution so that the schedulers' sleeps wake up
+	// close to when they were asked to.  
+	timeBeginPeriod(1);
+
+	Scheduler.Reset();		// Starts timing from now.  
+	Simulator = std::thread(&D3DRenderer::Simulate, this);	// Starts ticking the game.  
 
 	while (true)			// Until however long the game runs for...
 	{
-		// If the timer dictates it's time for another frame...
-		if (Timer.NextFrame())
+		// Handles every message waiting in the queue.  
+		while (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
 		{
-			Timer.Reset();	// Reset the timer.  
-
-			// Check to see if any messages are waiting in the queue
-			if (PeekMessage(&msg, NULL, 0, 0, PM_REMOVE))
+			// If the message is for a quit, stop the simulation & exit the loop
+			if (msg.message == WM_QUIT)
 			{
-				// If the message is for a quit, exit the while loop
-				if (msg.message == WM_QUIT)
-					return;
-
-				// Otherwise, translate the message and dispatch it to the message handler()
-				TranslateMessage(&msg);
-				DispatchMessage(&msg);
+				this->quitting = true;
+				Simulator.join();	// Waits for the tick in progress to finish.  
+				Recorder.Close();	// Finishes off the recording of the session.  
+				timeEndPeriod(1);
+				return;
 			}
 
-			this->RenderFrame();		// Renders a frame of the game.  
+			// Otherwise, translate the message and dispatch it to the message handler()
+			TranslateMessage(&msg);
+			DispatchMessage(&msg);
+		}
+
+		// If either thread has asked to exit, the quit message is sent from here, as it
+		// has to come from the thread owning the window.  
+		if (this->quitting && !posted)
+		{
+			PostQuitMessage(0);
+			posted = true;
 		}
+
+		// The ticks the scheduler hands out are left to the simulation thread; only its
+		// frame pacing is used here.  
+		Scheduler.BeginFrame();
+
+		Frames->Acquire();			// Picks up the newest snapshot, if there is one.  
+		this->RenderFrame(Frames->GetReadSlot());	// Renders a frame of the game.  
+
+		Scheduler.EndFrame();		// Waits until the next frame is due.  
 	}
 }
 
@@ -70,133 +114,358 @@ void D3DRenderer::Render()
 //	Methods called from within the class for better organisation of the module.  
 //////////////////////////////////////////////////////////////////////////////////////////
 
-//	Function to organise the main initialisation of the game.  
+//	Function to organise the main initialisation of the game.  Each part is timed for
+//	the startup report.  
 //////////////////////////////////////////////////////////////////////////////////////////
 void D3DRenderer::Init()
 {
+	Startup.Start();			// Times startup from here.  
+
+	// Starts reading the models on worker threads, as they need nothing from Direct3D
+	// until they are turned into meshes.  
+	Loader.Request(BLOCK_MODEL);
+	Loader.Request(BALL_MODEL);
+
 	// Runs the main initialisation from the Direct3D settings class.  If there are any 
 	// problems reported, the application exits.  
+	int span = Startup.Begin("Device setup");
 	if (!Setup.Initialise(this->hInstance, this->hWnd))
 		this->Exit();
+	Startup.End(span);
 
 	// Assuming everything went well though, handles to the Direct3D interface & device are
 	// acquired.  
 	this->d3d = Setup.GetInterface();
 	this->Device = Setup.GetDevice();
 
+	// Everything but the text is drawn through the render backend, which the mesh cache
+	// makes its meshes in.  Each frame is recorded into a command buffer first & handed
+	// to the backend in one go, through a state cache that drops anything set again to
+	// what it already is.  
+	this->Backend = new D3D9Backend(this->Device);
+	this->Tracker = new StateCache(this->Backend);
+	this->Commands = new CommandBuffer(this->Tracker);
+	Cache.SetBackend(this->Commands);
+
+	this->SetUpCamera();		// Works out the view & projection matrices.  
+
+	span = Startup.Begin("Lighting");
 	this->SetUpLighting();		// Sets up lighting.  
+	Startup.End(span);
+
+	// Waits for the models still being read & hands each to the mesh cache, so that the
+	// game logic finds them there.  
+	span = Startup.Begin("Wait for meshes");
+	Loader.Finish(&D3DRenderer::PublishMesh, &Cache);
+	Startup.End(span);
+
+	// Creates the game logic module.  If a replay was asked for, the game is started from
+	// the replay's seed; otherwise it is seeded from the present time & recorded.  
+	span = Startup.Begin("Game logic");
+	if (replay[0] && Player.Open(replay))
+		Ring = new GameLogic(Player.GetStream());
+	else
+	{
+		replay[0] = '\0';
+		speed = 1;
+
+		unsigned long long seed = GetTickCount();
+		Ring = new GameLogic(RandomStream(seed));
+		Recorder.Open(REPLAY_FILE, seed, 0, Simulation::Defaults());
+	}
+	Startup.End(span);
 
-	Ring = new GameLogic();		// Creates the game logic module.  
+	// Hands the render thread the starting state, so it has something to draw before
+	// the simulation thread's first pass.  
+	FrameSnapshot First;
+	First.State		= Ring->GetState();
+	First.idle		= 0.0f;
+	First.jitter	= 0.0f;
+	First.work		= 0.0f;
+	this->Frames = new TripleBuffer<FrameSnapshot>(First);
+
+#ifdef _DEBUG
+	Cache.Report();				// Lists the meshes loaded to the debugger.  
+#endif
 
 	// Creates the initialisation of the font device.  If there are any problems reported, 
-	// the application exits.  
+	// the application exits.  The font is made here rather than on a worker thread, as
+	// the device isn't made to be used from more than one thread.  
+	span = Startup.Begin("Font");
 	if (!GUI.CreateFont())
 		this->Exit();
+	Startup.End(span);
+
+	firstFrame = Startup.Begin("First frame");
+}
+
+//	Function to list the time taken by each part of starting up to the debugger's output,
+//	followed by the time taken to the first frame.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void D3DRenderer::ReportStartup()
+{
+	char Line[128];
+
+	OutputDebugString("   Start      End   Length  Thread  Part\n");
+	for (int i = 0 ; i < Startup.GetSpanCount() ; i++)
+	{
+		Startup.Format(i, Line, sizeof(Line));
+		OutputDebugString(Line);
+	}
+
+	snprintf(Line, sizeof(Line), "Time to first frame: %.2fms\n",
+			Startup.GetLength() / (double)NS_PER_MS);
+	OutputDebugString(Line);
+}
+
+//	Function called as each model read at startup finishes, to hand its mesh to the
+//	cache.  A model that couldn't be read is left for the cache to try again, so the
+//	user is told why when the game asks for it.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void D3DRenderer::PublishMesh(const char* path, const MeshView* Mesh, const char* error,
+							  void* context)
+{
+	if (Mesh)
+		((MeshCache*)context)->Publish(path, *Mesh);
+}
+
+//	Function to read the options the game was launched with.  "-play <file>" plays
+//	back a recorded session instead of a live one, and "-speed <n>" plays it back that
+//	many times faster than normal.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void D3DRenderer::ReadCommandLine(const char* CommandLine)
+{
+	replay[0] = '\0';
+	speed = 1;
+
+	if (!CommandLine)
+		return;
+
+	const char* Play = strstr(CommandLine, "-play ");
+	if (Play)
+		sscanf(Play + 6, "%259s", replay);
+
+	const char* Speed = strstr(CommandLine, "-speed ");
+	if (Speed)
+		sscanf(Speed + 7, "%d", &speed);
+
+	// Keeps the speed within what the scheduler can catch up on each frame.  
+	if (speed < 1)
+		speed = 1;
+	if (speed > MAX_PLAY_SPEED)
+		speed = MAX_PLAY_SPEED;
 }
 
 //	Function to set up lighting.  
 //////////////////////////////////////////////////////////////////////////////////////////
 void D3DRenderer::SetUpLighting()
 {
-	D3DLIGHT9 Light;						// A struct for a Direct3D light.  
-
-	// Assigns & clears memory for the light.  
-    ZeroMemory(&Light, sizeof(Light));
+	RenderLight Light;						// A struct for a point light.  
 
 	// Makes a point light of medium grey colour, and a range of 10.0f with a inverse
 	// attenuation of 0.5.  
-    Light.Type			= D3DLIGHT_POINT;
-    Light.Diffuse.r		= 0.5f;
-    Light.Diffuse.g		= 0.5f;
-    Light.Diffuse.b		= 0.5f;
-	Light.Range			= 10.0f;
-    Light.Attenuation0	= 0.5f;
-    Light.Attenuation1	= 0.0f;
-	Light.Attenuation2	= 0.0f;
+	RenderColour Grey = { 0.5f, 0.5f, 0.5f, 0.0f };
+	Light.Diffuse			= Grey;
+	Light.range				= 10.0f;
+	Light.attenuation[0]	= 0.5f;
+	Light.attenuation[1]	= 0.0f;
+	Light.attenuation[2]	= 0.0f;
 
 	// Sets the position of the light at (0, 5, 0).
-    D3DVECTOR vecPosition = {0.0f, 5.0f, 0.0f};
-    Light.Position = vecPosition;
-	
-	// Sets the light to #0 and activates it.  
-	Device->SetLight(0, &Light);
-    Device->LightEnable(0, true);
+	Light.position[0]		= 0.0f;
+	Light.position[1]		= 5.0f;
+	Light.position[2]		= 0.0f;
+
+	// Sets the light & activates it.  
+	Tracker->SetLight(Light);
 }
 
-//	Function to render a frame.  
+//	Function to work out the viewpoint & projection matrices.  The camera never moves,
+//	so they are worked out once here rather than for every frame.  
 //////////////////////////////////////////////////////////////////////////////////////////
-void D3DRenderer::RenderFrame()
+void D3DRenderer::SetUpCamera()
 {
+	Vector3 Eye(0.0f, 1.0f, -5.0f);		// The camera's position.
+	Vector3 At(0.0f, 0.0f,  0.0f);		// The camera's focal point.
+	Vector3 Up(0.0f, 1.0f,  0.0f);		// The camera's up vector.  
+
+	// Sets the viewpoint matrix with the above.  
+	this->Viewpoint = Matrix::LookAtLH(Eye, At, Up);
+
+	// Sets the projection matrix with...
+	this->Projection = Matrix::PerspectiveFovLH(
+								75.0f * PI / 180.0f,	// FOV of 75 degrees
+								Setup.GetAspectRatio(),	// The aspect ratio
+								1.0f,					// The near view-plane
+								10.0f);					// The far view-plane
+}
+
+//	Function to hold the main loop of the simulation thread.  Each pass runs however many
+//	game ticks the scheduler says are due, hands the state they leave the game in to
+//	the render thread and then sleeps until the next pass is due.  The loop ends as soon
+//	as either thread asks for the game to exit.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void D3DRenderer::Simulate()
+{
+	Stepper.Reset();		// Starts timing from now.  
+
+	while (!this->quitting)
+	{
+		// Runs each of the game ticks that are due this pass.  
+		int ticks = Stepper.BeginFrame();
+		for (int i = 0 ; (i < ticks) && !this->quitting ; i++)
+			this->Tick();
+
+		this->Publish();			// Hands the new state to the render thread.  
+
+		Stepper.EndFrame();			// Waits until the next pass is due.  
+	}
+}
+
+//	Function to hand a snapshot of the game to the render thread, along with this
+//	thread's timings.  The snapshot is written into a slot only this thread can see,
+//	so the render thread is never kept waiting.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void D3DRenderer::Publish()
+{
+	FrameSnapshot& Snapshot = Frames->GetWriteSlot();
+
+	Snapshot.State	= Ring->GetState();
+	Snapshot.idle	= Stepper.GetIdlePercent();
+	Snapshot.jitter	= Stepper.GetJitter();
+	Snapshot.work	= Stepper.GetWorkTime();
+
+	Frames->Publish();
+}
+
+//	Function to run a single tick of the game.  Input is read once per tick so that the
+//	ring turns at the same speed whatever the frame rate.  A live game records each
+//	tick's input, while a replay takes its input from the recording instead.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void D3DRenderer::Tick()
+{
+	TickInput Input;		// The input for the tick.  
+
+	// Checks for input from the keyboard & mouse.  
+	this->CheckKeyInput(Input);
+	this->CheckMouseInput(Input);
+
+	// While the rewind key is held, the game runs backwards through its history instead.
+	// A recording can only follow one line of play, so it's finished off at the first
+	// rewind.  
+	if (rewinding)
+	{
+		Ring->Rewind();
+		Recorder.Close();
+		return;
+	}
+
+	Ring->Save();			// Stores the tick's starting state for rewinding.  
+
+	if (replay[0])			// If playing back, the recording replaces the input.  
+	{
+		// Picks the recording up again from wherever a rewind left the game.  
+		int tick = Ring->GetState().ticks;
+		if (Player.GetTick() != tick)
+			Player.MoveTo(tick);
+
+		if (!Player.Next(Input))
+		{
+			this->Exit();
+			return;
+		}
+	}
+	else
+		Recorder.Record(Ring->GetState(), Input);
+
+	Ring->Apply(Input);		// Turns the ring.  
+
+	// Advances the game by a tick.  If reported to do so, exit from the game.  
+	if (!Ring->Update())
+		this->Exit();
+}
+
+//	Function to render a frame of the game as it stood in a snapshot.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void D3DRenderer::RenderFrame(const FrameSnapshot& Snapshot)
+{
+	// Keeps the state cache's counts from the last frame for the GUI.  
+	int issued = Tracker->GetIssued(CACHE_KINDS);
+	int elided = Tracker->GetElided(CACHE_KINDS);
+	Tracker->ResetCounts();
+
 	this->ClearBuffers();	// Clears the buffers.  
 
-	Device->BeginScene();	// Starts rendering the 3D scene.  
+	Commands->BeginScene();	// Starts rendering the 3D scene.  
 
 		this->SetView();		// Sets the viewpoint matrix.  
 		this->SetProjection();	// Sets the projection matrix.  
 
-		// Renders the scene via the game logic system.  If reported to do so, exit from
-		// the game.  
-		if (!Ring->Render())
-			this->Exit();
+		Ring->Render(Snapshot.State);	// Queues the scene via the game logic system.  
+		Drawing.Flush(Commands);	// Sorts the scene's draws & records them.  
 
-		// Renders the score onto the screen.  
-		GUI.RenderScore(Ring->GetLevel(), Ring->GetScore());
+		// Hands the scene to Direct3D, as the text is drawn straight to the device over
+		// the top of it.  
+		Commands->Submit();
 
-	Device->EndScene();		// Ends rendering the 3D scene.  
+		// Renders the score, both threads' timings, this frame's draws & last frame's
+		// triangles onto the screen.  
+		int Faces[MESH_MAX_LODS];
+		for (int i = 0 ; i < MESH_MAX_LODS ; i++)
+			Faces[i] = Cache.GetDrawnFaces(i);
 
-	Device->Present(NULL, NULL, NULL, NULL);    // Displays the created frame.
+		GUI.RenderScore(Snapshot.State.level, Snapshot.State.score);
+		GUI.RenderTiming(Scheduler.GetIdlePercent(), Scheduler.GetJitter(),
+						 Scheduler.GetWorkTime());
+		GUI.RenderTicking(Snapshot.idle, Snapshot.jitter, Snapshot.work);
+		GUI.RenderDetail(Faces, MESH_MAX_LODS);
+		GUI.RenderBatching(Drawing.GetDrawCount(), Drawing.GetBatchCount(),
+						   Drawing.GetMaterialCount(), Drawing.GetTransformCount(),
+						   issued, elided);
 
-	// Checks for input from the keyboard & mouse.  
-	this->CheckKeyInput();
-	this->CheckMouseInput();
+	Commands->EndScene();	// Ends rendering the 3D scene.  
+
+	Cache.EndFrame();		// Keeps the triangles counted this frame.  
+
+	Commands->Present();	// Displays the created frame.  
+	Commands->Submit();
+
+	if (firstFrame >= 0)	// If this was the first frame, startup is over.  
+	{
+		Startup.End(firstFrame);
+		firstFrame = -1;
+		this->ReportStartup();
+	}
 }
 
 //	Function to clear the buffers to specific colours.  
 //////////////////////////////////////////////////////////////////////////////////////////
 void D3DRenderer::ClearBuffers()
 {
-	// Clears the background, depth & stencil buffers respectively.  
-	Device->Clear(0, NULL, D3DCLEAR_TARGET, BACKGROUND, 1.0f, 0);
-	Device->Clear(0, NULL, D3DCLEAR_ZBUFFER, D3DCOLOR_XRGB(0, 0, 0), 1.0f, 0);
-	Device->Clear(0, 0, D3DCLEAR_STENCIL, 0xfffffff, 1.0f, 0);
+	// Clears the background, depth & stencil buffers all in one go.  
+	Commands->Clear(CLEAR_TARGET | CLEAR_DEPTH | CLEAR_STENCIL, BACKGROUND, 1.0f, 0);
 }
 
-//	Function to set the viewpoint matrix.  
+//	Function to set the viewpoint matrix.  It is set every frame, but as it never changes
+//	only the first is passed on to the device.  
 //////////////////////////////////////////////////////////////////////////////////////////
 void D3DRenderer::SetView()
 {
-	D3DXMATRIX Viewpoint;		// The viewpoint matrix.  
-
-	// Sets the matrix with...
-	D3DXMatrixLookAtLH(	&Viewpoint,
-						&D3DXVECTOR3 (0.0f, 1.0f, -5.0f),	// The camera's position.
-						&D3DXVECTOR3 (0.0f, 0.0f,  0.0f),	// The camera's focal point.
-						&D3DXVECTOR3 (0.0f, 1.0f,  0.0f));	// The camera's up vector.  
-
 	// Uploads the viewpoint matrix.  
-	Device->SetTransform(D3DTS_VIEW, &Viewpoint);
+	Commands->SetTransform(TRANSFORM_VIEW, this->Viewpoint);
 }
 
-//	Function to set the projection matrix.  
+//	Function to set the projection matrix, which likewise never changes.  
 //////////////////////////////////////////////////////////////////////////////////////////
 void D3DRenderer::SetProjection()
 {
-	D3DXMATRIX Projection;		// The projection matrix.  
-
-	// Sets the matrix with...
-	D3DXMatrixPerspectiveFovLH(	&Projection,
-								D3DXToRadian(75),		// FOV of 75 degrees
-								Setup.GetAspectRatio(),	// The aspect ratio
-								1.0f,					// The near view-plane
-								10.0f);					// The far view-plane
-
-	// Uploads the viewpoint matrix.  
-	Device->SetTransform(D3DTS_PROJECTION, &Projection);
+	// Uploads the projection matrix.  
+	Commands->SetTransform(TRANSFORM_PROJECTION, this->Projection);
 }
 
 //	Function to check for key input.  
 //////////////////////////////////////////////////////////////////////////////////////////
-void D3DRenderer::CheckKeyInput()
+void D3DRenderer::CheckKeyInput(TickInput& Input)
 {
 	// Gets a pointer to the keyboard device.  
 	IDirectInputDevice8* Keyboard = Setup.GetKeyboard();
@@ -208,10 +477,13 @@ void D3DRenderer::CheckKeyInput()
 	Keyboard->GetDeviceState(256, (LPVOID)KeyState);
 
 	// If left or right arrow keys are pressed, move the ring.  
+	Input.keys = 0;
 	if (KEY_PRESSED(DIK_LEFT) || KEY_PRESSED(DIK_A))
-		Ring->Rotate(-0.05f);
+		Input.keys |= INPUT_LEFT;
 	if (KEY_PRESSED(DIK_RIGHT) || KEY_PRESSED(DIK_D))
-		Ring->Rotate( 0.05f);
+		Input.keys |= INPUT_RIGHT;
+	// Holding backspace rewinds the game.  
+	rewinding = (KEY_PRESSED(DIK_BACK) != 0);
 	// Otherwise, exit is Escape key is pressed.  
 	if (KEY_PRESSED(DIK_ESCAPE))
 		this->Exit();
@@ -219,7 +491,7 @@ void D3DRenderer::CheckKeyInput()
 
 //	Function to check for mouse movement & input.  
 //////////////////////////////////////////////////////////////////////////////////////////
-void D3DRenderer::CheckMouseInput()
+void D3DRenderer::CheckMouseInput(TickInput& Input)
 {
 	// Gets a pointer to the mouse device.  
 	IDirectInputDevice8* Mouse = Setup.GetMouse();
@@ -231,13 +503,14 @@ void D3DRenderer::CheckMouseInput()
 	Mouse->GetDeviceState(sizeof(DIMOUSESTATE), (LPVOID)&mousestate);
 
 	// Rotates the ring based on how much the mouse has moved since the last frame.  
-	Ring->Rotate(0.01f * mousestate.lX);
+	Input.mouse = mousestate.lX;
 }
 
-//	Function to exit the application.  
+//	Function to exit the application.  It can be called from either thread, so it only
+//	raises a flag: the simulation thread stops at the end of the tick it is on, and the
+//	render thread sends the message to the Win32 handler to exit.  
 //////////////////////////////////////////////////////////////////////////////////////////
 void D3DRenderer::Exit()
 {
-	// Sends the message to the Win32 handler to exit.
-	PostQuitMessage(0);
+	this->quitting = true;
 }
\ No newline at end of file
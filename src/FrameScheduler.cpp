@@ -0,0 +1,240 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	FRAME SCHEDULER MODULE																//
+//	Class used for pacing a thread's main loop.  The scheduler hands out fixed-length	//
+//	simulation ticks from an accumulator and waits out the rest of each frame by		//
+//	sleeping, only spinning for the last fraction of a millisecond to hit the target	//
+//	cadence accurately.  It also keeps track of how idle the CPU was, how long each		//
+//	frame spent working and how far each frame strayed from the target length.  Each	//
+//	thread paced needs a scheduler of its own.											//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "FrameScheduler.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Class constructor.  The scheduler defaults to 60 frames & ticks per second until it
+//	is told otherwise.  
+//////////////////////////////////////////////////////////////////////////////////////////
+FrameScheduler::FrameScheduler(Clock* Time)
+{
+	this->Time = Time;
+
+	this->SetFrameRate(60);
+	this->SetTickRate(60);
+	this->SetJitterBound(DEFAULT_JITTER_BOUND);
+
+	this->idle_percent	= 0.0f;
+	this->jitter		= 0.0f;
+	this->max_jitter	= 0.0f;
+	this->work_time		= 0.0f;
+	this->max_work_time	= 0.0f;
+
+	this->Reset();
+}
+
+//	Function to set how many frames are rendered per second.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void FrameScheduler::SetFrameRate(int fps)
+{
+	this->frame_time = NS_PER_SECOND / fps;
+}
+
+//	Function to set how many simulation ticks are run per second.  This is kept apart
+//	from the frame rate so the game plays at the same speed however fast it is drawn.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void FrameScheduler::SetTickRate(int tps)
+{
+	this->tick_time = NS_PER_SECOND / tps;
+}
+
+//	Function to set how long before each deadline the scheduler stops sleeping & starts
+//	spinning.  This should be a little over the worst oversleep of the system's timer;
+//	a larger bound trades idle time for a tighter cadence.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void FrameScheduler::SetJitterBound(long long ns)
+{
+	this->jitter_bound = ns;
+}
+
+//	Function to restart the scheduler's timing from the present moment.  Any time that
+//	was waiting to be handed out as ticks is thrown away.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void FrameScheduler::Reset()
+{
+	this->frame_start	= Time->Now();
+	this->deadline		= this->frame_start + this->frame_time;
+	this->accumulator	= 0;
+	this->slept			= 0;
+	this->busy			= 0;
+	this->timing		= false;
+
+	this->frames		= 0;
+	this->elapsed		= 0;
+	this->asleep		= 0;
+	this->error			= 0;
+	this->worst			= 0;
+	this->working		= 0;
+	this->worst_work	= 0;
+}
+
+//	Function to start a frame.  The time since the last frame is added to the
+//	accumulator, and as many whole ticks as fit in it are handed out to be simulated.  
+//	If the game has fallen far behind, the backlog is dropped rather than trying to
+//	catch up on it all at once.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int FrameScheduler::BeginFrame()
+{
+	long long now = Time->Now();
+	long long length = now - this->frame_start;		// Length of the frame just gone.  
+
+	// Counts the frame just gone, unless this is the first since the scheduler was reset
+	// & there isn't one.  
+	if (this->timing)
+		this->Record(length, this->slept, this->busy);
+	this->timing = true;
+	this->frame_start = now;
+
+	// Hands out each whole tick that has built up.  
+	this->accumulator += length;
+	int ticks = (int)(this->accumulator / this->tick_time);
+
+	if (ticks > MAX_TICKS_PER_FRAME)	// If too many ticks are waiting...  
+	{
+		ticks = MAX_TICKS_PER_FRAME;	// Only run the most that are allowed...  
+		this->accumulator = 0;			// And forget about the rest.  
+	}
+	else
+		this->accumulator -= ticks * this->tick_time;
+
+	return ticks;
+}
+
+//	Function to wait until the next frame is due.  The thread sleeps for as much of the
+//	wait as it safely can, and spins on the clock for whatever is left inside the
+//	jitter bound.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void FrameScheduler::EndFrame()
+{
+	long long now = Time->Now();
+
+	this->busy = now - this->frame_start;	// Everything up to here was the frame's work.  
+	this->slept = 0;
+
+	// Sleeps through the bulk of the wait if there is enough of it.  
+	if ((this->deadline - now) > this->jitter_bound)
+	{
+		Time->Sleep(this->deadline - now - this->jitter_bound);
+
+		long long woken = Time->Now();
+		this->slept = woken - now;
+		now = woken;
+	}
+
+	// Spins out the remainder of the wait.  
+	while (now < this->deadline)
+	{
+		Time->Pause();
+		now = Time->Now();
+	}
+
+	// Moves the deadline on by a frame.  Deadlines are kept on a fixed grid so small
+	// errors don't build up, unless the frame overran by so much that the grid has to be
+	// restarted from now.  
+	if ((now - this->deadline) > this->frame_time)
+		this->deadline = now;
+	this->deadline += this->frame_time;
+}
+
+//	Function to report the share of time spent asleep over the last second.  
+//////////////////////////////////////////////////////////////////////////////////////////
+float FrameScheduler::GetIdlePercent()
+{
+	return this->idle_percent;
+}
+
+//	Function to report the average error in frame length over the last second.  
+//////////////////////////////////////////////////////////////////////////////////////////
+float FrameScheduler::GetJitter()
+{
+	return this->jitter;
+}
+
+//	Function to report the worst error in frame length over the last second.  
+//////////////////////////////////////////////////////////////////////////////////////////
+float FrameScheduler::GetMaxJitter()
+{
+	return this->max_jitter;
+}
+
+//	Function to report the average time each frame spent working, rather than waiting,
+//	over the last second.  
+//////////////////////////////////////////////////////////////////////////////////////////
+float FrameScheduler::GetWorkTime()
+{
+	return this->work_time;
+}
+
+//	Function to report the longest time a frame spent working over the last second.  
+//////////////////////////////////////////////////////////////////////////////////////////
+float FrameScheduler::GetMaxWorkTime()
+{
+	return this->max_work_time;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PRIVATE METHODS
+//	Methods called from within the class for better organisation of the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to add a finished frame to the statistics.  Once a full second of frames
+//	has been counted, the reported statistics are updated & the totals start again.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void FrameScheduler::Record(long long frameLength, long long slept, long long busy)
+{
+	// Works out how far the frame was from the intended length.  
+	long long miss = frameLength - this->frame_time;
+	if (miss < 0)
+		miss = -miss;
+
+	this->frames++;
+	this->elapsed	+= frameLength;
+	this->asleep	+= slept;
+	this->error		+= miss;
+	if (miss > this->worst)
+		this->worst = miss;
+	this->working	+= busy;
+	if (busy > this->worst_work)
+		this->worst_work = busy;
+
+	// If a full second has been counted, publish the results.  
+	if (this->elapsed >= NS_PER_SECOND)
+	{
+		this->idle_percent	= (100.0f * this->asleep) / this->elapsed;
+		this->jitter		= (float)this->error / (this->frames * NS_PER_MS);
+		this->max_jitter	= (float)this->worst / NS_PER_MS;
+		this->work_time		= (float)this->working / (this->frames * NS_PER_MS);
+		this->max_work_time	= (float)this->worst_work / NS_PER_MS;
+
+		this->frames		= 0;
+		this->elapsed		= 0;
+		this->asleep		= 0;
+		this->error			= 0;
+		this->worst			= 0;
+		this->working		= 0;
+		this->worst_work	= 0;
+	}
+}
\ No newline at end of file
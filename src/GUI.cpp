@@ -36,6 +36,26 @@ GUISystem::GUISystem()
 	// right corner of the screen below the level text box , and writes right-aligned 
 	// white text.  
 	Score = new TextBox(0, 1270, 40, 64, DT_RIGHT, D3DCOLOR_COLORVALUE(1.0f, 1.0f, 1.0f, 1.0f));
+
+	// Creates a text box to render the frame timings.  The box is placed in the lower-
+	// left corner of the screen, and writes left-aligned grey text.  
+	Timing = new TextBox(10, 600, 1020, 1044, 
+						DT_LEFT, D3DCOLOR_COLORVALUE(0.5f, 0.5f, 0.5f, 1.0f));
+
+	// Creates a text box to render the triangles drawn.  The box is placed just above the
+	// frame timings, and writes left-aligned grey text.  
+	Detail = new TextBox(10, 600, 990, 1014, 
+						DT_LEFT, D3DCOLOR_COLORVALUE(0.5f, 0.5f, 0.5f, 1.0f));
+
+	// Creates a text box to render the draws made.  The box is placed just above the
+	// triangles drawn, and writes left-aligned grey text.  
+	Batching = new TextBox(10, 600, 960, 984, 
+						DT_LEFT, D3DCOLOR_COLORVALUE(0.5f, 0.5f, 0.5f, 1.0f));
+
+	// Creates a text box to render the simulation thread's timings.  The box is placed
+	// just above the draws made, and writes left-aligned grey text.  
+	Ticking = new TextBox(10, 600, 930, 954, 
+						DT_LEFT, D3DCOLOR_COLORVALUE(0.5f, 0.5f, 0.5f, 1.0f));
 }
 
 //	Function to create the font device for the GUI.  
@@ -83,4 +103,56 @@ void GUISystem::RenderScore(int level, int score)
 
 	// Renders the current progress to its assigned text box.  
 	Score->Render(this->Font, string);
+}
+
+//	Function to render the render thread's frame timing statistics to the screen.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void GUISystem::RenderTiming(float idle, float jitter, float work)
+{
+	char string[64];			// Temporary string for converting the values to a string.  
+	sprintf(string, "Draw %.0f%% idle / %.2fms jitter / %.2fms work", idle, jitter, work);
+
+	// Renders the timings to their assigned text box.  
+	Timing->Render(this->Font, string);
+}
+
+//	Function to render the simulation thread's timing statistics to the screen.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void GUISystem::RenderTicking(float idle, float jitter, float work)
+{
+	char string[64];			// Temporary string for converting the values to a string.  
+	sprintf(string, "Sim %.0f%% idle / %.2fms jitter / %.2fms work", idle, jitter, work);
+
+	// Renders the timings to their assigned text box.  
+	Ticking->Render(this->Font, string);
+}
+
+//	Function to render the triangles drawn from each level of detail in the last frame,
+//	from the full meshes down to the coarsest.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void GUISystem::RenderDetail(const int* Faces, int levels)
+{
+	char string[64];			// Temporary string for converting the values to a string.  
+	int length = sprintf(string, "LOD tris");
+
+	for (int i = 0 ; i < levels ; i++)
+		length += sprintf(string + length, "%s%d", i ? " / " : " ", Faces[i]);
+
+	// Renders the counts to their assigned text box.  
+	Detail->Render(this->Font, string);
+}
+
+//	Function to render the draws made by the render queue this frame & the batches they
+//	fell into, along with the materials & world matrices it had to set for them, and how
+//	many of last frame's settings the state cache found unchanged & dropped.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void GUISystem::RenderBatching(int draws, int batches, int materials, int transforms,
+							   int issued, int elided)
+{
+	char string[128];			// Temporary string for converting the values to a string.  
+	sprintf(string, "%d draws / %d batches / %d materials / %d matrices / %d of %d sets dropped",
+			draws, batches, materials, transforms, elided, issued + elided);
+
+	// Renders the counts to their assigned text box.  
+	Batching->Render(this->Font, string);
 }
\ No newline at end of file
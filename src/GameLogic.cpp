@@ -25,7 +25,8 @@
 //	Class constructor.  When initialised, the models are created and the values are
 //	set to default.  
 //////////////////////////////////////////////////////////////////////////////////////////
-GameLogic::GameLogic()
+GameLogic::GameLogic(const RandomStream& Random)
+: Sim(Random)
 {
 	// Create each block and set their position around the ring as every 60 degrees.  
 	for (int i = 0 ; i < NUM_BLOCKS ; i++)
@@ -34,6 +35,19 @@ GameLogic::GameLogic()
 	// Creates the ball.  
 	Ball = new BallMesh();
 
+	// Builds the scene, with each block hung off the ring at its fixed place along it so
+	// that turning the ring only changes the one node above them.  
+	this->placedAngle = Sim.GetState().x;
+	this->placedHeight = Sim.GetState().y;
+	ringNode = Scene.AddNode(SCENE_ROOT, Matrix::RotationY(this->placedAngle));
+	for (int i = 0 ; i < NUM_BLOCKS ; i++)
+	{
+		float displacement = Block[i]->GetDisplacement();
+		blockNode[i] = Scene.AddNode(ringNode, Matrix::RotationY(-displacement));
+	}
+	ballNode = Scene.AddNode(SCENE_ROOT,
+							 Matrix::Translation(0.0f, this->placedHeight, BALL_Z));
+
 	// Creates each of the six colours used in the game.  
 	Colour[0] = new ColourRGB(1.0f, 0.0f, 0.0f);	// Red
 	Colour[1] = new ColourRGB(1.0f, 1.0f, 0.0f);	// Yellow
@@ -42,79 +56,120 @@ GameLogic::GameLogic()
 	Colour[4] = new ColourRGB(0.0f, 0.0f, 1.0f);	// Blue
 	Colour[5] = new ColourRGB(1.0f, 0.0f, 1.0f);	// Magenta
 
-	this->x	= 0.0f;		// Rotation displacement is 0. 
-	this->score = 0;	// Score at start is 0.
-	this->level = 1;	// Level at start is 1.  
+	// Hands the colours to the render queue, which draws each mesh in its colour.  
+	for (int i = 0 ; i < NUM_COLOURS ; i++)
+		Queue.SetColour(i, *Colour[i]);
 
 	this->Load();			// Loads the meshes into the models.  
-	this->ChangeColours();	// Sets the colours for the blocks & the ball to start off the game.  
+	this->SyncColours(Sim.GetState());	// Sets the colours for the blocks & the ball to
+										// start off the game.  
 
 	// Sets the base plane to a plane straight upwards.  
-	BasePlane = D3DXPLANE(0.0f, 1.0f, 0.0f, 1.0f);
+	BasePlane = Plane(0.0f, 1.0f, 0.0f, 1.0f);
 
 	// Sets the shadow material to black with half alpha.  
-	BlackMatter.Diffuse  = D3DXCOLOR(0.0f, 0.0f, 0.0f, 0.5f);
-	BlackMatter.Ambient  = D3DXCOLOR(0.0f, 0.0f, 0.0f, 1.0f);
-	BlackMatter.Specular = D3DXCOLOR(0.0f, 0.0f, 0.0f, 1.0f);
-	BlackMatter.Emissive = D3DXCOLOR(0.0f, 0.0f, 0.0f, 1.0f);
+	RenderColour Shade = { 0.0f, 0.0f, 0.0f, 0.5f };
+	RenderColour Black = { 0.0f, 0.0f, 0.0f, 1.0f };
+	BlackMatter.Diffuse  = Shade;
+	BlackMatter.Ambient  = Black;
+	BlackMatter.Specular = Black;
+	BlackMatter.Emissive = Black;
+	BlackMatter.power	 = 0.0f;
 }
 
-//	Function to render each of the models, as well as comparisons as to whether special
-//	actions should be created for the frame.  
+//	Function to advance the game by one tick.  The rules themselves are run by the
+//	simulation, & the meshes only catch up with them when a state is rendered.  Returns
+//	false once the ball has fallen through the ring.  
 //////////////////////////////////////////////////////////////////////////////////////////
-bool GameLogic::Render()
+bool GameLogic::Update()
 {
+	return Sim.Tick();		// Runs the game's rules for the tick.  
+}
+
+//	Function to render each of the models at the positions & colours given by a state of
+//	the simulation.  Only the state given is read, never the simulation itself, so this
+//	can run on another thread from the one ticking the game.  The models are only queued
+//	here; the render queue draws them in order of their passes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void GameLogic::Render(const SimState& State)
+{
+	this->SyncColours(State);	// Picks up any colours changed by a bounce or a rewind.  
+	this->Place(State);			// Works out the world matrices of anything that moved.  
+
 	// First stage - Render the ring.  
 	for (int i = 0 ; i < NUM_BLOCKS ; i++)	// For each block in the ring...
-	{
-		Block[i]->RotationY(this->x);	// Set the world matrix to the relevant rotation.  
-		Block[i]->Render();				// Renders the block.  
-	}
+		Block[i]->Render(Scene.GetWorld(blockNode[i]));
 
 	// Second stage - Render the shadow.  
-	this->DrawShadow();
+	this->DrawShadow(State.y);
 
 	// Third stage - Render the ball.  
-	Ball->Render();
-	
-	// Checks whether specific actions need to be taken.  
-	if (Ball->Bounced())	// If the ball touches the ring...
-	{
-		// And the colour of the block below the ball matches the colour of the ball...
-		if (Ball->GetColourID() == Block[this->GetBlockBelow()]->GetColourID())
-		{
-			this->ChangeColours();	// Change the colours of the ring blocks & the ball.  
-			Ball->Bounce();			// Bounces the ball.  
-			this->IncreaseScore();	// Increases the score by 1.  
-		}
-		// Otherwise, the ball falls through the ring to a game over.  
-	}
-
-	if (Ball->Fallen())	// If the ball is acknowledged as fully fell through the ring...
-		return false;	// Report it to the renderer.  
-
-	return true;		// Otherwise, report to the renderer that everything is fine.  
+	Ball->Render(Scene.GetWorld(ballNode));
 }
 
 //	Function to rotate the ring based on the given x value.  
 //////////////////////////////////////////////////////////////////////////////////////////
 void GameLogic::Rotate(float x)
 {
-	this->x -= x;
+	Sim.Rotate(x);
+}
+
+//	Function to rotate the ring by a tick's worth of player input.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void GameLogic::Apply(const TickInput& Input)
+{
+	Sim.Apply(Input);
+}
+
+//	Function to store the state at the start of a tick in the history.  The whole game
+//	is decided by the simulation's state, with the meshes only following it, so a copy
+//	of that state is all it takes to come back to this tick later.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void GameLogic::Save()
+{
+	History.Push(Sim.GetState());
+}
+
+//	Function to go back to the last tick stored in the history.  Returns false once
+//	the history has run out.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool GameLogic::Rewind()
+{
+	SimState State;
+
+	if (!History.Pop(State))
+		return false;
+
+	this->Restore(State);
+	return true;
+}
+
+//	Function to carry the game on from the given state.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void GameLogic::Restore(const SimState& State)
+{
+	Sim.Restore(State);
+}
+
+//	Function to report the full state of the game, for recording.  
+//////////////////////////////////////////////////////////////////////////////////////////
+const SimState& GameLogic::GetState()
+{
+	return Sim.GetState();
 }
 
 //	Function to report the level attained for the current game.  
 //////////////////////////////////////////////////////////////////////////////////////////
 int GameLogic::GetLevel()
 {
-	return this->level;
+	return Sim.GetLevel();
 }
 
 //	Function to report the current progress to the next level.  
 //////////////////////////////////////////////////////////////////////////////////////////
 int GameLogic::GetScore()
 {
-	return this->score;
+	return Sim.GetScore();
 }
 
 //////////////////////////////////////////////////////////////////////////////////////////
@@ -129,108 +184,68 @@ void GameLogic::Load()
 	// Loads each of the models into memory.  
 	for (int i = 0 ; i < NUM_BLOCKS ; i++)	// For each block in the ring...
 	{
-		Block[i]->Load("Block.x");			// Load the relevant mesh in.  
+		Block[i]->Load(BLOCK_MODEL);			// Load the relevant mesh in.  
 	}
-	Ball->Load("Ball.x");					// Loads the required mesh for the ball.  
+	Ball->Load(BALL_MODEL);					// Loads the required mesh for the ball.  
 }
 
-//	Function to draw the shadow via the stencil buffer.  
+//	Function to move the ring & ball nodes to where a state has them & bring the
+//	scene's world matrices up to date.  A node is only given a new matrix when its value
+//	has changed since the last frame, so while the ring is still none of the blocks'
+//	matrices are worked out again.  
 //////////////////////////////////////////////////////////////////////////////////////////
-void GameLogic::DrawShadow()
+void GameLogic::Place(const SimState& State)
 {
-	// A pointer to the main Direc3D Device.  
-	IDirect3DDevice9* Device = Settings.GetDevice();
+	if (State.x != this->placedAngle)
+	{
+		this->placedAngle = State.x;
+		Scene.SetLocal(ringNode, Matrix::RotationY(State.x));
+	}
 
-	D3DXMATRIX ShadowMatrix;	// A matrix for storing the transformation data for drawing
-								// the shadow.  
+	if (State.y != this->placedHeight)
+	{
+		this->placedHeight = State.y;
+		Scene.SetLocal(ballNode, Matrix::Translation(0.0f, State.y, BALL_Z));
+	}
+
+	Scene.Update();
+}
 
-	// Calculates the light ray based on the position of the ball.  This line alone is
+//	Function to draw the shadow via the stencil buffer, for the ball at the given
+//	height.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void GameLogic::DrawShadow(float y)
+{
+	// Calculates the light ray based on the position of the ball.  These lines alone are
 	// basically a very cheap trick in getting a dynamically-sized shadow for the ball - 
 	// instead of writing a full function to make sure the shadow changed, this method
 	// simply changes the ray's y co-ord and length based on the position of the ball.  
-	this->LightRay = D3DXVECTOR4(	 0.0f,
-									(0.5f + (2 * Ball->GetY())), 
-									 BASE_Z, 
-									(1.0f - Ball->GetY()));
-
-	// Generates the plane required for the shadow rendering.  
-	D3DXMatrixShadow(&ShadowMatrix, &this->LightRay, &this->BasePlane);
-
-	// Uploads the matrix to the World matrix.  
-	Settings.GetDevice()->SetTransform(D3DTS_WORLD, &ShadowMatrix);
+	this->LightRay = Vector4(0.0f, 0.5f + (2 * y), BASE_Z, 1.0f - y);
 
-	Settings.ActiveStencilBuffer(true);		// Starts drawing to the stencil buffer.  
+	// Generates the matrix required for the shadow rendering, which flattens the ball
+	// onto the plane.  
+	Matrix ShadowMatrix = Matrix::Shadow(this->LightRay, this->BasePlane);
 
-		Device->SetMaterial(&this->BlackMatter);// Starts drawing with the shadow material.  
-		Device->SetTexture(0, 0);				// Makes sure a texture isn't used.  
-
-		Ball->RenderShadow();				// Renders the shadow to the stencil buffer.  
-
-	Settings.ActiveStencilBuffer(false);	// Stops drawing to the stencil buffer.  
+	// Renders the shadow to the stencil buffer with the shadow material.  
+	Ball->RenderShadow(ShadowMatrix, &this->BlackMatter);
 }
 
-//	Function to change the colours for the ring & ball.
+//	Function to match the colours of the ring & ball meshes to the colour IDs in a state
+//	of the simulation.  Setting a colour only stores its ID, so it's cheap enough to do
+//	for every frame.  
 //////////////////////////////////////////////////////////////////////////////////////////
-void GameLogic::ChangeColours()
+void GameLogic::SyncColours(const SimState& State)
 {
-	int newcolid;			// Saves the id of the new colour to change to.  
-	bool valid = false;		// Check that there's a block available for the player to hit
-							// on each switch.  
+	int colid;				// The id of the colour picked for each mesh.  
 
-	srand(GetTickCount());	// Seeds the random generator with the present time.  
+	// Applies the ball's colour to its mesh.  
+	colid = State.ballColour;
+	Ball->ChangeColour(colid);
 
-	// Picks a new colour at random and assigns it to the ball.  
-	newcolid = rand() % NUM_COLOURS;
-	Ball->ChangeColour(newcolid, Colour[newcolid]);
-
-	// For each block, a new colour is picked at random and assigned to it.  
+	// Applies each block's colour to its mesh.  
 	for (int i = 0 ; i < NUM_BLOCKS ; i++)
 	{
-		newcolid = rand() % 6;
-		Block[i]->ChangeColour(newcolid, Colour[newcolid]);
-
-		// If the block's new colour matches that of the ball, mark it as such.  
-		if (newcolid == Ball->GetColourID())
-			valid = true;  
+		colid = State.blockColour[i];
+		Block[i]->ChangeColour(colid);
 	}
-
-	// If, after generating each block, none of them match the same colour as the block...
-	if (!valid)
-	{
-		// A block is picked at random.  This block then takes the same colour as the ball.
-		int blockid = rand() % NUM_BLOCKS;
-		Block[blockid]->ChangeColour(Ball->GetColourID(), Colour[Ball->GetColourID()]);
-	}
-}
-
-//	Function to increase the score of the game.  
-//////////////////////////////////////////////////////////////////////////////////////////
-void GameLogic::IncreaseScore()
-{
-	this->score++;						// Increments the score by 1.  
-	if (this->score == this->level)		// If the score matches that of the level...
-	{
-		this->level++;					// Increases the attained level.  
-		this->score = 0;				// Resets the score to 0.  
-		Ball->ChangeGravity();			// Increases the gravitational pull of the ball.  
-	}
-}
-
-//	Function to find the ID of the block the ball is currently below.  
-//////////////////////////////////////////////////////////////////////////////////////////
-int GameLogic::GetBlockBelow()
-{
-	// Adds 30 degrees to the current value of the x value around the ring.  This is added
-	// as a means to standardise the value to the front of the ring (without this, it would
-	// see the block a little towards the left of the ring).  
-	float b_std = this->x + (PI / 6);
-
-	int b_id = (int)floor(b_std);		// Take the value calculated above and round it down
-										// (e.g. 3.142 -> 3).
-
-	// While the number is negative, add another full circle to make it positive.  
-	while (b_id < 0)
-		b_id += 6;
-
-	return (b_id % 6);	// Find the reminder to get the ID of the block the ball is over.  
 }
\ No newline at end of file
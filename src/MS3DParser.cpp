@@ -0,0 +1,370 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MS3D PARSER MODULE																	//
+//	Reads meshes straight from MilkShape 3D .ms3d files, so the models can be used		//
+//	without exporting them first.  The vertex, triangle, group & material chunks are	//
+//	read in place from the mapped file, and the joints & animation that follow them		//
+//	are ignored.  Meshes are converted into the same space as the exported .x files.	//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "MS3DParser.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>			// Standard I/O library, for building error messages.  
+#include <string.h>			// Standard string functions.  
+#include "MappedFile.h"		// Memory-mapped files.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	The layout of the file.  Every structure in it is packed with no padding & stored
+//	little-endian, so fields are copied out at their byte offsets rather than read
+//	through structures.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define MS3D_HEADER_SIZE	14		// "MS3D000000" & the version.  
+#define MS3D_VERSION_MIN	3		// The oldest version of the format read.  
+#define MS3D_VERSION_MAX	4		// The newest version of the format read.  
+
+#define MS3D_VERTEX_SIZE	15		// Flags, position, bone & reference count.  
+#define MS3D_VERTEX_XYZ		1		// Where the position lies in a vertex.  
+
+#define MS3D_TRIANGLE_SIZE	70		// Flags, indices, normals, s, t, smoothing & group.  
+#define MS3D_TRIANGLE_INDEX	2		// Where the three vertex indices lie.  
+#define MS3D_TRIANGLE_NORMAL	8	// Where the three corner normals lie.  
+#define MS3D_TRIANGLE_S		44		// Where the three s texture co-ordinates lie.  
+#define MS3D_TRIANGLE_T		56		// Where the three t texture co-ordinates lie.  
+#define MS3D_TRIANGLE_GROUP	69		// Where the triangle's group lies.  
+
+#define MS3D_GROUP_NAME		33		// Flags & the group's name.  
+
+#define MS3D_MATERIAL_SIZE	361		// Name, colours, shininess, mode & texture names.  
+#define MS3D_MATERIAL_DIFFUSE	48	// Where the diffuse colour lies.  
+#define MS3D_MATERIAL_SPECULAR	64	// Where the specular colour lies.  
+#define MS3D_MATERIAL_EMISSIVE	80	// Where the emissive colour lies.  
+#define MS3D_MATERIAL_POWER	96		// Where the shininess lies.  
+#define MS3D_MATERIAL_ALPHA	100		// Where the transparency lies.  
+#define MS3D_MATERIAL_TEXTURE	105	// Where the texture file name lies.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Class constructor.  
+//////////////////////////////////////////////////////////////////////////////////////////
+MS3DParser::MS3DParser()
+{
+	this->Output = NULL;
+	this->Begin = NULL;
+	this->Cursor = NULL;
+	this->End = NULL;
+	this->Positions = NULL;
+	this->Triangles = NULL;
+	this->numPositions = 0;
+	this->numTriangles = 0;
+	this->Error = NULL;
+}
+
+//	Function to map the given file into memory & parse it.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool MS3DParser::Load(const char* path, MeshData& Mesh)
+{
+	MappedFile File;
+
+	if (!File.Open(path))
+	{
+		Begin = Cursor = End = NULL;
+		Error = NULL;
+		snprintf(Message, sizeof(Message), "Unable to open %s.", path);
+		return this->Fail(Message);
+	}
+
+	return this->Parse(File.GetData(), File.GetSize(), Mesh);
+}
+
+//	Function to parse a whole file held in memory.  The vertex & triangle chunks are
+//	only noted on the way through, as a triangle's material comes from its group, which
+//	isn't known until the chunks after them have been read.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool MS3DParser::Parse(const char* Data, size_t size, MeshData& Mesh)
+{
+	Mesh.Clear();
+
+	Output = &Mesh;
+	Error = NULL;
+	Begin = Cursor = Data;
+	End = Data + size;
+
+	const char* Header = this->Take(MS3D_HEADER_SIZE);
+	if (!Header || (memcmp(Header, "MS3D000000", 10) != 0))
+		return this->Fail("Not a .ms3d file.");
+
+	int version;
+	memcpy(&version, Header + 10, sizeof(int));
+	if ((version < MS3D_VERSION_MIN) || (version > MS3D_VERSION_MAX))
+		return this->Fail("Unsupported .ms3d version.");
+
+	// Notes where the vertices & triangles lie.  
+	if (!this->ReadWord(numPositions) || !(Positions = this->Take(numPositions * MS3D_VERTEX_SIZE)))
+		return false;
+	if (!this->ReadWord(numTriangles) || !(Triangles = this->Take(numTriangles * MS3D_TRIANGLE_SIZE)))
+		return false;
+	if (numTriangles == 0)
+		return this->Fail("No triangles found.");
+
+	if (!this->ReadGroups() || !this->ReadMaterials())
+		return false;
+
+	return this->BuildMesh();
+}
+
+//	Function to describe why parsing failed.  
+//////////////////////////////////////////////////////////////////////////////////////////
+const char* MS3DParser::GetError()
+{
+	return Error ? Error : "No error.";
+}
+
+//	Function to check whether a file name is for a MilkShape file, so that callers can
+//	pick the right parser for a model.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool MS3DParser::Matches(const char* path)
+{
+	size_t length = strlen(path);
+	size_t extension = strlen(MS3D_EXTENSION);
+
+	if (length < extension)
+		return false;
+
+	// Compares the extension regardless of case.  
+	for (size_t i = 0 ; i < extension ; i++)
+	{
+		char c = path[length - extension + i];
+		if ((c >= 'A') && (c <= 'Z'))
+			c += 'a' - 'A';
+		if (c != MS3D_EXTENSION[i])
+			return false;
+	}
+
+	return true;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PRIVATE METHODS
+//	Methods called from within the class for better organisation of the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to step over a given number of bytes, reporting where they start, or NULL
+//	if the file ends first.  
+//////////////////////////////////////////////////////////////////////////////////////////
+const char* MS3DParser::Take(size_t size)
+{
+	if ((size_t)(End - Cursor) < size)
+	{
+		this->Fail("Unexpected end of file.");
+		return NULL;
+	}
+
+	const char* Start = Cursor;
+	Cursor += size;
+	return Start;
+}
+
+//	Function to read one of the 16-bit counts starting each chunk.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool MS3DParser::ReadWord(unsigned int& value)
+{
+	const char* Word = this->Take(2);
+	if (!Word)
+		return false;
+
+	value = (unsigned char)Word[0] | ((unsigned char)Word[1] << 8);
+	return true;
+}
+
+//	Function to read the groups.  Each one lists its triangles, which are already known
+//	from the triangles themselves, so only the group's material is kept.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool MS3DParser::ReadGroups()
+{
+	unsigned int groups;
+	if (!this->ReadWord(groups))
+		return false;
+
+	GroupMaterials.resize(groups);
+
+	for (unsigned int i = 0 ; i < groups ; i++)
+	{
+		unsigned int triangles;
+		const char* Material;
+
+		if (!this->Take(MS3D_GROUP_NAME) || !this->ReadWord(triangles) ||
+			!this->Take(triangles * 2) || !(Material = this->Take(1)))
+			return false;
+
+		GroupMaterials[i] = (signed char)*Material;		// -1 if the group has none.  
+	}
+
+	return true;
+}
+
+//	Function to read the materials.  MilkShape keeps the alpha of a material apart
+//	from its colours, so it is put back onto the diffuse colour as the exporter does.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool MS3DParser::ReadMaterials()
+{
+	unsigned int materials;
+	if (!this->ReadWord(materials))
+		return false;
+
+	for (unsigned int i = 0 ; i < materials ; i++)
+	{
+		const char* From = this->Take(MS3D_MATERIAL_SIZE);
+		if (!From)
+			return false;
+
+		MeshMaterial Material;
+		memcpy(Material.diffuse, From + MS3D_MATERIAL_DIFFUSE, 3 * sizeof(float));
+		memcpy(&Material.diffuse[3], From + MS3D_MATERIAL_ALPHA, sizeof(float));
+		memcpy(Material.specular, From + MS3D_MATERIAL_SPECULAR, 3 * sizeof(float));
+		memcpy(Material.emissive, From + MS3D_MATERIAL_EMISSIVE, 3 * sizeof(float));
+		memcpy(&Material.power, From + MS3D_MATERIAL_POWER, sizeof(float));
+
+		// Copies the texture name, keeping it terminated however long it was.  
+		memcpy(Material.texture, From + MS3D_MATERIAL_TEXTURE, MESH_TEXTURE_LENGTH - 1);
+		Material.texture[MESH_TEXTURE_LENGTH - 1] = '\0';
+
+		Output->Materials.push_back(Material);
+	}
+
+	return true;
+}
+
+//	Function to build the output from the triangles.  MilkShape gives each corner of a
+//	triangle its own normal & texture co-ordinates, so a vertex is made for each
+//	different combination used with a position.  Positions & normals are scaled &
+//	mirrored into the exported models' space, and the mirroring means each triangle's
+//	corners are then listed the other way round to keep it facing outwards.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool MS3DParser::BuildMesh()
+{
+	First.assign(numPositions, -1);
+	Next.clear();
+
+	Output->Vertices.reserve(numPositions);
+	Output->Indices.reserve(numTriangles * 3);
+	Output->Attributes.reserve(numTriangles);
+
+	bool needsWhite = false;			// Whether any triangle has no material.  
+	unsigned int white = (unsigned int)Output->Materials.size();
+
+	for (unsigned int t = 0 ; t < numTriangles ; t++)
+	{
+		const char* Triangle = Triangles + t * MS3D_TRIANGLE_SIZE;
+
+		unsigned short Indices[3];
+		float Normals[9], S[3], T[3];
+		memcpy(Indices, Triangle + MS3D_TRIANGLE_INDEX, sizeof(Indices));
+		memcpy(Normals, Triangle + MS3D_TRIANGLE_NORMAL, sizeof(Normals));
+		memcpy(S, Triangle + MS3D_TRIANGLE_S, sizeof(S));
+		memcpy(T, Triangle + MS3D_TRIANGLE_T, sizeof(T));
+
+		int corner[3];					// The vertex made for each corner.  
+
+		for (int i = 0 ; i < 3 ; i++)
+		{
+			unsigned int position = Indices[i];
+			if (position >= numPositions)
+			{
+				Cursor = Triangle;
+				return this->Fail("Triangle vertex out of range.");
+			}
+
+			MeshVertex New;
+			memcpy(New.position, Positions + position * MS3D_VERTEX_SIZE + MS3D_VERTEX_XYZ,
+					sizeof(New.position));
+			New.position[0] *= MS3D_SCALE;
+			New.position[1] *= MS3D_SCALE;
+			New.position[2] *= -MS3D_SCALE;
+			New.normal[0] = Normals[i * 3];
+			New.normal[1] = Normals[i * 3 + 1];
+			New.normal[2] = -Normals[i * 3 + 2];
+			New.uv[0] = S[i];
+			New.uv[1] = T[i];
+
+			// Looks for a vertex already made from the same position, normal & uv.  
+			int vertex = First[position];
+			while ((vertex >= 0) && memcmp(&Output->Vertices[vertex], &New, sizeof(MeshVertex)))
+				vertex = Next[vertex];
+
+			// Otherwise makes one, adding it to the position's chain.  
+			if (vertex < 0)
+			{
+				vertex = (int)Output->Vertices.size();
+				Output->Vertices.push_back(New);
+				Next.push_back(First[position]);
+				First[position] = vertex;
+			}
+
+			corner[i] = vertex;
+		}
+
+		Output->Indices.push_back(corner[0]);
+		Output->Indices.push_back(corner[2]);
+		Output->Indices.push_back(corner[1]);
+
+		// Takes the material from the triangle's group.  
+		unsigned int group = (unsigned char)Triangle[MS3D_TRIANGLE_GROUP];
+		int material = (group < GroupMaterials.size()) ? GroupMaterials[group] : -1;
+
+		if ((material < 0) || (material >= (int)white))
+		{
+			Output->Attributes.push_back(white);
+			needsWhite = true;
+		}
+		else
+			Output->Attributes.push_back(material);
+	}
+
+	// Triangles without a material are given a plain white one.  
+	if (needsWhite)
+	{
+		MeshMaterial White;
+		memset(&White, 0, sizeof(MeshMaterial));
+		White.diffuse[0] = White.diffuse[1] = White.diffuse[2] = White.diffuse[3] = 1.0f;
+		Output->Materials.push_back(White);
+	}
+
+	return true;
+}
+
+//	Function to record an error, along with how far into the file it was found.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool MS3DParser::Fail(const char* Problem)
+{
+	if (Error)						// Keeps the first error found.  
+		return false;
+
+	char Text[96];					// The problem, kept short enough to add the offset.  
+	snprintf(Text, sizeof(Text), "%s", Problem);
+
+	if (Begin && Cursor)
+		snprintf(Message, sizeof(Message), "%s (byte %d)", Text, (int)(Cursor - Begin));
+	else
+		snprintf(Message, sizeof(Message), "%s", Text);
+
+	Error = Message;
+	return false;
+}
\ No newline at end of file
@@ -0,0 +1,160 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MAPPED FILE MODULE																	//
+//	Gives read-only access to a whole file by mapping it into memory, so that it can	//
+//	be parsed in place without copying it into a buffer first.  Uses the Win32 file		//
+//	mapping functions on Windows & mmap() elsewhere.									//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "MappedFile.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#ifdef _WIN32
+#include <windows.h>	// Standard Win32 library.  
+#else
+#include <fcntl.h>		// POSIX file control.  
+#include <sys/mman.h>	// POSIX memory mapping.  
+#include <sys/stat.h>	// POSIX file status.  
+#include <unistd.h>		// POSIX standard functions.  
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Class constructor.  
+//////////////////////////////////////////////////////////////////////////////////////////
+MappedFile::MappedFile()
+{
+	this->Data = NULL;
+	this->size = 0;
+
+#ifdef _WIN32
+	this->File = INVALID_HANDLE_VALUE;
+	this->Mapping = NULL;
+#else
+	this->file = -1;
+#endif
+}
+
+//	Class destructor.  Makes sure the file is unmapped & closed.  
+//////////////////////////////////////////////////////////////////////////////////////////
+MappedFile::~MappedFile()
+{
+	this->Close();
+}
+
+//	Function to map the given file into memory.  Empty files can't be mapped, so they
+//	are reported as opened with no data.  Returns false if the file couldn't be opened.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool MappedFile::Open(const char* path)
+{
+	this->Close();
+
+#ifdef _WIN32
+	File = CreateFileA(path, GENERIC_READ, FILE_SHARE_READ, NULL, OPEN_EXISTING,
+						FILE_FLAG_SEQUENTIAL_SCAN, NULL);
+	if (File == INVALID_HANDLE_VALUE)
+		return false;
+
+	LARGE_INTEGER length;
+	if (!GetFileSizeEx(File, &length))
+	{
+		this->Close();
+		return false;
+	}
+
+	size = (size_t)length.QuadPart;
+	if (size == 0)
+		return true;
+
+	Mapping = CreateFileMappingA(File, NULL, PAGE_READONLY, 0, 0, NULL);
+	if (Mapping)
+		Data = (const char*)MapViewOfFile(Mapping, FILE_MAP_READ, 0, 0, 0);
+#else
+	file = open(path, O_RDONLY);
+	if (file < 0)
+		return false;
+
+	struct stat status;
+	if (fstat(file, &status) != 0)
+	{
+		this->Close();
+		return false;
+	}
+
+	size = (size_t)status.st_size;
+	if (size == 0)
+		return true;
+
+	void* View = mmap(NULL, size, PROT_READ, MAP_PRIVATE, file, 0);
+	if (View != MAP_FAILED)
+	{
+		Data = (const char*)View;
+		madvise(View, size, MADV_SEQUENTIAL);
+	}
+#endif
+
+	if (!Data)
+	{
+		this->Close();
+		return false;
+	}
+
+	return true;
+}
+
+//	Function to unmap & close the file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void MappedFile::Close()
+{
+#ifdef _WIN32
+	if (Data)
+		UnmapViewOfFile(Data);
+	if (Mapping)
+		CloseHandle(Mapping);
+	if (File != INVALID_HANDLE_VALUE)
+		CloseHandle(File);
+
+	Mapping = NULL;
+	File = INVALID_HANDLE_VALUE;
+#else
+	if (Data)
+		munmap((void*)Data, size);
+	if (file >= 0)
+		close(file);
+
+	file = -1;
+#endif
+
+	Data = NULL;
+	size = 0;
+}
+
+//	Function to report where the file starts in memory.  
+//////////////////////////////////////////////////////////////////////////////////////////
+const char* MappedFile::GetData()
+{
+	return Data;
+}
+
+//	Function to report the size of the file in bytes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+size_t MappedFile::GetSize()
+{
+	return size;
+}
\ No newline at end of file
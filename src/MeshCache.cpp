@@ -0,0 +1,352 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MESH CACHE MODULE																	//
+//	Keeps a single copy of each mesh loaded by the game, however many objects draw it.	//
+//	Meshes are looked up first by the name they were loaded under & then by a			//
+//	fingerprint of their content, so the same model under two names is still only held	//
+//	once.  Each mesh is counted as it is handed out & freed once the last object using	//
+//	it lets it go.  The cache also counts the triangles drawn from each level of detail	//
+//	every frame.																		//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "MeshCache.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>			// Standard I/O library, for building the report.  
+#include <string.h>			// Standard memory functions.  
+#include "CookedMesh.h"		// Cooked binary meshes.  
+#include "AssetLoader.h"	// Background mesh reading.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Class constructor.  
+//////////////////////////////////////////////////////////////////////////////////////////
+MeshCache::MeshCache()
+{
+	this->Backend = NULL;
+	this->loads = 0;
+	this->hits = 0;
+
+	for (int i = 0 ; i < MESH_MAX_LODS ; i++)
+	{
+		this->drawing[i] = 0;
+		this->drawn[i] = 0;
+	}
+}
+
+//	Class destructor.  Frees any meshes still held, in case their objects were never
+//	destroyed.  
+//////////////////////////////////////////////////////////////////////////////////////////
+MeshCache::~MeshCache()
+{
+	for (size_t i = 0 ; i < Assets.size() ; i++)
+		this->Destroy(Assets[i]);
+	Assets.clear();
+}
+
+//	Function to hand out the mesh for the given file.  A name loaded or published before
+//	is handed straight back.  Otherwise the mesh is read - from its cooked copy if there
+//	is one, or else from the model itself - and held.  If the file can't be read, the
+//	reason is shown to the user & NULL is returned.  
+//////////////////////////////////////////////////////////////////////////////////////////
+const MeshAsset* MeshCache::Acquire(const char* path)
+{
+	MeshAsset* Asset = this->FindName(path);
+
+	if (Asset)						// If the name has been loaded before...  
+	{
+		Asset->users++;
+		hits++;
+		return Asset;
+	}
+
+	MeshSource Source;				// The mesh as read from disk.  
+
+	// Debug builds check every byte of a cooked copy, to catch files that have been
+	// damaged.  
+#ifdef _DEBUG
+	bool verify = true;
+#else
+	bool verify = false;
+#endif
+
+	if (!Source.Read(path, verify))
+	{
+		MessageBox(0, Source.GetError(), ERROR_MESH_TTL, 0);
+		return NULL;
+	}
+
+	loads++;
+	Asset = this->Insert(path, Source.GetView());
+	if (Asset)
+		Asset->users++;
+	return Asset;
+}
+
+//	Function to hold a mesh that has already been read, such as by the asset loader on
+//	another thread, so that objects asking for it later are handed it straight away.
+//	Must be called from the main thread, as the backend's mesh is made here.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool MeshCache::Publish(const char* path, const MeshView& Data)
+{
+	if (this->FindName(path))		// If the name has been loaded before...  
+		return true;
+
+	loads++;
+	return (this->Insert(path, Data) != NULL);
+}
+
+//	Function to let go of a mesh handed out by the cache, freeing it once nothing else
+//	is using it.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void MeshCache::Release(const MeshAsset* Asset)
+{
+	for (size_t i = 0 ; i < Assets.size() ; i++)
+	{
+		if (Assets[i] != Asset)
+			continue;
+
+		if (--Assets[i]->users <= 0)	// If this was the last user...  
+		{
+			this->Destroy(Assets[i]);
+			Assets.erase(Assets.begin() + i);
+		}
+		return;
+	}
+}
+
+//	Function to set the render backend the meshes are made in.  Must be set before any
+//	mesh is loaded, and not changed while meshes are held.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void MeshCache::SetBackend(RenderBackend* Backend)
+{
+	this->Backend = Backend;
+}
+
+//	Function to report the render backend the meshes are made in & drawn through.  
+//////////////////////////////////////////////////////////////////////////////////////////
+RenderBackend* MeshCache::GetBackend()
+{
+	return this->Backend;
+}
+
+//	Function to report the number of meshes held.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int MeshCache::GetAssetCount()
+{
+	return (int)Assets.size();
+}
+
+//	Function to report the memory taken by every mesh held.  
+//////////////////////////////////////////////////////////////////////////////////////////
+size_t MeshCache::GetResidentBytes()
+{
+	size_t total = 0;
+	for (size_t i = 0 ; i < Assets.size() ; i++)
+		total += Assets[i]->bytes;
+	return total;
+}
+
+//	Function to list every mesh held to the debugger's output, with the memory it takes
+//	& the number of objects using it, followed by the size of each of its levels.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void MeshCache::Report()
+{
+	char Line[256];
+
+	for (size_t i = 0 ; i < Assets.size() ; i++)
+	{
+		const MeshAsset* Asset = Assets[i];
+
+		snprintf(Line, sizeof(Line), "Mesh %-16s %8d bytes, %2d users, %016llx\n",
+				Asset->Names[0].c_str(), (int)Asset->bytes, Asset->users, Asset->fingerprint);
+		OutputDebugString(Line);
+
+		for (DWORD l = 0 ; l < Asset->numLods ; l++)
+		{
+			snprintf(Line, sizeof(Line), "  LOD %d %6d faces %8d bytes, error %.4f\n", (int)l,
+					(int)Backend->GetFaceCount(Asset->Lods[l]),
+					(int)Backend->GetMeshBytes(Asset->Lods[l]), Asset->Errors[l]);
+			OutputDebugString(Line);
+		}
+	}
+
+	snprintf(Line, sizeof(Line), "Meshes: %d held in %d bytes, %d loaded, %d shared\n",
+			this->GetAssetCount(), (int)this->GetResidentBytes(), loads, hits);
+	OutputDebugString(Line);
+}
+
+//	Function to add triangles drawn from the given level of detail to this frame's
+//	count.  Called by each mesh as it draws.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void MeshCache::CountDrawn(DWORD level, DWORD faces)
+{
+	if (level < MESH_MAX_LODS)
+		drawing[level] += faces;
+}
+
+//	Function to finish a frame's counts, keeping them to be reported & starting afresh.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void MeshCache::EndFrame()
+{
+	for (int i = 0 ; i < MESH_MAX_LODS ; i++)
+	{
+		drawn[i] = drawing[i];
+		drawing[i] = 0;
+	}
+}
+
+//	Function to report the triangles drawn from the given level of detail last frame.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int MeshCache::GetDrawnFaces(DWORD level)
+{
+	return (level < MESH_MAX_LODS) ? drawn[level] : 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PRIVATE METHODS
+//	Methods called from within the class for better organisation of the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to look for a mesh already loaded under the given name.  
+//////////////////////////////////////////////////////////////////////////////////////////
+MeshAsset* MeshCache::FindName(const char* path)
+{
+	for (size_t i = 0 ; i < Assets.size() ; i++)
+		for (size_t n = 0 ; n < Assets[i]->Names.size() ; n++)
+			if (Assets[i]->Names[n] == path)
+				return Assets[i];
+	return NULL;
+}
+
+//	Function to look for a mesh already held with the same content.  
+//////////////////////////////////////////////////////////////////////////////////////////
+MeshAsset* MeshCache::FindContent(unsigned long long fingerprint)
+{
+	for (size_t i = 0 ; i < Assets.size() ; i++)
+		if (Assets[i]->fingerprint == fingerprint)
+			return Assets[i];
+	return NULL;
+}
+
+//	Function to hold a newly read mesh under the given name.  The mesh's content is
+//	compared against the meshes already held before a new mesh is made for it.  
+//////////////////////////////////////////////////////////////////////////////////////////
+MeshAsset* MeshCache::Insert(const char* path, const MeshView& Data)
+{
+	// Shares a mesh already held with the same content, if there is one.  
+	unsigned long long fingerprint = MeshCache::Fingerprint(Data);
+	MeshAsset* Asset = this->FindContent(fingerprint);
+
+	if (Asset)
+		hits++;
+	else
+	{
+		Asset = this->Build(Data);
+		if (!Asset)
+			return NULL;
+
+		Asset->fingerprint = fingerprint;
+		Assets.push_back(Asset);
+	}
+
+	Asset->Names.push_back(path);
+	return Asset;
+}
+
+//	Function to create the backend's meshes for every level of detail in loaded data,
+//	along with the materials they share.  
+//////////////////////////////////////////////////////////////////////////////////////////
+MeshAsset* MeshCache::Build(const MeshView& Data)
+{
+	MeshAsset* Asset = new MeshAsset;
+	Asset->numLods = Data.GetLodCount();
+	Asset->numMaterials = Data.numMaterials;
+	Asset->Materials = new RenderMaterial[Data.numMaterials];
+	Asset->fingerprint = 0;
+	Asset->bytes = Asset->numMaterials * sizeof(RenderMaterial);
+	Asset->users = 0;
+
+	for (DWORD l = 0 ; l < MESH_MAX_LODS ; l++)
+	{
+		Asset->Lods[l] = -1;
+		Asset->Errors[l] = 0.0f;
+	}
+
+	// Creates a mesh in the backend for each level.  
+	for (DWORD l = 0 ; l < Asset->numLods ; l++)		// For each level of detail...  
+	{
+		Asset->Lods[l] = Backend->CreateMesh(Data.GetLod(l));
+		if (Asset->Lods[l] < 0)
+		{
+			this->Destroy(Asset);
+			return NULL;
+		}
+
+		Asset->Errors[l] = Data.numLods ? Data.Lods[l].error : 0.0f;
+		Asset->bytes += Backend->GetMeshBytes(Asset->Lods[l]);
+	}
+
+	// Creates a material for each material in the mesh.  
+	for (DWORD i = 0 ; i < Asset->numMaterials ; i++)	// For each material...  
+	{
+		const MeshMaterial& From = Data.Materials[i];
+		RenderMaterial& To = Asset->Materials[i];
+
+		RenderColour Diffuse	= { From.diffuse[0], From.diffuse[1], From.diffuse[2],
+									From.diffuse[3] };
+		RenderColour Specular	= { From.specular[0], From.specular[1], From.specular[2], 1.0f };
+		RenderColour Emissive	= { From.emissive[0], From.emissive[1], From.emissive[2], 1.0f };
+
+		To.Diffuse		= Diffuse;
+		To.Specular		= Specular;
+		To.Emissive		= Emissive;
+		To.power		= From.power;
+		To.Ambient		= To.Diffuse;	// Then the ambient is made the same as the diffuse
+			// (a common workaround due to limitations in Direct3D to date.  
+	}
+
+	return Asset;
+}
+
+//	Function to free a mesh.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void MeshCache::Destroy(MeshAsset* Asset)
+{
+	for (DWORD l = 0 ; l < Asset->numLods ; l++)
+		if (Asset->Lods[l] >= 0)
+			Backend->DestroyMesh(Asset->Lods[l]);
+	delete[] Asset->Materials;
+	delete Asset;
+}
+
+//	Function to work out a fingerprint of a mesh's content.  Each array is checksummed
+//	& the results mixed, so a mesh has the same fingerprint wherever it was read from.  
+//////////////////////////////////////////////////////////////////////////////////////////
+unsigned long long MeshCache::Fingerprint(const MeshView& Data)
+{
+	unsigned long long Parts[5];
+	Parts[0] = CookedMesh::Checksum(Data.Vertices, Data.numVertices * sizeof(MeshVertex));
+	Parts[1] = CookedMesh::Checksum(Data.Indices, Data.numIndices * sizeof(unsigned int));
+	Parts[2] = CookedMesh::Checksum(Data.Attributes, Data.numFaces * sizeof(unsigned int));
+	Parts[3] = CookedMesh::Checksum(Data.Materials, Data.numMaterials * sizeof(MeshMaterial));
+	Parts[4] = CookedMesh::Checksum(Data.Lods, Data.numLods * sizeof(MeshLod));
+
+	return CookedMesh::Checksum(Parts, sizeof(Parts));
+}
\ No newline at end of file
@@ -0,0 +1,134 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MESH DATA MODULE																	//
+//	The layout a mesh is held in once it has been read from a file, before it is handed	//
+//	to the renderer.  Everything is kept in flat arrays: one vertex per unique			//
+//	combination of position & normal, three indices per triangle, and the material of	//
+//	each triangle.  Nothing here depends on Direct3D, so meshes can be read & worked	//
+//	on by the tools as well as the game.												//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "MeshData.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <stddef.h>		// Standard definitions, for NULL.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to report a view of the mesh.  The view is only good until the mesh is
+//	next changed.  
+//////////////////////////////////////////////////////////////////////////////////////////
+MeshView MeshData::GetView() const
+{
+	MeshView View;
+
+	View.Vertices		= Vertices.empty() ? NULL : &Vertices[0];
+	View.Indices		= Indices.empty() ? NULL : &Indices[0];
+	View.Attributes		= Attributes.empty() ? NULL : &Attributes[0];
+	View.Materials		= Materials.empty() ? NULL : &Materials[0];
+
+	View.numVertices	= (unsigned int)Vertices.size();
+	View.numIndices		= (unsigned int)Indices.size();
+	View.numFaces		= (unsigned int)Attributes.size();
+	View.numMaterials	= (unsigned int)Materials.size();
+
+	View.Lods			= Lods.empty() ? NULL : &Lods[0];
+	View.numLods		= (unsigned int)Lods.size();
+
+	return View;
+}
+
+//	Function to empty the mesh, ready for another to be read into it.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void MeshData::Clear()
+{
+	Vertices.clear();
+	Indices.clear();
+	Attributes.clear();
+	Materials.clear();
+	Lods.clear();
+}
+
+//	Function to add a coarser level of detail after those already held.  A mesh
+//	without a list yet has its own contents listed as level 0 first.  The level must
+//	use the same materials as the mesh.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void MeshData::AddLod(const MeshData& Level, float error)
+{
+	MeshLod Lod;
+
+	if (Lods.empty())
+	{
+		Lod.firstVertex = 0;
+		Lod.numVertices = (unsigned int)Vertices.size();
+		Lod.firstFace = 0;
+		Lod.numFaces = (unsigned int)Attributes.size();
+		Lod.error = 0.0f;
+		Lod.reserved = 0;
+		Lods.push_back(Lod);
+	}
+
+	Lod.firstVertex = (unsigned int)Vertices.size();
+	Lod.numVertices = (unsigned int)Level.Vertices.size();
+	Lod.firstFace = (unsigned int)Attributes.size();
+	Lod.numFaces = (unsigned int)Level.Attributes.size();
+	Lod.error = error;
+	Lod.reserved = 0;
+	Lods.push_back(Lod);
+
+	Vertices.insert(Vertices.end(), Level.Vertices.begin(), Level.Vertices.end());
+	Indices.insert(Indices.end(), Level.Indices.begin(), Level.Indices.end());
+	Attributes.insert(Attributes.end(), Level.Attributes.begin(), Level.Attributes.end());
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	VIEW METHODS
+//	Methods for looking at the levels of detail through a view.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to report the number of levels of detail held, which is always at least
+//	one for a mesh that isn't empty.  
+//////////////////////////////////////////////////////////////////////////////////////////
+unsigned int MeshView::GetLodCount() const
+{
+	return numLods ? numLods : 1;
+}
+
+//	Function to report a view of a single level of detail, with the level's own arrays
+//	& no levels listed.  A view without levels listed is its own level 0.  
+//////////////////////////////////////////////////////////////////////////////////////////
+MeshView MeshView::GetLod(unsigned int level) const
+{
+	MeshView View = *this;
+	View.Lods = NULL;
+	View.numLods = 0;
+
+	if (level >= numLods)
+		return View;
+
+	const MeshLod& Lod = Lods[level];
+	View.Vertices		= Vertices + Lod.firstVertex;
+	View.Indices		= Indices + Lod.firstFace * 3;
+	View.Attributes		= Attributes + Lod.firstFace;
+	View.numVertices	= Lod.numVertices;
+	View.numIndices		= Lod.numFaces * 3;
+	View.numFaces		= Lod.numFaces;
+
+	return View;
+}
\ No newline at end of file
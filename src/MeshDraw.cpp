@@ -0,0 +1,78 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MESH DRAW MODULE																	//
+//	Hands a mesh to the render queue.  It picks the level of detail the mesh's size on	//
+//	screen calls for, then queues each of that level's subsets under one world matrix.	//
+//	The game's meshes & the tools both draw through here, so the tools hand the queue	//
+//	exactly the draws the game does.													//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "MeshDraw.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to pick the coarsest level of detail that can't be told apart from the full
+//	mesh.  The mesh's centre is moved into view space using the given world matrix & the
+//	view & projection already set, to find how many pixels a unit covers at its depth,
+//	and each level's error is scaled by that to see how far it would stray on screen.  
+//////////////////////////////////////////////////////////////////////////////////////////
+unsigned int MeshDraw::SelectLod(RenderBackend* Backend, const DrawableMesh& Mesh,
+								 const Matrix& World)
+{
+	if (Mesh.numLods <= 1)
+		return 0;
+
+	Matrix View, Projection;				// The matrices currently set.  
+
+	Backend->GetTransform(TRANSFORM_VIEW, View);
+	Backend->GetTransform(TRANSFORM_PROJECTION, Projection);
+
+	float Centre[3] = { 0.0f, 0.0f, 0.0f };
+	Matrix WorldView = Matrix::Multiply(World, View);
+	WorldView.TransformCoord(Centre, Centre);
+
+	if (Centre[2] <= 0.0f)					// If the mesh is behind the camera...  
+		return Mesh.numLods - 1;
+
+	// Pixels covered by a unit at the mesh's depth.  
+	float pixels = Projection.m[1][1] * Backend->GetHeight() * 0.5f / Centre[2];
+
+	unsigned int level = 0;
+	while ((level + 1 < Mesh.numLods) &&
+		   (Mesh.Errors[level + 1] * pixels <= LOD_PIXEL_ERROR))
+		level++;
+
+	return level;
+}
+
+//	Function to queue every subset of a level of a mesh in the given pass, all sharing
+//	the one world matrix.  Each subset is drawn in its own material, or in the given one
+//	if there is one, with the palette colour put in unless it's PALETTE_NONE.  Reports
+//	the backend's mesh that was queued.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int MeshDraw::Submit(RenderQueue& Drawing, int pass, const DrawableMesh& Mesh,
+					 unsigned int level, const Matrix& World,
+					 const RenderMaterial* Matter, int colour)
+{
+	int mesh = Mesh.Lods[level];
+	int transform = Drawing.AddTransform(World);	// Every subset shares the matrix.  
+
+	for (unsigned int i = 0 ; i < Mesh.numMaterials ; i++)	// For each subset...  
+		Drawing.Submit(pass, mesh, i, Matter ? Matter : &Mesh.Materials[i], colour,
+					   transform);
+
+	return mesh;
+}
\ No newline at end of file
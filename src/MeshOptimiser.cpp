@@ -0,0 +1,291 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MESH OPTIMISER MODULE																//
+//	Reorders a mesh so that the graphics card does less work drawing it.  Triangles		//
+//	are put into an order that reuses recently transformed vertices, using Tom			//
+//	Forsyth's linear-speed vertex cache optimisation, and vertices are then renumbered	//
+//	in the order they are first used so that they are fetched from memory in order.		//
+//	Neither changes how the mesh looks; meshes are optimised when they are cooked.		//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "MeshOptimiser.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <math.h>			// Standard math library.  
+#include <algorithm>		// Standard algorithms, for sorting.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	The weights of Forsyth's scoring, as given in his article.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define SCORE_DECAY_POWER		1.5f	// How quickly a vertex's score falls with age.  
+#define SCORE_LAST_TRIANGLE		0.75f	// The score of the last triangle's vertices.  
+#define SCORE_VALENCE_SCALE		2.0f	// The boost for vertices with few triangles left.  
+#define SCORE_VALENCE_POWER		0.5f	// How quickly that boost falls.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to optimise a mesh.  Triangles are first grouped by material, as each
+//	material is drawn as its own subset, and each group is then ordered for the cache on
+//	its own before the vertices are renumbered.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void MeshOptimiser::Optimise(MeshData& Mesh)
+{
+	int triangles = (int)Mesh.Attributes.size();
+	if (triangles == 0)
+		return;
+
+	// Groups the triangles by material, keeping their order within each group.  
+	Order.resize(triangles);
+	for (int i = 0 ; i < triangles ; i++)
+		Order[i] = i;
+	std::stable_sort(Order.begin(), Order.end(),
+		[&Mesh](unsigned int a, unsigned int b) { return Mesh.Attributes[a] < Mesh.Attributes[b]; });
+
+	Ordered.resize(triangles * 3);
+	for (int i = 0 ; i < triangles ; i++)
+		for (int c = 0 ; c < 3 ; c++)
+			Ordered[i * 3 + c] = Mesh.Indices[Order[i] * 3 + c];
+	Mesh.Indices.swap(Ordered);
+	std::sort(Mesh.Attributes.begin(), Mesh.Attributes.end());
+
+	// Orders the triangles of each group.  
+	for (int start = 0 ; start < triangles ; )
+	{
+		int end = start;
+		while ((end < triangles) && (Mesh.Attributes[end] == Mesh.Attributes[start]))
+			end++;
+
+		this->OrderTriangles(&Mesh.Indices[start * 3], end - start, (int)Mesh.Vertices.size());
+		start = end;
+	}
+
+	this->OrderVertices(Mesh);
+}
+
+//	Function to measure how well a mesh's triangle order suits a FIFO vertex cache of
+//	the given size, as found on the older cards the game is played on.  A vertex is
+//	still in such a cache if fewer than cacheSize misses have happened since it went in.  
+//////////////////////////////////////////////////////////////////////////////////////////
+CacheStats MeshOptimiser::Analyse(const MeshView& Mesh, int cacheSize)
+{
+	std::vector<int> Entered(Mesh.numVertices, -cacheSize - 1);	// When each went in.  
+	int misses = 0;
+
+	for (unsigned int i = 0 ; i < Mesh.numIndices ; i++)
+	{
+		unsigned int vertex = Mesh.Indices[i];
+
+		if (misses - Entered[vertex] > cacheSize)	// If the vertex has left the cache...  
+		{
+			Entered[vertex] = misses;
+			misses++;
+		}
+	}
+
+	CacheStats Stats;
+	Stats.misses = misses;
+	Stats.acmr = Mesh.numFaces ? (float)misses / Mesh.numFaces : 0.0f;
+	Stats.atvr = Mesh.numVertices ? (float)misses / Mesh.numVertices : 0.0f;
+	return Stats;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PRIVATE METHODS
+//	Methods called from within the class for better organisation of the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to put a run of triangles into cache order.  A small cache is modelled as
+//	triangles are added, and each time the next triangle is picked from those using the
+//	vertices in it, by the scores of their vertices.  A vertex scores highly if it was
+//	used recently, so is likely still to be cached, or if it has few triangles left, so
+//	that it isn't left stranded to be transformed again later.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void MeshOptimiser::OrderTriangles(unsigned int* Indices, int triangles, int vertices)
+{
+	// Lists the triangles using each vertex.  
+	Remaining.assign(vertices, 0);
+	for (int i = 0 ; i < triangles * 3 ; i++)
+		Remaining[Indices[i]]++;
+
+	Offsets.resize(vertices + 1);
+	Offsets[0] = 0;
+	for (int v = 0 ; v < vertices ; v++)
+		Offsets[v + 1] = Offsets[v] + Remaining[v];
+
+	Adjacent.resize(triangles * 3);
+	CachePosition.assign(vertices, 0);			// Used as a fill count for now.  
+	for (int i = 0 ; i < triangles * 3 ; i++)
+	{
+		int v = Indices[i];
+		Adjacent[Offsets[v] + CachePosition[v]++] = i / 3;
+	}
+
+	// Scores every vertex & triangle before anything is in the cache.  
+	CachePosition.assign(vertices, -1);
+	Scores.resize(vertices);
+	for (int v = 0 ; v < vertices ; v++)
+		Scores[v] = MeshOptimiser::VertexScore(-1, Remaining[v]);
+
+	TriangleScores.resize(triangles);
+	for (int t = 0 ; t < triangles ; t++)
+		TriangleScores[t] = Scores[Indices[t * 3]] + Scores[Indices[t * 3 + 1]] +
+							Scores[Indices[t * 3 + 2]];
+
+	Added.assign(triangles, 0);
+	Ordered.clear();
+
+	int Cache[OPTIMISE_CACHE_SIZE + 3];			// The modelled cache, newest first.  
+	int cached = 0;
+	int best = -1;
+	int scan = 0;								// Where to look for a fresh start from.  
+
+	for (int n = 0 ; n < triangles ; n++)
+	{
+		// Falls back to the best triangle left anywhere if none around the cache are.  
+		if (best < 0)
+		{
+			while (Added[scan])
+				scan++;
+
+			best = scan;
+			for (int t = scan + 1 ; t < triangles ; t++)
+				if (!Added[t] && (TriangleScores[t] > TriangleScores[best]))
+					best = t;
+		}
+
+		const unsigned int* Corners = &Indices[best * 3];
+		Added[best] = 1;
+		Ordered.insert(Ordered.end(), Corners, Corners + 3);
+
+		// Takes the triangle out of each of its vertices' lists.  
+		for (int c = 0 ; c < 3 ; c++)
+		{
+			int v = Corners[c];
+			int* List = &Adjacent[Offsets[v]];
+
+			for (int i = 0 ; i < Remaining[v] ; i++)
+				if (List[i] == best)
+				{
+					List[i] = List[--Remaining[v]];
+					break;
+				}
+		}
+
+		// Moves the triangle's vertices to the front of the cache.  
+		int Updated[OPTIMISE_CACHE_SIZE + 3];
+		int count = 0;
+
+		for (int c = 0 ; c < 3 ; c++)
+		{
+			bool repeated = false;				// Whether a corner shares a vertex.  
+			for (int i = 0 ; i < count ; i++)
+				repeated |= (Updated[i] == (int)Corners[c]);
+			if (!repeated)
+				Updated[count++] = Corners[c];
+		}
+		for (int i = 0 ; i < cached ; i++)
+			if ((Cache[i] != (int)Corners[0]) && (Cache[i] != (int)Corners[1]) && (Cache[i] != (int)Corners[2]))
+				Updated[count++] = Cache[i];
+
+		// Rescores everything that moved, including those pushed out of the cache.  
+		for (int i = 0 ; i < count ; i++)
+		{
+			int v = Updated[i];
+			CachePosition[v] = (i < OPTIMISE_CACHE_SIZE) ? i : -1;
+			Scores[v] = MeshOptimiser::VertexScore(CachePosition[v], Remaining[v]);
+		}
+
+		// Rescores the triangles left around them, keeping the best for next time.  
+		best = -1;
+		for (int i = 0 ; i < count ; i++)
+		{
+			int v = Updated[i];
+			for (int a = 0 ; a < Remaining[v] ; a++)
+			{
+				int t = Adjacent[Offsets[v] + a];
+				TriangleScores[t] = Scores[Indices[t * 3]] + Scores[Indices[t * 3 + 1]] +
+									Scores[Indices[t * 3 + 2]];
+
+				if ((best < 0) || (TriangleScores[t] > TriangleScores[best]))
+					best = t;
+			}
+		}
+
+		cached = (count < OPTIMISE_CACHE_SIZE) ? count : OPTIMISE_CACHE_SIZE;
+		for (int i = 0 ; i < cached ; i++)
+			Cache[i] = Updated[i];
+	}
+
+	std::copy(Ordered.begin(), Ordered.end(), Indices);
+}
+
+//	Function to renumber the vertices in the order the triangles first use them, so
+//	that they are read from memory in a single forward sweep.  Any vertices not used by
+//	a triangle are kept at the end.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void MeshOptimiser::OrderVertices(MeshData& Mesh)
+{
+	int vertices = (int)Mesh.Vertices.size();
+	const unsigned int unused = 0xffffffff;
+
+	Order.assign(vertices, unused);				// The new number of each vertex.  
+	unsigned int next = 0;
+
+	for (size_t i = 0 ; i < Mesh.Indices.size() ; i++)
+	{
+		unsigned int& Number = Order[Mesh.Indices[i]];
+		if (Number == unused)
+			Number = next++;
+		Mesh.Indices[i] = Number;
+	}
+	for (int v = 0 ; v < vertices ; v++)
+		if (Order[v] == unused)
+			Order[v] = next++;
+
+	std::vector<MeshVertex> Vertices(vertices);
+	for (int v = 0 ; v < vertices ; v++)
+		Vertices[Order[v]] = Mesh.Vertices[v];
+	Mesh.Vertices.swap(Vertices);
+}
+
+//	Function to score a vertex by where it sits in the cache & how many triangles it
+//	has left.  The three vertices of the last triangle added get a fixed score, as
+//	which of them is oldest depends on the hardware.  A vertex with no triangles left
+//	scores below zero so it is never picked.  
+//////////////////////////////////////////////////////////////////////////////////////////
+float MeshOptimiser::VertexScore(int position, int remaining)
+{
+	if (remaining == 0)
+		return -1.0f;
+
+	float score = 0.0f;
+
+	if (position >= 0)						// If the vertex is in the cache...  
+	{
+		if (position < 3)
+			score = SCORE_LAST_TRIANGLE;
+		else
+			score = powf(1.0f - (float)(position - 3) / (OPTIMISE_CACHE_SIZE - 3),
+						 SCORE_DECAY_POWER);
+	}
+
+	score += SCORE_VALENCE_SCALE * powf((float)remaining, -SCORE_VALENCE_POWER);
+	return score;
+}
\ No newline at end of file
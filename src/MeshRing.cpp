@@ -32,22 +32,17 @@ RingBlock::RingBlock(float displacement)
 	this->displacement = displacement;
 }
 
-//	Function to render the block onto the screen.  
+//	Function to render the block onto the screen with the given world matrix, which the
+//	game works out from the ring's rotation & the block's place along it.  
 //////////////////////////////////////////////////////////////////////////////////////////
-void RingBlock::Render()
+void RingBlock::Render(const Matrix& World)
 {
-	// Sets the world matrix as that of the class's rotation matrix.  
-	Device->SetTransform(D3DTS_WORLD, &(this->Rotation));
-
-	this->RenderMesh();		// Renders the mesh after the world matrix is set.  
+	this->RenderMesh(RENDER_PASS_SCENE, World);
 }
 
-//	Function to rotate the block around the y-axis at the origin based on a given angle
-//	in radians.  
+//	Function to report how far along the ring the block sits, in radians.  
 //////////////////////////////////////////////////////////////////////////////////////////
-void RingBlock::RotationY(float rad)
+float RingBlock::GetDisplacement()
 {
-	// Sets the rotation matrix as that for a rotation around the y-axis of value (given
-	// angle in radians - the displacement angle stored in the class).  
-	D3DXMatrixRotationY(&this->Rotation, (rad - this->displacement));
+	return this->displacement;
 }
\ No newline at end of file
@@ -0,0 +1,561 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MESH SIMPLIFIER MODULE																//
+//	Builds coarser versions of a mesh for drawing it when it is small on screen, or		//
+//	where the detail can't be seen at all, such as in a shadow.  Edges are collapsed	//
+//	one at a time, cheapest first, with the cost of each measured by Garland &			//
+//	Heckbert's quadric error metric, and the normals of the result are then rebuilt		//
+//	keeping the hard edges of the original.												//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "MeshSimplifier.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <math.h>			// Standard math library.  
+#include <string.h>			// Standard string library, for comparing vertices.  
+#include <algorithm>		// Standard algorithms, for sorting.  
+#include <iterator>		// Standard iterators, for gathering results.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	Limits on which collapses are allowed & how normals are rebuilt.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define BOUNDARY_WEIGHT		100.0	// How strongly open edges are kept in place.  
+#define FLIP_LIMIT			0.2f	// Least cosine a triangle may turn through.  
+#define SMOOTH_LIMIT		0.999f	// Cosine under which two normals are different.  
+#define CREASE_LIMIT		0.707f	// Cosine under which faces don't share a normal.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LOCAL FUNCTIONS
+//	Small vector helpers used by the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+static void Cross(const float* A, const float* B, const float* C, float* Out)
+{
+	float u[3] = { B[0] - A[0], B[1] - A[1], B[2] - A[2] };
+	float v[3] = { C[0] - A[0], C[1] - A[1], C[2] - A[2] };
+
+	Out[0] = u[1] * v[2] - u[2] * v[1];
+	Out[1] = u[2] * v[0] - u[0] * v[2];
+	Out[2] = u[0] * v[1] - u[1] * v[0];
+}
+
+static float Dot(const float* A, const float* B)
+{
+	return A[0] * B[0] + A[1] * B[1] + A[2] * B[2];
+}
+
+static void Normalise(float* V)
+{
+	float length = sqrtf(Dot(V, V));
+	if (length > 0.0f)
+		for (int i = 0 ; i < 3 ; i++)
+			V[i] /= length;
+}
+
+//	Function to find the squared distance from a point to a triangle, by finding the
+//	closest point on it as laid out in Ericson's "Real-Time Collision Detection".  
+//////////////////////////////////////////////////////////////////////////////////////////
+static float TriangleDistance(const float* P, const float* A, const float* B, const float* C)
+{
+	float ab[3], ac[3], ap[3], Closest[3];
+	for (int i = 0 ; i < 3 ; i++)
+	{
+		ab[i] = B[i] - A[i];
+		ac[i] = C[i] - A[i];
+		ap[i] = P[i] - A[i];
+	}
+
+	float d1 = Dot(ab, ap), d2 = Dot(ac, ap);
+	float bp[3] = { P[0] - B[0], P[1] - B[1], P[2] - B[2] };
+	float d3 = Dot(ab, bp), d4 = Dot(ac, bp);
+	float cp[3] = { P[0] - C[0], P[1] - C[1], P[2] - C[2] };
+	float d5 = Dot(ab, cp), d6 = Dot(ac, cp);
+
+	float va = d3 * d6 - d5 * d4;
+	float vb = d5 * d2 - d1 * d6;
+	float vc = d1 * d4 - d3 * d2;
+
+	if ((d1 <= 0.0f) && (d2 <= 0.0f))							// Nearest corner A.  
+		memcpy(Closest, A, sizeof(Closest));
+	else if ((d3 >= 0.0f) && (d4 <= d3))						// Nearest corner B.  
+		memcpy(Closest, B, sizeof(Closest));
+	else if ((d6 >= 0.0f) && (d5 <= d6))						// Nearest corner C.  
+		memcpy(Closest, C, sizeof(Closest));
+	else if ((vc <= 0.0f) && (d1 >= 0.0f) && (d3 <= 0.0f))		// Nearest edge AB.  
+	{
+		float t = d1 / (d1 - d3);
+		for (int i = 0 ; i < 3 ; i++)
+			Closest[i] = A[i] + ab[i] * t;
+	}
+	else if ((vb <= 0.0f) && (d2 >= 0.0f) && (d6 <= 0.0f))		// Nearest edge AC.  
+	{
+		float t = d2 / (d2 - d6);
+		for (int i = 0 ; i < 3 ; i++)
+			Closest[i] = A[i] + ac[i] * t;
+	}
+	else if ((va <= 0.0f) && (d4 - d3 >= 0.0f) && (d5 - d6 >= 0.0f))	// Nearest edge BC.  
+	{
+		float t = (d4 - d3) / ((d4 - d3) + (d5 - d6));
+		for (int i = 0 ; i < 3 ; i++)
+			Closest[i] = B[i] + (C[i] - B[i]) * t;
+	}
+	else														// Inside the face.  
+	{
+		float scale = 1.0f / (va + vb + vc);
+		for (int i = 0 ; i < 3 ; i++)
+			Closest[i] = A[i] + ab[i] * (vb * scale) + ac[i] * (vc * scale);
+	}
+
+	float Offset[3] = { P[0] - Closest[0], P[1] - Closest[1], P[2] - Closest[2] };
+	return Dot(Offset, Offset);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to simplify a mesh down to the given number of triangles, or as near to it
+//	as can be reached without folding the surface over.  Each collapse moves one point
+//	onto a neighbour, so the result only uses positions from the original.  Reports the
+//	furthest any point of the original lies from the result.  
+//////////////////////////////////////////////////////////////////////////////////////////
+float MeshSimplifier::Simplify(const MeshView& Source, unsigned int target, MeshData& Out)
+{
+	this->Weld(Source);
+	this->BuildQuadrics();
+
+	// Queues a collapse each way along every edge.  
+	this->Queue = std::priority_queue<Candidate>();
+	for (unsigned int t = 0 ; t < Source.numFaces ; t++)
+		for (int c = 0 ; c < 3 ; c++)
+		{
+			int a = this->Triangles[t * 3 + c];
+			int b = this->Triangles[t * 3 + (c + 1) % 3];
+			this->Consider(a, b);
+			this->Consider(b, a);
+		}
+
+	// Carries out the cheapest collapses until there are few enough triangles left.  
+	while ((this->faces > target) && !this->Queue.empty())
+	{
+		Candidate Next = this->Queue.top();
+		this->Queue.pop();
+
+		if (this->Removed[Next.from] || this->Removed[Next.to] ||
+			(this->Stamps[Next.from] != Next.fromStamp) || (this->Stamps[Next.to] != Next.toStamp))
+			continue;									// It has changed since it was queued.  
+
+		this->Collapse(Next.from, Next.to);
+	}
+
+	this->BuildOutput(Source, Out);
+	return this->MeasureError(Out);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PRIVATE METHODS
+//	Methods called from within the class for better organisation of the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to merge vertices that share a position into single points, so that seams
+//	in the normals & texture co-ordinates don't split the surface apart.  A point is
+//	marked smooth if every vertex at it had the same normal.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void MeshSimplifier::Weld(const MeshView& Source)
+{
+	std::vector<int> Order(Source.numVertices);
+	for (unsigned int i = 0 ; i < Source.numVertices ; i++)
+		Order[i] = i;
+	std::sort(Order.begin(), Order.end(), [&Source](int a, int b)
+		{ return memcmp(Source.Vertices[a].position, Source.Vertices[b].position, sizeof(float) * 3) < 0; });
+
+	this->Points.clear();
+	this->FirstVertex.clear();
+	this->Smooth.clear();
+	this->PointOf.assign(Source.numVertices, -1);
+	this->NextVertex.assign(Source.numVertices, -1);
+
+	for (unsigned int i = 0 ; i < Source.numVertices ; i++)
+	{
+		const MeshVertex& Vertex = Source.Vertices[Order[i]];
+
+		if ((i == 0) || memcmp(Vertex.position, Source.Vertices[Order[i - 1]].position, sizeof(float) * 3))
+		{
+			this->Points.insert(this->Points.end(), Vertex.position, Vertex.position + 3);
+			this->FirstVertex.push_back(Order[i]);
+			this->Smooth.push_back(1);
+		}
+		else
+		{
+			int point = (int)this->FirstVertex.size() - 1;
+			const MeshVertex& First = Source.Vertices[this->FirstVertex[point]];
+
+			if (Dot(Vertex.normal, First.normal) < SMOOTH_LIMIT)
+				this->Smooth[point] = 0;
+			this->NextVertex[Order[i]] = this->FirstVertex[point];
+			this->FirstVertex[point] = Order[i];
+		}
+
+		this->PointOf[Order[i]] = (int)this->FirstVertex.size() - 1;
+	}
+
+	// Rewrites the triangles in terms of points.  
+	int points = (int)this->FirstVertex.size();
+	this->Removed.assign(points, 0);
+	this->Stamps.assign(points, 0);
+	this->PointTriangles.assign(points, std::vector<int>());
+
+	this->Triangles.resize(Source.numIndices);
+	for (unsigned int i = 0 ; i < Source.numIndices ; i++)
+	{
+		this->Triangles[i] = this->PointOf[Source.Indices[i]];
+		this->PointTriangles[this->Triangles[i]].push_back(i / 3);
+	}
+
+	this->Materials.assign(Source.Attributes, Source.Attributes + Source.numFaces);
+	this->Alive.assign(Source.numFaces, 1);
+	this->faces = Source.numFaces;
+}
+
+//	Function to sum up the planes of the triangles around each point.  The distance of a
+//	point from all of them can then be found from its quadric alone.  Edges used by only
+//	one triangle also add a steep plane at right angles to the surface, so that the
+//	outline of an open mesh is held in place.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void MeshSimplifier::BuildQuadrics()
+{
+	Quadric Empty;
+	memset(&Empty, 0, sizeof(Empty));
+	this->Quadrics.assign(this->FirstVertex.size(), Empty);
+
+	for (unsigned int t = 0 ; t < this->Alive.size() ; t++)
+	{
+		const int* Corners = &this->Triangles[t * 3];
+		float Normal[3];
+		Cross(&this->Points[Corners[0] * 3], &this->Points[Corners[1] * 3],
+			  &this->Points[Corners[2] * 3], Normal);
+		Normalise(Normal);
+
+		double Plane[4] = { Normal[0], Normal[1], Normal[2],
+							-Dot(Normal, &this->Points[Corners[0] * 3]) };
+		for (int c = 0 ; c < 3 ; c++)
+			this->AddPlane(Corners[c], Plane, 1.0);
+
+		// Looks for a neighbour across each edge.  
+		for (int c = 0 ; c < 3 ; c++)
+		{
+			int a = Corners[c];
+			int b = Corners[(c + 1) % 3];
+			bool shared = false;
+
+			for (unsigned int i = 0 ; (i < this->PointTriangles[a].size()) && !shared ; i++)
+			{
+				int other = this->PointTriangles[a][i];
+				if (other == (int)t)
+					continue;
+
+				for (int k = 0 ; k < 3 ; k++)
+					shared |= (this->Triangles[other * 3 + k] == b);
+			}
+
+			if (shared)
+				continue;
+
+			const float* A = &this->Points[a * 3];
+			const float* B = &this->Points[b * 3];
+			float Edge[3] = { B[0] - A[0], B[1] - A[1], B[2] - A[2] };
+			float Side[3] = { Edge[1] * Normal[2] - Edge[2] * Normal[1],
+							  Edge[2] * Normal[0] - Edge[0] * Normal[2],
+							  Edge[0] * Normal[1] - Edge[1] * Normal[0] };
+			Normalise(Side);
+
+			double Wall[4] = { Side[0], Side[1], Side[2], -Dot(Side, A) };
+			this->AddPlane(a, Wall, BOUNDARY_WEIGHT);
+			this->AddPlane(b, Wall, BOUNDARY_WEIGHT);
+		}
+	}
+}
+
+//	Function to add a plane, given as ax + by + cz + d = 0, to a point's quadric.  Only
+//	the upper half of the symmetric matrix is stored.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void MeshSimplifier::AddPlane(int point, const double* Plane, double weight)
+{
+	double* q = this->Quadrics[point].q;
+	int n = 0;
+
+	for (int row = 0 ; row < 4 ; row++)
+		for (int column = row ; column < 4 ; column++)
+			q[n++] += Plane[row] * Plane[column] * weight;
+}
+
+//	Function to find the error of moving one point onto another: the summed squared
+//	distance of the new position from the planes of both points.  
+//////////////////////////////////////////////////////////////////////////////////////////
+double MeshSimplifier::Cost(int from, int to)
+{
+	const double* A = this->Quadrics[from].q;
+	const double* B = this->Quadrics[to].q;
+	double q[10];
+	for (int i = 0 ; i < 10 ; i++)
+		q[i] = A[i] + B[i];
+
+	double x = this->Points[to * 3], y = this->Points[to * 3 + 1], z = this->Points[to * 3 + 2];
+
+	return q[0] * x * x + 2 * q[1] * x * y + 2 * q[2] * x * z + 2 * q[3] * x +
+		   q[4] * y * y + 2 * q[5] * y * z + 2 * q[6] * y +
+		   q[7] * z * z + 2 * q[8] * z + q[9];
+}
+
+//	Function to queue a collapse, stamped so it can be skipped if either point changes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void MeshSimplifier::Consider(int from, int to)
+{
+	Candidate Next;
+	Next.cost = this->Cost(from, to);
+	Next.from = from;
+	Next.to = to;
+	Next.fromStamp = this->Stamps[from];
+	Next.toStamp = this->Stamps[to];
+	this->Queue.push(Next);
+}
+
+//	Function to move one point onto another if doing so leaves a sound surface.  The
+//	points must share exactly as many neighbours as triangles, or the collapse would
+//	pinch the surface together, and no triangle left may turn too far or be squashed
+//	flat.  The triangles along the edge are then removed & the rest moved across.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool MeshSimplifier::Collapse(int from, int to)
+{
+	std::vector<int>& Around = this->PointTriangles[from];
+	const float* Target = &this->Points[to * 3];
+
+	// Counts the triangles along the edge & lists the neighbours of each point.  
+	int shared = 0;
+	std::vector<int> FromNeighbours, ToNeighbours;
+
+	for (unsigned int i = 0 ; i < Around.size() ; i++)
+	{
+		const int* Corners = &this->Triangles[Around[i] * 3];
+		bool edge = (Corners[0] == to) || (Corners[1] == to) || (Corners[2] == to);
+		shared += edge;
+
+		for (int c = 0 ; c < 3 ; c++)
+			if ((Corners[c] != from) && (Corners[c] != to))
+				FromNeighbours.push_back(Corners[c]);
+	}
+
+	if (shared == 0)
+		return false;
+
+	for (unsigned int i = 0 ; i < this->PointTriangles[to].size() ; i++)
+	{
+		const int* Corners = &this->Triangles[this->PointTriangles[to][i] * 3];
+		for (int c = 0 ; c < 3 ; c++)
+			if ((Corners[c] != from) && (Corners[c] != to))
+				ToNeighbours.push_back(Corners[c]);
+	}
+
+	std::sort(FromNeighbours.begin(), FromNeighbours.end());
+	FromNeighbours.erase(std::unique(FromNeighbours.begin(), FromNeighbours.end()), FromNeighbours.end());
+	std::sort(ToNeighbours.begin(), ToNeighbours.end());
+	ToNeighbours.erase(std::unique(ToNeighbours.begin(), ToNeighbours.end()), ToNeighbours.end());
+
+	std::vector<int> Common;
+	std::set_intersection(FromNeighbours.begin(), FromNeighbours.end(),
+						  ToNeighbours.begin(), ToNeighbours.end(), std::back_inserter(Common));
+	if ((int)Common.size() != shared)
+		return false;
+
+	// Checks that none of the triangles kept would turn over.  
+	for (unsigned int i = 0 ; i < Around.size() ; i++)
+	{
+		const int* Corners = &this->Triangles[Around[i] * 3];
+		if ((Corners[0] == to) || (Corners[1] == to) || (Corners[2] == to))
+			continue;
+
+		const float* Moved[3];
+		for (int c = 0 ; c < 3 ; c++)
+			Moved[c] = (Corners[c] == from) ? Target : &this->Points[Corners[c] * 3];
+
+		float Before[3], After[3];
+		Cross(&this->Points[Corners[0] * 3], &this->Points[Corners[1] * 3],
+			  &this->Points[Corners[2] * 3], Before);
+		Cross(Moved[0], Moved[1], Moved[2], After);
+		Normalise(Before);
+
+		float length = sqrtf(Dot(After, After));
+		if ((length <= 0.0f) || (Dot(Before, After) < FLIP_LIMIT * length))
+			return false;
+	}
+
+	// Removes the triangles along the edge & moves the rest onto the kept point.  
+	for (unsigned int i = 0 ; i < Around.size() ; i++)
+	{
+		int t = Around[i];
+		int* Corners = &this->Triangles[t * 3];
+
+		if ((Corners[0] == to) || (Corners[1] == to) || (Corners[2] == to))
+		{
+			this->Alive[t] = 0;
+			this->faces--;
+
+			for (int c = 0 ; c < 3 ; c++)
+			{
+				if (Corners[c] == from)
+					continue;
+
+				std::vector<int>& List = this->PointTriangles[Corners[c]];
+				List.erase(std::find(List.begin(), List.end(), t));
+			}
+		}
+		else
+		{
+			for (int c = 0 ; c < 3 ; c++)
+				if (Corners[c] == from)
+					Corners[c] = to;
+			this->PointTriangles[to].push_back(t);
+		}
+	}
+
+	Around.clear();
+	this->Removed[from] = 1;
+	this->Smooth[to] &= this->Smooth[from];
+	for (int i = 0 ; i < 10 ; i++)
+		this->Quadrics[to].q[i] += this->Quadrics[from].q[i];
+
+	// Re-queues every edge around the kept point, as its quadric has grown.  
+	this->Stamps[to]++;
+	FromNeighbours.insert(FromNeighbours.end(), ToNeighbours.begin(), ToNeighbours.end());
+	for (unsigned int i = 0 ; i < FromNeighbours.size() ; i++)
+	{
+		this->Consider(to, FromNeighbours[i]);
+		this->Consider(FromNeighbours[i], to);
+	}
+
+	return true;
+}
+
+//	Function to turn the triangles left back into a mesh.  Each corner's normal is the
+//	average of the triangles around its point, but only of those facing nearly the same
+//	way unless the point was smooth to begin with, so that hard edges stay hard.  The
+//	texture co-ordinates are taken from whichever original vertex at the point had the
+//	closest normal.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void MeshSimplifier::BuildOutput(const MeshView& Source, MeshData& Out)
+{
+	Out.Clear();
+	Out.Materials.assign(Source.Materials, Source.Materials + Source.numMaterials);
+
+	std::vector<float> FaceNormals(this->Alive.size() * 3);
+	for (unsigned int t = 0 ; t < this->Alive.size() ; t++)
+		if (this->Alive[t])
+		{
+			const int* Corners = &this->Triangles[t * 3];
+			Cross(&this->Points[Corners[0] * 3], &this->Points[Corners[1] * 3],
+				  &this->Points[Corners[2] * 3], &FaceNormals[t * 3]);
+		}
+
+	std::vector<int> FirstOut(this->FirstVertex.size(), -1);	// Vertices made per point.  
+	std::vector<int> NextOut;
+
+	for (unsigned int t = 0 ; t < this->Alive.size() ; t++)
+	{
+		if (!this->Alive[t])
+			continue;
+
+		float Facing[3] = { FaceNormals[t * 3], FaceNormals[t * 3 + 1], FaceNormals[t * 3 + 2] };
+		Normalise(Facing);
+
+		for (int c = 0 ; c < 3 ; c++)
+		{
+			int point = this->Triangles[t * 3 + c];
+			const std::vector<int>& Around = this->PointTriangles[point];
+
+			MeshVertex Vertex;
+			memcpy(Vertex.position, &this->Points[point * 3], sizeof(Vertex.position));
+			memset(Vertex.normal, 0, sizeof(Vertex.normal));
+
+			for (unsigned int i = 0 ; i < Around.size() ; i++)
+			{
+				float Other[3] = { FaceNormals[Around[i] * 3], FaceNormals[Around[i] * 3 + 1],
+								   FaceNormals[Around[i] * 3 + 2] };
+				float Direction[3] = { Other[0], Other[1], Other[2] };
+				Normalise(Direction);
+
+				if (this->Smooth[point] || (Dot(Direction, Facing) >= CREASE_LIMIT))
+					for (int k = 0 ; k < 3 ; k++)
+						Vertex.normal[k] += Other[k];
+			}
+			Normalise(Vertex.normal);
+
+			// Takes the texture co-ordinates from the closest original vertex.  
+			int closest = this->FirstVertex[point];
+			for (int v = this->NextVertex[closest] ; v >= 0 ; v = this->NextVertex[v])
+				if (Dot(Source.Vertices[v].normal, Vertex.normal) >
+					Dot(Source.Vertices[closest].normal, Vertex.normal))
+					closest = v;
+			memcpy(Vertex.uv, Source.Vertices[closest].uv, sizeof(Vertex.uv));
+
+			// Reuses a vertex already made at the point if it matches.  
+			int index = FirstOut[point];
+			while ((index >= 0) && memcmp(&Out.Vertices[index], &Vertex, sizeof(MeshVertex)))
+				index = NextOut[index];
+
+			if (index < 0)
+			{
+				index = (int)Out.Vertices.size();
+				Out.Vertices.push_back(Vertex);
+				NextOut.push_back(FirstOut[point]);
+				FirstOut[point] = index;
+			}
+
+			Out.Indices.push_back(index);
+		}
+
+		Out.Attributes.push_back(this->Materials[t]);
+	}
+}
+
+//	Function to find how far the simplified mesh strays from the original, as the
+//	furthest distance from any original point to the nearest triangle left.  Every
+//	triangle is checked for every point, which is slow but only done when cooking.  
+//////////////////////////////////////////////////////////////////////////////////////////
+float MeshSimplifier::MeasureError(const MeshData& Out)
+{
+	float worst = 0.0f;
+
+	for (unsigned int p = 0 ; p < this->FirstVertex.size() ; p++)
+	{
+		const float* Point = &this->Points[p * 3];
+		float nearest = -1.0f;
+
+		for (unsigned int t = 0 ; t < Out.Attributes.size() ; t++)
+		{
+			float distance = TriangleDistance(Point, Out.Vertices[Out.Indices[t * 3]].position,
+											  Out.Vertices[Out.Indices[t * 3 + 1]].position,
+											  Out.Vertices[Out.Indices[t * 3 + 2]].position);
+			if ((nearest < 0.0f) || (distance < nearest))
+				nearest = distance;
+		}
+
+		if (nearest > worst)
+			worst = nearest;
+	}
+
+	return sqrtf(worst);
+}
\ No newline at end of file
@@ -0,0 +1,296 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	NULL BACKEND MODULE																	//
+//	A backend that draws nothing, & only counts what it is asked to do: the calls of	//
+//	each kind, the triangles drawn, the command bytes handed to it, & how many of the	//
+//	calls setting a state, transform, material or light changed anything.  This lets	//
+//	the draw calls & state changes of each frame be tracked without a graphics card.	//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "NullBackend.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <string.h>			// Standard memory functions.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Class constructor.  Nothing is set to start with, so the first time each setting is
+//	made always counts as a change.  
+//////////////////////////////////////////////////////////////////////////////////////////
+NullBackend::NullBackend(int width, int height)
+{
+	this->width = width;
+	this->height = height;
+
+	for (int i = 0 ; i < TRANSFORM_COUNT ; i++)
+	{
+		Transforms[i] = Matrix::Identity();
+		setTransform[i] = false;
+	}
+	for (int i = 0 ; i < STATE_COUNT ; i++)
+	{
+		States[i] = 0;
+		setState[i] = false;
+	}
+
+	memset(&Material, 0, sizeof(Material));
+	memset(&Lamp, 0, sizeof(Lamp));
+	this->setMaterial = false;
+	this->setLight = false;
+
+	this->ResetStats();
+}
+
+//	Function to report what the backend is.  
+//////////////////////////////////////////////////////////////////////////////////////////
+const char* NullBackend::GetName()
+{
+	return "Null";
+}
+
+//	Function to report the width of the frame in pixels.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int NullBackend::GetWidth()
+{
+	return this->width;
+}
+
+//	Function to report the height of the frame in pixels.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int NullBackend::GetHeight()
+{
+	return this->height;
+}
+
+//	Function to make a mesh, keeping only the number of faces in each subset so that the
+//	triangles drawn can be counted.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int NullBackend::CreateMesh(const MeshView& Level)
+{
+	std::vector<unsigned int> Faces;
+	for (unsigned int f = 0 ; f < Level.numFaces ; f++)
+	{
+		if (Level.Attributes[f] >= Faces.size())
+			Faces.resize(Level.Attributes[f] + 1, 0);
+		Faces[Level.Attributes[f]]++;
+	}
+
+	Subsets.push_back(Faces);
+	return (int)Subsets.size() - 1;
+}
+
+//	Function to forget a mesh.  Its number isn't handed out again.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void NullBackend::DestroyMesh(int mesh)
+{
+	if ((mesh >= 0) && (mesh < (int)Subsets.size()))
+		std::vector<unsigned int>().swap(Subsets[mesh]);
+}
+
+//	Function to report the number of triangles in a mesh.  
+//////////////////////////////////////////////////////////////////////////////////////////
+unsigned int NullBackend::GetFaceCount(int mesh)
+{
+	if ((mesh < 0) || (mesh >= (int)Subsets.size()))
+		return 0;
+
+	unsigned int faces = 0;
+	for (size_t s = 0 ; s < Subsets[mesh].size() ; s++)
+		faces += Subsets[mesh][s];
+	return faces;
+}
+
+//	Function to report the memory a mesh takes up, which is none.  
+//////////////////////////////////////////////////////////////////////////////////////////
+size_t NullBackend::GetMeshBytes(int)
+{
+	return 0;
+}
+
+//	Function to count the start of a frame.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void NullBackend::BeginScene()
+{
+	this->Count(COMMAND_BEGIN, true);
+}
+
+//	Function to count the end of drawing a frame.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void NullBackend::EndScene()
+{
+	this->Count(COMMAND_END, true);
+}
+
+//	Function to finish a frame, keeping its counts & adding them to the totals.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void NullBackend::Present()
+{
+	this->Count(COMMAND_PRESENT, true);
+	Current.frames = 1;
+
+	for (int i = 0 ; i < COMMAND_COUNT ; i++)
+		Total.calls[i] += Current.calls[i];
+	Total.triangles += Current.triangles;
+	Total.bytes += Current.bytes;
+	Total.changes += Current.changes;
+	Total.redundant += Current.redundant;
+	Total.frames++;
+
+	Frame = Current;
+	memset(&Current, 0, sizeof(Current));
+}
+
+//	Function to count a clear.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void NullBackend::Clear(unsigned int, unsigned int, float, unsigned int)
+{
+	this->Count(COMMAND_CLEAR, true);
+}
+
+//	Function to count a transform, & whether it differs from the one set.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void NullBackend::SetTransform(int type, const Matrix& Transform)
+{
+	if ((type < 0) || (type >= TRANSFORM_COUNT))
+		return;
+
+	bool changed = !setTransform[type] ||
+				   (memcmp(&Transforms[type], &Transform, sizeof(Matrix)) != 0);
+	Transforms[type] = Transform;
+	setTransform[type] = true;
+
+	this->Count(COMMAND_TRANSFORM, changed);
+}
+
+//	Function to report one of the transforms.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void NullBackend::GetTransform(int type, Matrix& Transform)
+{
+	if ((type >= 0) && (type < TRANSFORM_COUNT))
+		Transform = Transforms[type];
+}
+
+//	Function to count a material, & whether it differs from the one set.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void NullBackend::SetMaterial(const RenderMaterial& Material)
+{
+	bool changed = !setMaterial || (memcmp(&this->Material, &Material, sizeof(Material)) != 0);
+	this->Material = Material;
+	this->setMaterial = true;
+
+	this->Count(COMMAND_MATERIAL, changed);
+}
+
+//	Function to count a light, & whether it differs from the one set.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void NullBackend::SetLight(const RenderLight& Light)
+{
+	bool changed = !setLight || (memcmp(&Lamp, &Light, sizeof(Light)) != 0);
+	this->Lamp = Light;
+	this->setLight = true;
+
+	this->Count(COMMAND_LIGHT, changed);
+}
+
+//	Function to count a render state, & whether it differs from the one set.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void NullBackend::SetRenderState(int state, unsigned int value)
+{
+	if ((state < 0) || (state >= STATE_COUNT))
+		return;
+
+	bool changed = !setState[state] || (States[state] != value);
+	States[state] = value;
+	setState[state] = true;
+
+	this->Count(COMMAND_STATE, changed);
+}
+
+//	Function to count a draw & the triangles in it.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void NullBackend::DrawSubset(int mesh, unsigned int subset)
+{
+	this->Count(COMMAND_DRAW, true);
+
+	if ((mesh >= 0) && (mesh < (int)Subsets.size()) && (subset < Subsets[mesh].size()))
+		Current.triangles += Subsets[mesh][subset];
+}
+
+//	Function to count the bytes of a command buffer about to be submitted.  They are
+//	counted towards the frame being drawn, so a buffer should hold a frame at most.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void NullBackend::CountBytes(size_t bytes)
+{
+	Current.bytes += bytes;
+}
+
+//	Function to start the counts afresh, without forgetting what is set.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void NullBackend::ResetStats()
+{
+	memset(&Current, 0, sizeof(Current));
+	memset(&Frame, 0, sizeof(Frame));
+	memset(&Total, 0, sizeof(Total));
+}
+
+//	Function to report the counts of the last frame presented.  
+//////////////////////////////////////////////////////////////////////////////////////////
+const DrawStats& NullBackend::GetFrame()
+{
+	return this->Frame;
+}
+
+//	Function to report the counts of every frame presented since the counts were reset.  
+//////////////////////////////////////////////////////////////////////////////////////////
+const DrawStats& NullBackend::GetTotal()
+{
+	return this->Total;
+}
+
+//	Function to add up the calls of every kind.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int NullBackend::GetCallCount(const DrawStats& Stats)
+{
+	int calls = 0;
+	for (int i = 0 ; i < COMMAND_COUNT ; i++)
+		calls += Stats.calls[i];
+	return calls;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PRIVATE METHODS
+//	Methods called from within the class for better organisation of the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to count a call.  Only the calls that set something are counted as changes
+//	or as redundant; beginning, ending, presenting, clearing & drawing are neither.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void NullBackend::Count(int command, bool changed)
+{
+	Current.calls[command]++;
+
+	if ((command == COMMAND_TRANSFORM) || (command == COMMAND_MATERIAL) ||
+		(command == COMMAND_LIGHT) || (command == COMMAND_STATE))
+	{
+		if (changed)
+			Current.changes++;
+		else
+			Current.redundant++;
+	}
+}
\ No newline at end of file
@@ -0,0 +1,197 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	RANDOM STREAM MODULE																//
+//	Seeded random number streams for the game's colour picking.  Each stream is a		//
+//	xoshiro256** generator holding all of its state itself, so any number of sessions	//
+//	can draw numbers at once without sharing anything, and a session started from the	//
+//	same seed always sees the same numbers.  Streams can be told apart either by a		//
+//	stream number mixed into the seed, or by jumping a stream 2^128 or 2^192 steps		//
+//	ahead, which guarantees they never overlap.											//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "Random.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DATA
+//	The jump polynomials for xoshiro256**.  
+//////////////////////////////////////////////////////////////////////////////////////////
+static const unsigned long long JUMP[4] =
+	{ 0x180ec6d33cfd0abaULL, 0xd5a61266f0c9392cULL, 0xa9582618e03fc9aaULL, 0x39abdc4529b1661cULL };
+static const unsigned long long LONG_JUMP[4] =
+	{ 0x76e15d3efefdcbbfULL, 0xc5004e441c522fb3ULL, 0x77710069854ee241ULL, 0x39109bb02acbe635ULL };
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE FUNCTIONS
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to rotate a 64-bit value left by the given number of bits.  
+//////////////////////////////////////////////////////////////////////////////////////////
+static inline unsigned long long RotateLeft(unsigned long long x, int k)
+{
+	return (x << k) | (x >> (64 - k));
+}
+
+//	Function to step a SplitMix64 generator, used to spread a seed over the full state.  
+//////////////////////////////////////////////////////////////////////////////////////////
+static inline unsigned long long SplitMix(unsigned long long& x)
+{
+	unsigned long long z = (x += 0x9e3779b97f4a7c15ULL);
+	z = (z ^ (z >> 30)) * 0xbf58476d1ce4e5b9ULL;
+	z = (z ^ (z >> 27)) * 0x94d049bb133111ebULL;
+	return z ^ (z >> 31);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Class constructor.  Seeds the stream with 0.  
+//////////////////////////////////////////////////////////////////////////////////////////
+RandomStream::RandomStream()
+{
+	this->Seed(0, 0);
+}
+
+//	Class constructor.  Seeds the stream with the given seed.  
+//////////////////////////////////////////////////////////////////////////////////////////
+RandomStream::RandomStream(unsigned long long seed)
+{
+	this->Seed(seed, 0);
+}
+
+//	Class constructor.  Seeds the stream with the given seed & stream number.  
+//////////////////////////////////////////////////////////////////////////////////////////
+RandomStream::RandomStream(unsigned long long seed, unsigned long long stream)
+{
+	this->Seed(seed, stream);
+}
+
+//	Function to reseed the stream.  The stream number is hashed into the seed, so
+//	stream n of a seed can be made straight away without stepping through the streams
+//	before it; this is how each session in a batch gets its own numbers from nothing
+//	more than the batch seed & its own index.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void RandomStream::Seed(unsigned long long seed, unsigned long long stream)
+{
+	unsigned long long mix = stream;
+	unsigned long long x = seed ^ SplitMix(mix);
+
+	for (int i = 0 ; i < 4 ; i++)
+		s[i] = SplitMix(x);
+}
+
+//	Function to generate the next value in the stream.  
+//////////////////////////////////////////////////////////////////////////////////////////
+unsigned long long RandomStream::Next()
+{
+	unsigned long long result = RotateLeft(s[1] * 5, 7) * 9;
+	unsigned long long t = s[1] << 17;
+
+	s[2] ^= s[0];
+	s[3] ^= s[1];
+	s[1] ^= s[2];
+	s[0] ^= s[3];
+	s[2] ^= t;
+	s[3] = RotateLeft(s[3], 45);
+
+	return result;
+}
+
+//	Function to generate a value from 0 to n - 1 with every value equally likely.  The
+//	top 32 bits are scaled by n, and the rare values that would favour the low end of
+//	the range are thrown away & drawn again.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int RandomStream::Below(int n)
+{
+	unsigned int range = (unsigned int)n;
+	unsigned long long m = (this->Next() >> 32) * range;
+
+	if ((unsigned int)m < range)
+	{
+		unsigned int threshold = (0u - range) % range;
+		while ((unsigned int)m < threshold)
+			m = (this->Next() >> 32) * range;
+	}
+
+	return (int)(m >> 32);
+}
+
+//	Function to move the stream 2^128 values ahead.  Jumping a copy of a stream gives
+//	2^128 non-overlapping streams from a single seed.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void RandomStream::Jump()
+{
+	this->Apply(JUMP);
+}
+
+//	Function to move the stream 2^192 values ahead, for splitting off groups of streams
+//	that can each then be split again with Jump().  
+//////////////////////////////////////////////////////////////////////////////////////////
+void RandomStream::LongJump()
+{
+	this->Apply(LONG_JUMP);
+}
+
+//	Function to set the generator's raw state, for checking it against the reference
+//	outputs.  The state must not be all zeroes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void RandomStream::SetState(const unsigned long long* State)
+{
+	for (int i = 0 ; i < 4 ; i++)
+		s[i] = State[i];
+}
+
+//	Function to give the stream of the numbered worker: the seed's stream long jumped
+//	once for each worker before it.  A worker's stream only depends on the seed & its
+//	number, never on which thread asked first, & as it is handed back by value each
+//	worker draws from its own copy without any locking.  Each stream is 2^192 values
+//	long, so none of them can ever run into the next.  Working out stream n takes n
+//	jumps, so when many are needed in order, long jump a single copy along instead.  
+//////////////////////////////////////////////////////////////////////////////////////////
+RandomStream RandomStream::ForWorker(unsigned long long seed, int worker)
+{
+	RandomStream Stream(seed);
+	for (int i = 0 ; i < worker ; i++)
+		Stream.LongJump();
+	return Stream;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PRIVATE METHODS
+//	Methods called from within the class for better organisation of the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to move the stream ahead by the distance the given jump polynomial stands
+//	for.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void RandomStream::Apply(const unsigned long long* Polynomial)
+{
+	unsigned long long t[4] = { 0, 0, 0, 0 };
+
+	for (int i = 0 ; i < 4 ; i++)
+		for (int b = 0 ; b < 64 ; b++)
+		{
+			if (Polynomial[i] & (1ULL << b))
+			{
+				t[0] ^= s[0];
+				t[1] ^= s[1];
+				t[2] ^= s[2];
+				t[3] ^= s[3];
+			}
+			this->Next();
+		}
+
+	for (int i = 0 ; i < 4 ; i++)
+		s[i] = t[i];
+}
\ No newline at end of file
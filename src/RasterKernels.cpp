@@ -0,0 +1,539 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	RASTER KERNELS MODULE																//
+//	The inner loops of the software backend, which fill in one triangle within one		//
+//	tile.  The plain C++ kernel checks a pixel at a time & is kept as the reference the	//
+//	others are measured against; the SSE2 & AVX2 kernels check 4 & 8 pixels at a time,	//
+//	giving exactly the same pixels as the plain one.  The fastest kernel the processor	//
+//	can run is picked when the program starts.											//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "RasterKernels.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  The vector kernels are only
+//	built for x86 processors; elsewhere the plain kernel is all there is.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <string.h>			// Standard memory functions.  
+
+#if defined(_M_IX86) || defined(_M_X64) || defined(__i386__) || defined(__x86_64__)
+	#define RASTER_X86
+	#include <emmintrin.h>		// SSE2 intrinsics.  
+	#include <immintrin.h>		// AVX2 intrinsics.  
+	#ifdef _MSC_VER
+		#include <intrin.h>		// Visual C++'s CPUID intrinsics.  
+	#endif
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	Visual C++ lets any function use AVX2, but GCC & Clang must be told which ones may.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#if defined(__GNUC__)
+	#define TARGET_AVX2		__attribute__((target("avx2")))
+#else
+	#define TARGET_AVX2
+#endif
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to pick the fastest kernel the processor can run.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int RasterKernels::GetBest()
+{
+	for (int kernel = RASTER_KERNELS - 1 ; kernel > RASTER_SCALAR ; kernel--)
+		if (RasterKernels::IsSupported(kernel))
+			return kernel;
+	return RASTER_SCALAR;
+}
+
+//	Function to check whether the processor can run a kernel.  AVX2 needs the operating
+//	system to save the wider registers as well as the processor to have it.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool RasterKernels::IsSupported(int kernel)
+{
+	if (kernel == RASTER_SCALAR)
+		return true;
+
+#if defined(RASTER_X86) && defined(_MSC_VER)
+	int Info[4];
+	__cpuid(Info, 0);
+	int highest = Info[0];
+
+	__cpuid(Info, 1);
+	if (kernel == RASTER_SSE2)
+		return (Info[3] & (1 << 26)) != 0;
+
+	if (kernel == RASTER_AVX2)
+	{
+		bool saved = (Info[2] & (1 << 27)) && (Info[2] & (1 << 28)) &&
+					 ((_xgetbv(0) & 0x6) == 0x6);
+		if (!saved || (highest < 7))
+			return false;
+
+		__cpuidex(Info, 7, 0);
+		return (Info[1] & (1 << 5)) != 0;
+	}
+#elif defined(RASTER_X86)
+	if (kernel == RASTER_SSE2)
+		return __builtin_cpu_supports("sse2") != 0;
+	if (kernel == RASTER_AVX2)
+		return __builtin_cpu_supports("avx2") != 0;
+#endif
+
+	return false;
+}
+
+//	Function to report the function for a kernel, or the plain kernel if it can't run.  
+//////////////////////////////////////////////////////////////////////////////////////////
+RasterKernel RasterKernels::Get(int kernel)
+{
+	if (!RasterKernels::IsSupported(kernel))
+		return &RasterKernels::FillScalar;
+
+	switch (kernel)
+	{
+		case RASTER_SSE2:	return &RasterKernels::FillSSE2;
+		case RASTER_AVX2:	return &RasterKernels::FillAVX2;
+	}
+	return &RasterKernels::FillScalar;
+}
+
+//	Function to report a kernel's name.  
+//////////////////////////////////////////////////////////////////////////////////////////
+const char* RasterKernels::GetName(int kernel)
+{
+	switch (kernel)
+	{
+		case RASTER_SCALAR:	return "scalar";
+		case RASTER_SSE2:	return "sse2";
+		case RASTER_AVX2:	return "avx2";
+	}
+	return "unknown";
+}
+
+//	Function to report the pixels a kernel checks at a time.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int RasterKernels::GetLanes(int kernel)
+{
+	switch (kernel)
+	{
+		case RASTER_SSE2:	return 4;
+		case RASTER_AVX2:	return 8;
+	}
+	return 1;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PRIVATE METHODS
+//	Methods called from within the class for better organisation of the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to fill in a single pixel, reporting 1 if it lies inside the triangle.  The
+//	pixel's centre is checked against each edge; an edge passing exactly through the
+//	centre only takes the pixel if it is a top or left edge.  The stencil is tested
+//	before the depth, & only counted up if both pass.  Pixels pass the depth test if they
+//	are no further than the depth held, and blended pixels are mixed with what is there
+//	by their alpha.  Every kernel works each value out in this same order, so
+//	that they all round alike & give exactly the same pixels.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int RasterKernels::FillPixel(const RasterJob& Job, int x, int y)
+{
+	float px = (x - Job.x0) + 0.5f;
+	float py = (y - Job.y0) + 0.5f;
+
+	for (int e = 0 ; e < 3 ; e++)
+	{
+		float d = Job.Edges[e][2] + Job.Edges[e][0] * px + Job.Edges[e][1] * py;
+		if (!((d > 0.0f) || ((d == 0.0f) && Job.topLeft[e])))
+			return 0;
+	}
+
+	int pixel = y * Job.width + x;
+	const float (*Plane)[3] = Job.Planes;
+
+	if (Job.stencil && (Job.Stencil[pixel] != 0))
+		return 1;
+
+	float z = Plane[0][2] + Plane[0][0] * px + Plane[0][1] * py;
+	if (Job.depth)
+	{
+		if (z > Job.Depth[pixel])
+			return 1;
+		Job.Depth[pixel] = z;
+	}
+
+	if (Job.stencil)
+		Job.Stencil[pixel]++;
+
+	// Takes the colour back out of perspective.  
+	float w = 1.0f / (Plane[1][2] + Plane[1][0] * px + Plane[1][1] * py);
+	float r = (Plane[2][2] + Plane[2][0] * px + Plane[2][1] * py) * w;
+	float g = (Plane[3][2] + Plane[3][0] * px + Plane[3][1] * py) * w;
+	float b = (Plane[4][2] + Plane[4][0] * px + Plane[4][1] * py) * w;
+	float a = (Plane[5][2] + Plane[5][0] * px + Plane[5][1] * py) * w;
+
+	r *= 255.0f;	g *= 255.0f;	b *= 255.0f;
+
+	if (Job.blend)
+	{
+		unsigned int held = Job.Colour[pixel];
+		r = r * a + ((held >> 16) & 0xff) * (1.0f - a);
+		g = g * a + ((held >> 8) & 0xff) * (1.0f - a);
+		b = b * a + (held & 0xff) * (1.0f - a);
+	}
+
+	int ir = (int)(r + 0.5f), ig = (int)(g + 0.5f), ib = (int)(b + 0.5f);
+	ir = (ir < 0) ? 0 : ((ir > 255) ? 255 : ir);
+	ig = (ig < 0) ? 0 : ((ig > 255) ? 255 : ig);
+	ib = (ib < 0) ? 0 : ((ib > 255) ? 255 : ib);
+
+	Job.Colour[pixel] = (ir << 16) | (ig << 8) | ib;
+	return 1;
+}
+
+//	Function to fill in a job a pixel at a time.  This is the reference the vector
+//	kernels are checked against.  
+//////////////////////////////////////////////////////////////////////////////////////////
+long long RasterKernels::FillScalar(const RasterJob& Job)
+{
+	long long filled = 0;
+
+	for (int y = Job.top ; y <= Job.bottom ; y++)
+		for (int x = Job.left ; x <= Job.right ; x++)
+			filled += RasterKernels::FillPixel(Job, x, y);
+
+	return filled;
+}
+
+#ifdef RASTER_X86
+
+//	Function to fill in a job four pixels at a time with SSE2.  Each group of pixels is
+//	checked against the edges at once, and the groups with none inside are passed over.  
+//	The colours & depths of the pixels inside are worked out together & written back
+//	through a mask.  The groups are lined up with the tile's corner, so a group never
+//	reaches into a tile another worker is filling.  Any pixels left at the end of a row
+//	that would run off the buffer are filled a pixel at a time.  
+//////////////////////////////////////////////////////////////////////////////////////////
+long long RasterKernels::FillSSE2(const RasterJob& Job)
+{
+	const __m128 Lanes = _mm_setr_ps(0.5f, 1.5f, 2.5f, 3.5f);
+	const __m128i Index = _mm_setr_epi32(0, 1, 2, 3);
+	const __m128 Zero = _mm_setzero_ps();
+	const __m128 One = _mm_set1_ps(1.0f);
+	const __m128 Half = _mm_set1_ps(0.5f);
+	const __m128 Full = _mm_set1_ps(255.0f);
+	const __m128i Byte = _mm_set1_epi32(0xff);
+	const __m128i Nothing = _mm_setzero_si128();
+
+	__m128 EdgeA[3], EdgeB[3], EdgeC[3], TopLeft[3];
+	for (int e = 0 ; e < 3 ; e++)
+	{
+		EdgeA[e] = _mm_set1_ps(Job.Edges[e][0]);
+		EdgeB[e] = _mm_set1_ps(Job.Edges[e][1]);
+		EdgeC[e] = _mm_set1_ps(Job.Edges[e][2]);
+		TopLeft[e] = _mm_castsi128_ps(_mm_set1_epi32(Job.topLeft[e] ? -1 : 0));
+	}
+
+	__m128 PlaneA[6], PlaneB[6], PlaneC[6];
+	for (int v = 0 ; v < 6 ; v++)
+	{
+		PlaneA[v] = _mm_set1_ps(Job.Planes[v][0]);
+		PlaneB[v] = _mm_set1_ps(Job.Planes[v][1]);
+		PlaneC[v] = _mm_set1_ps(Job.Planes[v][2]);
+	}
+
+	long long filled = 0;
+
+	for (int y = Job.top ; y <= Job.bottom ; y++)
+	{
+		__m128 py = _mm_set1_ps((y - Job.y0) + 0.5f);
+
+		// Lines the groups up with the tile's corner, so they never leave it.  
+		int x = Job.x0 + ((Job.left - Job.x0) & ~3);
+
+		for ( ; (x <= Job.right) && (x + 4 <= Job.width) ; x += 4)
+		{
+			__m128 px = _mm_add_ps(_mm_set1_ps((float)(x - Job.x0)), Lanes);
+
+			// Checks each pixel's centre against the edges & both ends of the row.  
+			__m128 Inside = _mm_castsi128_ps(_mm_andnot_si128(
+								_mm_cmpgt_epi32(_mm_set1_epi32(Job.left - x), Index),
+								_mm_cmpgt_epi32(_mm_set1_epi32(Job.right - x + 1),
+												Index)));
+			for (int e = 0 ; e < 3 ; e++)
+			{
+				__m128 d = _mm_add_ps(_mm_add_ps(EdgeC[e], _mm_mul_ps(EdgeA[e], px)),
+									  _mm_mul_ps(EdgeB[e], py));
+				__m128 In = _mm_or_ps(_mm_cmpgt_ps(d, Zero),
+									  _mm_and_ps(_mm_cmpeq_ps(d, Zero), TopLeft[e]));
+				Inside = _mm_and_ps(Inside, In);
+			}
+
+			int bits = _mm_movemask_ps(Inside);
+			if (!bits)
+				continue;
+			for ( ; bits ; bits &= bits - 1)
+				filled++;
+
+			int pixel = y * Job.width + x;
+			__m128 Pass = Inside;
+			__m128i Marks = Nothing;
+
+			if (Job.stencil)
+			{
+				int held;
+				memcpy(&held, Job.Stencil + pixel, sizeof(held));
+				Marks = _mm_unpacklo_epi16(_mm_unpacklo_epi8(_mm_cvtsi32_si128(held), Nothing),
+										   Nothing);
+				Pass = _mm_and_ps(Pass, _mm_castsi128_ps(_mm_cmpeq_epi32(Marks, Nothing)));
+				if (!_mm_movemask_ps(Pass))
+					continue;
+			}
+
+			if (Job.depth)
+			{
+				__m128 z = _mm_add_ps(_mm_add_ps(PlaneC[0], _mm_mul_ps(PlaneA[0], px)),
+									  _mm_mul_ps(PlaneB[0], py));
+				__m128 Held = _mm_loadu_ps(Job.Depth + pixel);
+				Pass = _mm_and_ps(Pass, _mm_cmple_ps(z, Held));
+				if (!_mm_movemask_ps(Pass))
+					continue;
+
+				_mm_storeu_ps(Job.Depth + pixel,
+							  _mm_or_ps(_mm_and_ps(Pass, z), _mm_andnot_ps(Pass, Held)));
+			}
+
+			// Counts up the stencil of each pixel drawn; the mask is -1 in those lanes.  
+			if (Job.stencil)
+			{
+				Marks = _mm_and_si128(_mm_sub_epi32(Marks, _mm_castps_si128(Pass)), Byte);
+				Marks = _mm_packs_epi32(Marks, Marks);
+				int held = _mm_cvtsi128_si32(_mm_packus_epi16(Marks, Marks));
+				memcpy(Job.Stencil + pixel, &held, sizeof(held));
+			}
+
+			// Takes the colour back out of perspective.  
+			__m128 Value[6];
+			for (int v = 1 ; v < 6 ; v++)
+				Value[v] = _mm_add_ps(_mm_add_ps(PlaneC[v], _mm_mul_ps(PlaneA[v], px)),
+									  _mm_mul_ps(PlaneB[v], py));
+
+			__m128 w = _mm_div_ps(One, Value[1]);
+			__m128 r = _mm_mul_ps(_mm_mul_ps(Value[2], w), Full);
+			__m128 g = _mm_mul_ps(_mm_mul_ps(Value[3], w), Full);
+			__m128 b = _mm_mul_ps(_mm_mul_ps(Value[4], w), Full);
+
+			__m128i Held = _mm_loadu_si128((const __m128i*)(Job.Colour + pixel));
+
+			if (Job.blend)
+			{
+				__m128 a = _mm_mul_ps(Value[5], w);
+				__m128 Rest = _mm_sub_ps(One, a);
+
+				__m128 hr = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(Held, 16), Byte));
+				__m128 hg = _mm_cvtepi32_ps(_mm_and_si128(_mm_srli_epi32(Held, 8), Byte));
+				__m128 hb = _mm_cvtepi32_ps(_mm_and_si128(Held, Byte));
+
+				r = _mm_add_ps(_mm_mul_ps(r, a), _mm_mul_ps(hr, Rest));
+				g = _mm_add_ps(_mm_mul_ps(g, a), _mm_mul_ps(hg, Rest));
+				b = _mm_add_ps(_mm_mul_ps(b, a), _mm_mul_ps(hb, Rest));
+			}
+
+			// Rounds & clamps each channel, which gives the same as clamping afterwards.  
+			__m128i ir = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_add_ps(r, Half), Zero), Full));
+			__m128i ig = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_add_ps(g, Half), Zero), Full));
+			__m128i ib = _mm_cvttps_epi32(_mm_min_ps(_mm_max_ps(_mm_add_ps(b, Half), Zero), Full));
+
+			__m128i Out = _mm_or_si128(_mm_or_si128(_mm_slli_epi32(ir, 16),
+													_mm_slli_epi32(ig, 8)), ib);
+			__m128i Mask = _mm_castps_si128(Pass);
+
+			_mm_storeu_si128((__m128i*)(Job.Colour + pixel),
+							 _mm_or_si128(_mm_and_si128(Mask, Out), _mm_andnot_si128(Mask, Held)));
+		}
+
+		for (x = (x > Job.left) ? x : Job.left ; x <= Job.right ; x++)
+			filled += RasterKernels::FillPixel(Job, x, y);
+	}
+
+	return filled;
+}
+
+//	Function to fill in a job eight pixels at a time with AVX2, in the same way as the
+//	SSE2 kernel.  
+//////////////////////////////////////////////////////////////////////////////////////////
+TARGET_AVX2 long long RasterKernels::FillAVX2(const RasterJob& Job)
+{
+	const __m256 Lanes = _mm256_setr_ps(0.5f, 1.5f, 2.5f, 3.5f, 4.5f, 5.5f, 6.5f, 7.5f);
+	const __m256i Index = _mm256_setr_epi32(0, 1, 2, 3, 4, 5, 6, 7);
+	const __m256 Zero = _mm256_setzero_ps();
+	const __m256 One = _mm256_set1_ps(1.0f);
+	const __m256 Half = _mm256_set1_ps(0.5f);
+	const __m256 Full = _mm256_set1_ps(255.0f);
+	const __m256i Byte = _mm256_set1_epi32(0xff);
+
+	__m256 EdgeA[3], EdgeB[3], EdgeC[3], TopLeft[3];
+	for (int e = 0 ; e < 3 ; e++)
+	{
+		EdgeA[e] = _mm256_set1_ps(Job.Edges[e][0]);
+		EdgeB[e] = _mm256_set1_ps(Job.Edges[e][1]);
+		EdgeC[e] = _mm256_set1_ps(Job.Edges[e][2]);
+		TopLeft[e] = _mm256_castsi256_ps(_mm256_set1_epi32(Job.topLeft[e] ? -1 : 0));
+	}
+
+	__m256 PlaneA[6], PlaneB[6], PlaneC[6];
+	for (int v = 0 ; v < 6 ; v++)
+	{
+		PlaneA[v] = _mm256_set1_ps(Job.Planes[v][0]);
+		PlaneB[v] = _mm256_set1_ps(Job.Planes[v][1]);
+		PlaneC[v] = _mm256_set1_ps(Job.Planes[v][2]);
+	}
+
+	long long filled = 0;
+
+	for (int y = Job.top ; y <= Job.bottom ; y++)
+	{
+		__m256 py = _mm256_set1_ps((y - Job.y0) + 0.5f);
+
+		// Lines the groups up with the tile's corner, so they never leave it.  
+		int x = Job.x0 + ((Job.left - Job.x0) & ~7);
+
+		for ( ; (x <= Job.right) && (x + 8 <= Job.width) ; x += 8)
+		{
+			__m256 px = _mm256_add_ps(_mm256_set1_ps((float)(x - Job.x0)), Lanes);
+
+			// Checks each pixel's centre against the edges & both ends of the row.  
+			__m256 Inside = _mm256_castsi256_ps(_mm256_andnot_si256(
+								_mm256_cmpgt_epi32(_mm256_set1_epi32(Job.left - x), Index),
+								_mm256_cmpgt_epi32(_mm256_set1_epi32(Job.right - x + 1),
+												   Index)));
+			for (int e = 0 ; e < 3 ; e++)
+			{
+				__m256 d = _mm256_add_ps(_mm256_add_ps(EdgeC[e], _mm256_mul_ps(EdgeA[e], px)),
+										 _mm256_mul_ps(EdgeB[e], py));
+				__m256 In = _mm256_or_ps(_mm256_cmp_ps(d, Zero, _CMP_GT_OQ),
+										 _mm256_and_ps(_mm256_cmp_ps(d, Zero, _CMP_EQ_OQ),
+													   TopLeft[e]));
+				Inside = _mm256_and_ps(Inside, In);
+			}
+
+			int bits = _mm256_movemask_ps(Inside);
+			if (!bits)
+				continue;
+			for ( ; bits ; bits &= bits - 1)
+				filled++;
+
+			int pixel = y * Job.width + x;
+			__m256 Pass = Inside;
+			__m256i Marks = _mm256_setzero_si256();
+
+			if (Job.stencil)
+			{
+				Marks = _mm256_cvtepu8_epi32(_mm_loadl_epi64((const __m128i*)(Job.Stencil + pixel)));
+				Pass = _mm256_and_ps(Pass, _mm256_castsi256_ps(
+										_mm256_cmpeq_epi32(Marks, _mm256_setzero_si256())));
+				if (!_mm256_movemask_ps(Pass))
+					continue;
+			}
+
+			if (Job.depth)
+			{
+				__m256 z = _mm256_add_ps(_mm256_add_ps(PlaneC[0], _mm256_mul_ps(PlaneA[0], px)),
+										 _mm256_mul_ps(PlaneB[0], py));
+				__m256 Held = _mm256_loadu_ps(Job.Depth + pixel);
+				Pass = _mm256_and_ps(Pass, _mm256_cmp_ps(z, Held, _CMP_LE_OQ));
+				if (!_mm256_movemask_ps(Pass))
+					continue;
+
+				_mm256_storeu_ps(Job.Depth + pixel, _mm256_blendv_ps(Held, z, Pass));
+			}
+
+			// Counts up the stencil of each pixel drawn; the mask is -1 in those lanes.  
+			if (Job.stencil)
+			{
+				Marks = _mm256_and_si256(_mm256_sub_epi32(Marks, _mm256_castps_si256(Pass)), Byte);
+				__m128i Narrow = _mm_packs_epi32(_mm256_castsi256_si128(Marks),
+											     _mm256_extracti128_si256(Marks, 1));
+				_mm_storel_epi64((__m128i*)(Job.Stencil + pixel), _mm_packus_epi16(Narrow, Narrow));
+			}
+
+			// Takes the colour back out of perspective.  
+			__m256 Value[6];
+			for (int v = 1 ; v < 6 ; v++)
+				Value[v] = _mm256_add_ps(_mm256_add_ps(PlaneC[v], _mm256_mul_ps(PlaneA[v], px)),
+										 _mm256_mul_ps(PlaneB[v], py));
+
+			__m256 w = _mm256_div_ps(One, Value[1]);
+			__m256 r = _mm256_mul_ps(_mm256_mul_ps(Value[2], w), Full);
+			__m256 g = _mm256_mul_ps(_mm256_mul_ps(Value[3], w), Full);
+			__m256 b = _mm256_mul_ps(_mm256_mul_ps(Value[4], w), Full);
+
+			__m256i Held = _mm256_loadu_si256((const __m256i*)(Job.Colour + pixel));
+
+			if (Job.blend)
+			{
+				__m256 a = _mm256_mul_ps(Value[5], w);
+				__m256 Rest = _mm256_sub_ps(One, a);
+
+				__m256 hr = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(Held, 16), Byte));
+				__m256 hg = _mm256_cvtepi32_ps(_mm256_and_si256(_mm256_srli_epi32(Held, 8), Byte));
+				__m256 hb = _mm256_cvtepi32_ps(_mm256_and_si256(Held, Byte));
+
+				r = _mm256_add_ps(_mm256_mul_ps(r, a), _mm256_mul_ps(hr, Rest));
+				g = _mm256_add_ps(_mm256_mul_ps(g, a), _mm256_mul_ps(hg, Rest));
+				b = _mm256_add_ps(_mm256_mul_ps(b, a), _mm256_mul_ps(hb, Rest));
+			}
+
+			// Rounds & clamps each channel, which gives the same as clamping afterwards.  
+			__m256i ir = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(
+								_mm256_add_ps(r, Half), Zero), Full));
+			__m256i ig = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(
+								_mm256_add_ps(g, Half), Zero), Full));
+			__m256i ib = _mm256_cvttps_epi32(_mm256_min_ps(_mm256_max_ps(
+								_mm256_add_ps(b, Half), Zero), Full));
+
+			__m256i Out = _mm256_or_si256(_mm256_or_si256(_mm256_slli_epi32(ir, 16),
+														  _mm256_slli_epi32(ig, 8)), ib);
+
+			_mm256_storeu_si256((__m256i*)(Job.Colour + pixel),
+								_mm256_blendv_epi8(Held, Out, _mm256_castps_si256(Pass)));
+		}
+
+		for (x = (x > Job.left) ? x : Job.left ; x <= Job.right ; x++)
+			filled += RasterKernels::FillPixel(Job, x, y);
+	}
+
+	return filled;
+}
+
+#else
+
+//	Without x86 vector units the vector kernels fall back on the plain one, though they
+//	are never picked.  
+//////////////////////////////////////////////////////////////////////////////////////////
+long long RasterKernels::FillSSE2(const RasterJob& Job)
+{
+	return RasterKernels::FillScalar(Job);
+}
+
+long long RasterKernels::FillAVX2(const RasterJob& Job)
+{
+	return RasterKernels::FillScalar(Job);
+}
+
+#endif
\ No newline at end of file
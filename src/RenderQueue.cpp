@@ -0,0 +1,310 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	RENDER QUEUE MODULE																	//
+//	Collects every draw of a frame so that they can be sorted before any reach the		//
+//	render backend.  Objects hand in a small packet for each subset they want drawn,	//
+//	and once the scene has been walked the packets are sorted by the state they need,	//
+//	so that materials & matrices shared by neighbouring draws are only set once.		//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "RenderQueue.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <string.h>			// Standard memory functions.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Class constructor.  
+//////////////////////////////////////////////////////////////////////////////////////////
+RenderQueue::RenderQueue()
+{
+	this->draws = 0;
+	this->batches = 0;
+	this->materials = 0;
+	this->transforms = 0;
+
+	// Every colour starts off white until the palette is filled in.  
+	for (int i = 0 ; i < NUM_COLOURS ; i++)
+	{
+		Palette[i].r = Palette[i].g = Palette[i].b = Palette[i].a = 1.0f;
+	}
+	memset(&Tinted, 0, sizeof(Tinted));
+}
+
+//	Function to set one of the palette's colours.  Objects are drawn in the palette's
+//	colours by index, so changing an object's colour costs nothing until it is drawn.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void RenderQueue::SetColour(int index, const ColourRGB& Colour)
+{
+	if ((index < 0) || (index >= NUM_COLOURS))
+		return;
+
+	Palette[index].r = Colour.r;
+	Palette[index].g = Colour.g;
+	Palette[index].b = Colour.b;
+}
+
+//	Function to hold a world matrix for the draws about to be queued, reporting its
+//	number to hand in with them.  Every subset of an object shares the one matrix.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int RenderQueue::AddTransform(const Matrix& World)
+{
+	Transforms.push_back(World);
+	return (int)Transforms.size() - 1;
+}
+
+//	Function to queue a subset to be drawn in the given pass, in the given palette colour
+//	or PALETTE_NONE for the material's own.  Its sort key is made here:  the pass first,
+//	so passes are drawn in order, then the mesh, material & subset, so every object drawn
+//	from the same subset makes one batch, and lastly the colour, so objects coloured alike
+//	within a batch share a material.  The packet's number is kept under the key, so draws
+//	with the same key are drawn in the order they were queued.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void RenderQueue::Submit(int pass, int mesh, unsigned int subset,
+						 const RenderMaterial* Material, int colour, int transform)
+{
+	if ((colour < 0) || (colour >= NUM_COLOURS))
+		colour = PALETTE_NONE;
+
+	DrawPacket Packet;
+	Packet.mesh = mesh;
+	Packet.subset = subset;
+	Packet.Material = Material;
+	Packet.transform = transform;
+	Packet.colour = colour;
+
+	unsigned int key = ((unsigned int)pass << KEY_PASS_SHIFT)
+					 | ((unsigned int)this->FindMesh(mesh) << KEY_MESH_SHIFT)
+					 | ((unsigned int)this->FindMaterial(Material) << KEY_MATERIAL_SHIFT)
+					 | ((subset & KEY_FIELD_MASK) << KEY_SUBSET_SHIFT)
+					 | ((unsigned int)colour & KEY_COLOUR_MASK);
+
+	Keys.push_back(((unsigned long long)key << 32) | Packets.size());
+	Packets.push_back(Packet);
+}
+
+//	Function to sort everything queued & draw it through the given backend.  Materials &
+//	world matrices are only set when they differ from the last ones set, and each pass's
+//	render states are set as it is reached.  A draw in a palette colour sets a copy of its
+//	material with the colour put in.  The queue is emptied ready for the next frame.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void RenderQueue::Flush(RenderBackend* Backend)
+{
+	RenderQueue::Sort(Keys, Scratch);
+
+	draws = 0;
+	batches = 0;
+	materials = 0;
+	transforms = 0;
+
+	int pass = -1;							// The pass being drawn.  
+	unsigned int batch = 0;					// The shared fields of the batch being drawn.  
+	const RenderMaterial* Material = NULL;	// The material last set.  
+	int colour = PALETTE_NONE;				// The colour last put into it.  
+	int transform = -1;						// The world matrix last set.  
+
+	for (size_t i = 0 ; i < Keys.size() ; i++)
+	{
+		const DrawPacket& Packet = Packets[(unsigned int)Keys[i]];
+		unsigned int key = (unsigned int)(Keys[i] >> 32);
+		int next = (int)(key >> KEY_PASS_SHIFT);
+
+		if (next != pass)					// If a new pass has been reached...  
+		{
+			this->EndPass(Backend, pass);
+			this->BeginPass(Backend, next);
+			pass = next;
+		}
+
+		if ((i == 0) || ((key & KEY_BATCH_MASK) != batch))	// If a new batch has begun...  
+		{
+			batch = key & KEY_BATCH_MASK;
+			batches++;
+		}
+
+		if ((Packet.Material != Material) || (Packet.colour != colour))
+		{
+			if (Packet.colour == PALETTE_NONE)
+				Backend->SetMaterial(*Packet.Material);
+			else
+			{
+				// Puts the colour over the material's own.  Alpha is left as loaded, and
+				// ambient is made the same as diffuse, as the models expect.  
+				Tinted = *Packet.Material;
+				Tinted.Diffuse.r = Palette[Packet.colour].r;
+				Tinted.Diffuse.g = Palette[Packet.colour].g;
+				Tinted.Diffuse.b = Palette[Packet.colour].b;
+				Tinted.Ambient = Tinted.Diffuse;
+				Backend->SetMaterial(Tinted);
+			}
+
+			Material = Packet.Material;
+			colour = Packet.colour;
+			materials++;
+		}
+
+		if (Packet.transform != transform)
+		{
+			Backend->SetTransform(TRANSFORM_WORLD, Transforms[Packet.transform]);
+			transform = Packet.transform;
+			transforms++;
+		}
+
+		Backend->DrawSubset(Packet.mesh, Packet.subset);
+		draws++;
+	}
+	this->EndPass(Backend, pass);
+
+	Packets.clear();
+	Transforms.clear();
+	Keys.clear();
+	Materials.clear();
+	Models.clear();
+}
+
+//	Function to report the number of subsets drawn by the last flush.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int RenderQueue::GetDrawCount()
+{
+	return this->draws;
+}
+
+//	Function to report the number of batches drawn by the last flush.  Each batch is
+//	every draw of one subset of a mesh in one material, whatever their colours.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int RenderQueue::GetBatchCount()
+{
+	return this->batches;
+}
+
+//	Function to report the number of materials set by the last flush.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int RenderQueue::GetMaterialCount()
+{
+	return this->materials;
+}
+
+//	Function to report the number of world matrices set by the last flush.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int RenderQueue::GetTransformCount()
+{
+	return this->transforms;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PRIVATE METHODS
+//	Methods called from within the class for better organisation of the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to number a material for the sort key.  Objects drawing the same mesh share
+//	its materials, so each material is known by where it is held.  Past the largest
+//	number the rest share it, which only costs them their place in the sort.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int RenderQueue::FindMaterial(const RenderMaterial* Material)
+{
+	for (size_t i = 0 ; i < Materials.size() ; i++)
+		if (Materials[i] == Material)
+			return (int)i;
+
+	if (Materials.size() >= KEY_FIELD_MASK)
+		return KEY_FIELD_MASK;
+
+	Materials.push_back(Material);
+	return (int)Materials.size() - 1;
+}
+
+//	Function to number a mesh for the sort key, in the same way as the materials.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int RenderQueue::FindMesh(int mesh)
+{
+	for (size_t i = 0 ; i < Models.size() ; i++)
+		if (Models[i] == mesh)
+			return (int)i;
+
+	if (Models.size() >= KEY_FIELD_MASK)
+		return KEY_FIELD_MASK;
+
+	Models.push_back(mesh);
+	return (int)Models.size() - 1;
+}
+
+//	Function to set the render states a pass needs.  Shadows are drawn to the stencil
+//	buffer with the depth buffer turned off.  Nothing is ever textured, so the texture is
+//	left alone.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void RenderQueue::BeginPass(RenderBackend* Backend, int pass)
+{
+	if (pass == RENDER_PASS_SHADOW)
+	{
+		Backend->SetRenderState(STATE_STENCIL, 1);	// Starts drawing to the stencil buffer.  
+		Backend->SetRenderState(STATE_DEPTH, 0);
+	}
+}
+
+//	Function to put back the render states changed for a pass.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void RenderQueue::EndPass(RenderBackend* Backend, int pass)
+{
+	if (pass == RENDER_PASS_SHADOW)
+	{
+		Backend->SetRenderState(STATE_STENCIL, 0);	// Stops drawing to the stencil buffer.  
+		Backend->SetRenderState(STATE_DEPTH, 1);
+	}
+}
+
+//	Function to sort the keys into order by the top 32 bits, leaving keys that match in
+//	the order they were in.  Each byte is sorted in turn from the lowest, counting how
+//	many keys fall into each of its 256 values & then moving them into place, so the time
+//	taken only grows with the number of keys.  Bytes that are the same in every key are
+//	passed over.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void RenderQueue::Sort(std::vector<unsigned long long>& Keys,
+					   std::vector<unsigned long long>& Scratch)
+{
+	size_t count = Keys.size();
+	if (count < 2)
+		return;
+
+	Scratch.resize(count);
+
+	for (int shift = 32 ; shift < 64 ; shift += 8)
+	{
+		size_t Offsets[256];			// Where each value's keys start.  
+		memset(Offsets, 0, sizeof(Offsets));
+
+		for (size_t i = 0 ; i < count ; i++)
+			Offsets[(Keys[i] >> shift) & 0xff]++;
+
+		if (Offsets[(Keys[0] >> shift) & 0xff] == count)	// If the byte never changes...  
+			continue;
+
+		size_t total = 0;
+		for (int b = 0 ; b < 256 ; b++)
+		{
+			size_t keys = Offsets[b];
+			Offsets[b] = total;
+			total += keys;
+		}
+
+		for (size_t i = 0 ; i < count ; i++)
+			Scratch[Offsets[(Keys[i] >> shift) & 0xff]++] = Keys[i];
+
+		Keys.swap(Scratch);
+	}
+}
\ No newline at end of file
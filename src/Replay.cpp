@@ -0,0 +1,509 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	REPLAY MODULE																		//
+//	Records a session's input to a compact binary file & plays it back.  Since the		//
+//	simulation is fully deterministic, the seed & the input for each tick are all that	//
+//	is needed to rebuild a session exactly.  Runs of identical ticks are stored once	//
+//	with a count, and mouse movement is stored as the change from the tick before.		//
+//	Full copies of the state are stored at regular intervals along with an index at	//
+//	the end of the file, so that playback can jump to any tick without replaying the	//
+//	whole session up to it.  Recording hands its output to a background thread, so the	//
+//	thread running the game never waits on the disk.									//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "Replay.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <string.h>		// Standard memory functions.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	WRITER METHODS
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Class constructor.  
+//////////////////////////////////////////////////////////////////////////////////////////
+ReplayWriter::ReplayWriter()
+{
+	this->File = NULL;
+	this->backFull = false;
+	this->closing = false;
+}
+
+//	Class destructor.  Finishes off any file still being recorded.  
+//////////////////////////////////////////////////////////////////////////////////////////
+ReplayWriter::~ReplayWriter()
+{
+	this->Close();
+}
+
+//	Function to start recording a session.  The header is written straight away, and
+//	the disk thread is started to take the buffers as they fill.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool ReplayWriter::Open(const char* path, unsigned long long seed, unsigned long long stream,
+						const SimParams& Params)
+{
+	this->Close();
+
+	File = fopen(path, "wb");
+	if (!File)
+		return false;
+
+	// Both buffers are given room up front, so that filling them never has to allocate.  
+	Front.clear();
+	Back.clear();
+	Front.reserve(REPLAY_BUFFER * 2);
+	Back.reserve(REPLAY_BUFFER * 2);
+	Index.clear();
+
+	backFull = false;
+	closing = false;
+	offset = 0;
+	ticks = 0;
+	runLength = 0;
+	mouse = 0;
+
+	ReplayHeader Header;
+	memset(&Header, 0, sizeof(Header));
+	Header.magic		= REPLAY_MAGIC;
+	Header.version		= REPLAY_VERSION;
+	Header.interval		= REPLAY_KEYFRAME;
+	Header.stateSize	= sizeof(SimState);
+	Header.seed			= seed;
+	Header.stream		= stream;
+	Header.Params		= Params;
+	this->Put(&Header, sizeof(Header));
+
+	Disk = std::thread(&ReplayWriter::WriteLoop, this);
+	return true;
+}
+
+//	Function to record a tick.  It takes the state from before the tick's input was
+//	applied, and stores it in full whenever a keyframe is due.  Otherwise the input is
+//	added to the current run if it matches, or starts a new run if it doesn't.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void ReplayWriter::Record(const SimState& State, const TickInput& Input)
+{
+	if (!File)
+		return;
+
+	// Stores a full copy of the state at the start of each interval.  Runs never cross
+	// a keyframe, so decoding can start from any of them.  
+	if ((ticks % REPLAY_KEYFRAME) == 0)
+	{
+		this->EndRun();
+		Index.push_back(offset);
+		this->Put(&State, sizeof(SimState));
+		mouse = 0;
+	}
+
+	if ((runLength > 0) && (Input.keys == Run.keys) && (Input.mouse == Run.mouse))
+		runLength++;
+	else
+	{
+		this->EndRun();
+		Run = Input;
+		runLength = 1;
+	}
+
+	ticks++;
+
+	if (Front.size() >= REPLAY_BUFFER)
+		this->Hand(false);
+}
+
+//	Function to finish off the file.  The last run, the index of stored states & the
+//	footer are added, the last buffer is handed over & the disk thread is waited for.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void ReplayWriter::Close()
+{
+	if (!File)
+		return;
+
+	this->EndRun();
+
+	ReplayFooter Footer;
+	memset(&Footer, 0, sizeof(Footer));
+	Footer.index		= offset;
+	Footer.keyframes	= (unsigned int)Index.size();
+	Footer.ticks		= ticks;
+	Footer.magic		= REPLAY_END_MAGIC;
+
+	if (!Index.empty())
+		this->Put(&Index[0], Index.size() * sizeof(unsigned long long));
+	this->Put(&Footer, sizeof(Footer));
+
+	this->Hand(true);
+
+	// Tells the disk thread to finish once the last buffer is written.  
+	{
+		std::lock_guard<std::mutex> Guard(Lock);
+		closing = true;
+	}
+	Wake.notify_all();
+	Disk.join();
+
+	fclose(File);
+	File = NULL;
+}
+
+//	Function to check whether a file is being recorded.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool ReplayWriter::IsOpen()
+{
+	return (File != NULL);
+}
+
+//	Function to add bytes to the file.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void ReplayWriter::Put(const void* Data, size_t size)
+{
+	const unsigned char* Bytes = (const unsigned char*)Data;
+	Front.insert(Front.end(), Bytes, Bytes + size);
+	offset += size;
+}
+
+//	Function to add a number using as few bytes as it needs.  Each byte holds 7 bits of
+//	the number, with the top bit set on every byte but the last.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void ReplayWriter::PutNumber(unsigned long long value)
+{
+	unsigned char Bytes[10];
+	size_t size = 0;
+
+	while (value >= 0x80)
+	{
+		Bytes[size++] = (unsigned char)(value | 0x80);
+		value >>= 7;
+	}
+	Bytes[size++] = (unsigned char)value;
+
+	this->Put(Bytes, size);
+}
+
+//	Function to add the run of ticks in progress.  A run is stored as its length, the
+//	keys held & the change in mouse movement from the run before.  The change is folded
+//	so that small negative numbers stay small (0, -1, 1, -2... become 0, 1, 2, 3...).  
+//////////////////////////////////////////////////////////////////////////////////////////
+void ReplayWriter::EndRun()
+{
+	if (runLength == 0)
+		return;
+
+	int change = Run.mouse - mouse;
+	unsigned int folded = ((unsigned int)change << 1) ^ (unsigned int)(change >> 31);
+
+	this->PutNumber(runLength);
+	this->PutNumber((unsigned int)Run.keys);
+	this->PutNumber(folded);
+
+	mouse = Run.mouse;
+	runLength = 0;
+}
+
+//	Function to hand the filled buffer to the disk thread.  If the thread is still busy
+//	with the last one, the buffer is kept & filled further unless told to wait.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void ReplayWriter::Hand(bool wait)
+{
+	{
+		std::unique_lock<std::mutex> Guard(Lock);
+
+		if (backFull)
+		{
+			if (!wait)
+				return;
+			Wake.wait(Guard, [this] { return !backFull; });
+		}
+
+		Front.swap(Back);
+		backFull = true;
+	}
+	Wake.notify_all();
+}
+
+//	Function holding the disk thread's main loop.  It sleeps until a buffer is handed
+//	over, writes it out without holding the lock, and hands the empty buffer back.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void ReplayWriter::WriteLoop()
+{
+	std::unique_lock<std::mutex> Guard(Lock);
+
+	while (true)
+	{
+		Wake.wait(Guard, [this] { return backFull || closing; });
+
+		if (backFull)
+		{
+			Guard.unlock();
+			fwrite(&Back[0], 1, Back.size(), File);
+			Back.clear();
+			Guard.lock();
+
+			backFull = false;
+			Wake.notify_all();
+		}
+		else if (closing)
+			return;
+	}
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	READER METHODS
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Class constructor.  
+//////////////////////////////////////////////////////////////////////////////////////////
+ReplayReader::ReplayReader()
+{
+	memset(&Header, 0, sizeof(Header));
+	memset(&Footer, 0, sizeof(Footer));
+	this->Index = NULL;
+	this->cursor = 0;
+	this->end = 0;
+	this->tick = 0;
+	this->runLength = 0;
+}
+
+//	Function to read in a replay file & check that it was recorded by this build.  The
+//	reader is left at the first tick.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool ReplayReader::Open(const char* path)
+{
+	Data.clear();
+	Index = NULL;
+
+	FILE* File = fopen(path, "rb");
+	if (!File)
+		return false;
+
+	fseek(File, 0, SEEK_END);
+	long size = ftell(File);
+	fseek(File, 0, SEEK_SET);
+
+	if (size < (long)(sizeof(ReplayHeader) + sizeof(ReplayFooter)))
+	{
+		fclose(File);
+		return false;
+	}
+
+	Data.resize(size);
+	size_t read = fread(&Data[0], 1, size, File);
+	fclose(File);
+	if (read != (size_t)size)
+		return false;
+
+	memcpy(&Header, &Data[0], sizeof(Header));
+	memcpy(&Footer, &Data[size - sizeof(Footer)], sizeof(Footer));
+
+	// Checks both ends of the file, and that the index lies between them.  
+	if ((Header.magic != REPLAY_MAGIC) || (Header.version != REPLAY_VERSION) ||
+		(Header.stateSize != sizeof(SimState)) || (Header.interval == 0) ||
+		(Footer.magic != REPLAY_END_MAGIC))
+		return false;
+	if ((Footer.index < sizeof(Header)) ||
+		(Footer.index + Footer.keyframes * sizeof(unsigned long long) + sizeof(Footer) != (size_t)size))
+		return false;
+
+	Index = (const unsigned long long*)&Data[(size_t)Footer.index];
+	end = (size_t)Footer.index;
+
+	// Starts at the beginning of the session.  
+	cursor = sizeof(Header);
+	tick = 0;
+	runLength = 0;
+	return true;
+}
+
+//	Function to report the colour generator the session was started with.  
+//////////////////////////////////////////////////////////////////////////////////////////
+RandomStream ReplayReader::GetStream()
+{
+	return RandomStream(Header.seed, Header.stream);
+}
+
+//	Function to report the session's tuning values.  
+//////////////////////////////////////////////////////////////////////////////////////////
+SimParams ReplayReader::GetParams()
+{
+	return Header.Params;
+}
+
+//	Function to report the length of the session in ticks.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int ReplayReader::GetTicks()
+{
+	return (int)Footer.ticks;
+}
+
+//	Function to report the tick that will be read next.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int ReplayReader::GetTick()
+{
+	return tick;
+}
+
+//	Function to report the number of stored states.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int ReplayReader::GetKeyframes()
+{
+	return (int)Footer.keyframes;
+}
+
+//	Function to report the number of ticks between stored states.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int ReplayReader::GetInterval()
+{
+	return (int)Header.interval;
+}
+
+//	Function to report the size of the file in bytes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int ReplayReader::GetSize()
+{
+	return (int)Data.size();
+}
+
+//	Function to read the state stored at the start of the given interval.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool ReplayReader::GetKeyframe(int id, SimState& State)
+{
+	if ((id < 0) || (id >= (int)Footer.keyframes))
+		return false;
+	if (Index[id] + sizeof(SimState) > end)
+		return false;
+
+	memcpy(&State, &Data[(size_t)Index[id]], sizeof(SimState));
+	State.reserved = 0;		// Files from before the field was added left it unset.  
+	return true;
+}
+
+//	Function to read the input for the next tick.  Returns false at the end of the
+//	session, or if the file turns out to be damaged.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool ReplayReader::Next(TickInput& Input)
+{
+	if (tick >= (int)Footer.ticks)
+		return false;
+
+	// Once the current run is used up, the next one is decoded, stepping over the stored
+	// state if this tick starts a new interval.  
+	if (runLength == 0)
+	{
+		if ((tick % Header.interval) == 0)
+		{
+			cursor += sizeof(SimState);
+			Run.mouse = 0;
+		}
+
+		unsigned long long length, keys, folded;
+		if (!this->ReadNumber(length) || !this->ReadNumber(keys) || !this->ReadNumber(folded))
+			return false;
+		if (length == 0)
+			return false;
+
+		unsigned int change = (unsigned int)folded;
+		runLength = (unsigned int)length;
+		Run.keys = (int)keys;
+		Run.mouse += (int)((change >> 1) ^ (0u - (change & 1)));
+	}
+
+	runLength--;
+	tick++;
+	Input = Run;
+	return true;
+}
+
+//	Function to move a session to the given tick.  The stored state at the start of the
+//	tick's interval is restored & the rest of the way is played from there, so the cost
+//	is the same wherever in the session the tick lies.  The reader is left ready to read
+//	the input for the tick.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool ReplayReader::Seek(Simulation& Sim, int tick)
+{
+	if ((tick < 0) || (tick > (int)Footer.ticks) || (Footer.keyframes == 0))
+		return false;
+
+	int id = tick / (int)Header.interval;
+	if (id >= (int)Footer.keyframes)
+		id = (int)Footer.keyframes - 1;
+
+	SimState State;
+	if (!this->GetKeyframe(id, State))
+		return false;
+	Sim.Restore(State);
+
+	cursor = (size_t)Index[id];
+	this->tick = id * (int)Header.interval;
+	runLength = 0;
+
+	// Plays forward from the stored state to the tick asked for.  
+	TickInput Input;
+	while (this->tick < tick)
+	{
+		if (!this->Next(Input))
+			return false;
+		Sim.Apply(Input);
+		Sim.Tick();
+	}
+
+	return true;
+}
+
+//	Function to move reading to the given tick without touching any session, for when
+//	the session has been put back to that tick by other means.  Reading starts again
+//	from the stored state at the start of the tick's interval.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool ReplayReader::MoveTo(int tick)
+{
+	if ((tick < 0) || (tick > (int)Footer.ticks) || (Footer.keyframes == 0))
+		return false;
+
+	int id = tick / (int)Header.interval;
+	if (id >= (int)Footer.keyframes)
+		id = (int)Footer.keyframes - 1;
+
+	cursor = (size_t)Index[id];
+	this->tick = id * (int)Header.interval;
+	runLength = 0;
+
+	TickInput Input;
+	while (this->tick < tick)
+		if (!this->Next(Input))
+			return false;
+
+	return true;
+}
+
+//	Function to read a variable-length number.  Returns false if it runs off the end of
+//	the input.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool ReplayReader::ReadNumber(unsigned long long& value)
+{
+	value = 0;
+
+	for (int shift = 0 ; shift < 64 ; shift += 7)
+	{
+		if (cursor >= end)
+			return false;
+
+		unsigned char byte = Data[cursor++];
+		value |= (unsigned long long)(byte & 0x7f) << shift;
+		if (!(byte & 0x80))
+			return true;
+	}
+
+	return false;
+}
\ No newline at end of file
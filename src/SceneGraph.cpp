@@ -0,0 +1,144 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	SCENE GRAPH MODULE																	//
+//	A hierarchy of transforms, where each node's world matrix is its own local matrix	//
+//	followed by its parent's world matrix.  Setting a node's local matrix only marks it	//
+//	as changed; the world matrices of the changed nodes & everything beneath them are	//
+//	worked out again when the graph is next updated, and the rest are left as they		//
+//	were.  A node's parent must be added before it, so the nodes are kept in one block	//
+//	of memory in an order where a single pass from the front updates every parent		//
+//	before its children.																//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "SceneGraph.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Class constructor.  The graph starts off empty.  
+//////////////////////////////////////////////////////////////////////////////////////////
+SceneGraph::SceneGraph()
+{
+	this->Clear();
+}
+
+//	Function to add a node beneath the given parent, or SCENE_ROOT for none, reporting
+//	the node's number.  The parent must already have been added.  Returns -1 if it
+//	hasn't.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int SceneGraph::AddNode(int parent, const Matrix& Local)
+{
+	if ((parent < SCENE_ROOT) || (parent >= (int)Parents.size()))
+		return -1;
+
+	Locals.push_back(Local);
+	Worlds.push_back(Local);
+	Parents.push_back(parent);
+	Dirty.push_back(1);				// Its world matrix is worked out at the next update.  
+
+	this->changed = true;
+	return (int)Parents.size() - 1;
+}
+
+//	Function to give a node a new local matrix.  Nothing is worked out until the next
+//	update, so a node can be moved any number of times in between for the same cost.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void SceneGraph::SetLocal(int node, const Matrix& Local)
+{
+	if ((node < 0) || (node >= (int)Parents.size()))
+		return;
+
+	Locals[node] = Local;
+	Dirty[node] = 1;
+	this->changed = true;
+}
+
+//	Function to report a node's local matrix.  
+//////////////////////////////////////////////////////////////////////////////////////////
+const Matrix& SceneGraph::GetLocal(int node)
+{
+	return Locals[node];
+}
+
+//	Function to report a node's world matrix, as of the last update.  
+//////////////////////////////////////////////////////////////////////////////////////////
+const Matrix& SceneGraph::GetWorld(int node)
+{
+	return Worlds[node];
+}
+
+//	Function to work out the world matrix of every node that has changed, along with
+//	everything beneath it.  Parents always come before their children, so by the time a
+//	node is reached its parent is up to date & has marked it if it changed.  If nothing
+//	has changed since the last update, the nodes aren't even looked at.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void SceneGraph::Update()
+{
+	this->updated = 0;
+
+	if (!this->changed)
+		return;
+
+	int count = (int)Parents.size();
+	for (int i = 0 ; i < count ; i++)
+	{
+		int parent = Parents[i];
+
+		// A node changes along with its parent.  
+		if ((parent != SCENE_ROOT) && Dirty[parent])
+			Dirty[i] = 1;
+
+		if (!Dirty[i])
+			continue;
+
+		if (parent == SCENE_ROOT)
+			Worlds[i] = Locals[i];
+		else
+			Worlds[i] = Matrix::Multiply(Locals[i], Worlds[parent]);
+		this->updated++;
+	}
+
+	// Only clears the marks once every child has seen its parent's.  
+	for (int i = 0 ; i < count ; i++)
+		Dirty[i] = 0;
+	this->changed = false;
+}
+
+//	Function to remove every node.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void SceneGraph::Clear()
+{
+	Locals.clear();
+	Worlds.clear();
+	Parents.clear();
+	Dirty.clear();
+
+	this->changed = false;
+	this->updated = 0;
+}
+
+//	Function to report the number of nodes in the graph.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int SceneGraph::GetNodeCount()
+{
+	return (int)Parents.size();
+}
+
+//	Function to report how many world matrices were worked out in the last update.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int SceneGraph::GetUpdateCount()
+{
+	return this->updated;
+}
\ No newline at end of file
@@ -0,0 +1,273 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	SESSION BATCH MODULE																//
+//	Runs large batches of independent headless sessions for tuning the game's			//
+//	constants.  Each session is played by a controller over the simulation module, the	//
+//	sessions are spread across every core by the task pool, and the results are		//
+//	gathered into histograms of how the sessions played out.							//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "SessionBatch.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <string.h>			// Standard memory functions.  
+#include "Clock.h"			// Monotonic clock interface.  
+#include "TaskPool.h"		// Work-stealing thread pool.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	RESULTS METHODS
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to zero every count in the results.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void BatchResults::Clear()
+{
+	memset(this, 0, sizeof(BatchResults));
+}
+
+//	Function to add another worker's counts into these results.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void BatchResults::Merge(const BatchResults& Other)
+{
+	this->sessions	+= Other.sessions;
+	this->ticks		+= Other.ticks;
+	this->timedOut	+= Other.timedOut;
+	this->checksum	+= Other.checksum;
+
+	for (int i = 0 ; i < BATCH_LEVELS ; i++)
+	{
+		this->levelReached[i]	+= Other.levelReached[i];
+		this->bounces[i]		+= Other.bounces[i];
+	}
+
+	for (int i = 0 ; i < BATCH_FLIGHTS ; i++)
+		this->flights[i] += Other.flights[i];
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Class constructor.  Stores the settings; nothing is run until Run() is called.  
+//////////////////////////////////////////////////////////////////////////////////////////
+SessionBatch::SessionBatch(const BatchSettings& Settings)
+{
+	this->Settings	= Settings;
+	this->threads	= 0;
+	this->seconds	= 0.0;
+	this->Flights	= NULL;
+
+	Results.Clear();
+}
+
+//	Class destructor.  Removes each worker's results & controller.  
+//////////////////////////////////////////////////////////////////////////////////////////
+SessionBatch::~SessionBatch()
+{
+	for (size_t i = 0 ; i < WorkerResults.size() ; i++)
+	{
+		delete WorkerResults[i];
+		delete Controllers[i];
+	}
+
+	delete Flights;
+}
+
+//	Function to run every session in the batch.  Sessions are grouped into chunks so the
+//	pool's queues stay short, & each worker writes only to its own results & controller
+//	so that nothing is shared between workers until the final merge.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void SessionBatch::Run()
+{
+	SystemClock Time;
+	TaskPool Pool(Settings.threads);
+
+	this->threads = Pool.GetThreadCount();
+
+	// Gives each worker its own results & controller.  
+	for (int i = 0 ; i < this->threads ; i++)
+	{
+		BatchResults* Worker = new BatchResults();
+		Worker->Clear();
+		WorkerResults.push_back(Worker);
+
+		if (Settings.idle)
+			Controllers.push_back(new IdleController());
+		else
+			Controllers.push_back(new BotController(Settings.reaction));
+	}
+
+	int chunks = (Settings.sessions + BATCH_CHUNK - 1) / BATCH_CHUNK;
+
+	// Splits a stream off the seed for each chunk, as the numbered worker streams are, by
+	// long jumping one copy along rather than working each out from the start.  
+	RandomStream Stream(Settings.seed);
+	Streams.resize(chunks);
+	for (int i = 0 ; i < chunks ; i++)
+	{
+		Streams[i] = Stream;
+		Stream.LongJump();
+	}
+
+	// Runs the batch, timing it for the throughput figures.  
+	long long start = Time.Now();
+
+	// Builds the flights for each level once, for every session to jump along.  
+	if (Settings.eventDriven)
+		Flights = new FlightCache(	Settings.Params.initialGravity,
+									Settings.Params.gravIncrease,
+									Settings.Params.launchVelocity,
+									BATCH_LEVELS);
+
+	Pool.Run(chunks, &SessionBatch::RunChunk, this);
+	this->seconds = (double)(Time.Now() - start) / NS_PER_SECOND;
+
+	// Combines the results from each worker.  
+	Results.Clear();
+	for (int i = 0 ; i < this->threads ; i++)
+		Results.Merge(*WorkerResults[i]);
+}
+
+//	Function to report the combined results of the batch.  
+//////////////////////////////////////////////////////////////////////////////////////////
+const BatchResults& SessionBatch::GetResults()
+{
+	return Results;
+}
+
+//	Function to report the number of workers the batch ran on.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int SessionBatch::GetThreadCount()
+{
+	return this->threads;
+}
+
+//	Function to report how long the batch took to run.  
+//////////////////////////////////////////////////////////////////////////////////////////
+double SessionBatch::GetSeconds()
+{
+	return this->seconds;
+}
+
+//	Function to report the number of sessions run per second.  
+//////////////////////////////////////////////////////////////////////////////////////////
+double SessionBatch::GetSessionsPerSecond()
+{
+	if (this->seconds <= 0.0)
+		return 0.0;
+	return Results.sessions / this->seconds;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PRIVATE METHODS
+//	Methods called from within the class for better organisation of the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function run by the task pool for each chunk of sessions.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void SessionBatch::RunChunk(int chunk, int worker, void* context)
+{
+	SessionBatch* Batch = (SessionBatch*)context;
+
+	int first	= chunk * BATCH_CHUNK;
+	int last	= first + BATCH_CHUNK;
+	if (last > Batch->Settings.sessions)
+		last = Batch->Settings.sessions;
+
+	// Each session in the chunk takes the chunk's stream jumped once more than the last.  
+	RandomStream Stream = Batch->Streams[chunk];
+	for (int i = first ; i < last ; i++)
+	{
+		Batch->RunSession(Stream, worker);
+		Stream.Jump();
+	}
+}
+
+//	Function to play a single session from start to finish, drawing from the given
+//	stream.  Each session's stream only depends on the batch seed & the session's
+//	index, never on the worker it lands on, so a batch gives the same results however
+//	its sessions end up spread over the workers, & no two sessions' streams can ever
+//	overlap.  When the batch is event driven, any stretch where the controller holds
+//	the same turn (including none at all) is jumped over in one go, which gives exactly
+//	the same session as stepping through it.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void SessionBatch::RunSession(const RandomStream& Random, int worker)
+{
+	BatchResults* Worker = WorkerResults[worker];
+	Controller* Control = Controllers[worker];
+
+	Simulation Sim(Random, Settings.Params);
+	Sim.ShareFlights(this->Flights);
+	Control->Reset();
+
+	int ticks = 0;			// Ticks played so far.  
+	int flight = 0;			// Ticks since the last bounce.  
+	bool inPlay = true;		// Whether the ball is still above the ring.  
+
+	while (inPlay && (ticks < Settings.maxTicks))
+	{
+		int level = Sim.GetLevel();
+		int bounces = Sim.GetBounces();
+		int advanced = 1;		// Ticks played on this pass.  
+
+		// Finds out how long the controller will hold the same turn for.  
+		float turn = 0.0f;
+		int held = Settings.eventDriven ? Control->Hold(Sim, turn) : 0;
+
+		if (held > 0)			// If its input is steady, jump ahead.  
+		{
+			if (held > Settings.maxTicks - ticks)
+				held = Settings.maxTicks - ticks;
+
+			advanced = Sim.FastForward(held, turn);
+			Control->Skip(advanced);
+			inPlay = !Sim.Fallen();
+		}
+		else					// Otherwise, play a single tick.  
+		{
+			Sim.Rotate(Control->Control(Sim));
+			inPlay = Sim.Tick();
+		}
+
+		ticks += advanced;
+		flight += advanced;
+
+		// If the ball bounced this tick, count the bounce & how long it was in the air.  
+		if (Sim.GetBounces() != bounces)
+		{
+			Worker->bounces[(level < BATCH_LEVELS) ? level : (BATCH_LEVELS - 1)]++;
+			Worker->flights[(flight < BATCH_FLIGHTS) ? flight : (BATCH_FLIGHTS - 1)]++;
+			flight = 0;
+		}
+	}
+
+	int level = Sim.GetLevel();
+
+	Worker->sessions++;
+	Worker->ticks += ticks;
+	Worker->levelReached[(level < BATCH_LEVELS) ? level : (BATCH_LEVELS - 1)]++;
+	if (inPlay)
+		Worker->timedOut++;
+
+	// Adds a hash of the final state to the checksum, so batches run different ways can
+	// be checked against each other.  The sum doesn't depend on the order sessions end.  
+	const unsigned char* Bytes = (const unsigned char*)&Sim.GetState();
+	unsigned long long hash = 14695981039346656037ULL;
+	for (size_t i = 0 ; i < sizeof(SimState) ; i++)
+		hash = (hash ^ Bytes[i]) * 1099511628211ULL;
+	Worker->checksum += hash;
+}
\ No newline at end of file
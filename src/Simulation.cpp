@@ -0,0 +1,444 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	SIMULATION MODULE																	//
+//	The renderer-free core of the game.  The module owns every value that decides how a	//
+//	session plays out (ring angle, ball motion, colours, score & level) and advances	//
+//	them one fixed tick at a time.  It has no Direct3D or Win32 dependencies, so it can	//
+//	be run headless on any platform.													//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "Simulation.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Class constructor.  The session is started straight away from the given stream.  
+//////////////////////////////////////////////////////////////////////////////////////////
+Simulation::Simulation(const RandomStream& Random)
+{
+	this->Flights = NULL;
+	this->Params = Simulation::Defaults();
+	this->Reset(Random);
+}
+
+//	Class constructor for sessions run with tuning values other than the defaults.  
+//////////////////////////////////////////////////////////////////////////////////////////
+Simulation::Simulation(const RandomStream& Random, const SimParams& Params)
+{
+	this->Flights = NULL;
+	this->Params = Params;
+	this->Reset(Random);
+}
+
+//	Function to give the session a set of flights shared with other sessions run with
+//	the same tuning values, so that each flight only has to be built once over a batch.
+//	The set must outlive the session.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void Simulation::ShareFlights(FlightCache* Flights)
+{
+	this->Flights = Flights;
+}
+
+//	Function to report the tuning values set in Defines.h.  
+//////////////////////////////////////////////////////////////////////////////////////////
+SimParams Simulation::Defaults()
+{
+	SimParams Params;
+
+	Params.initialGravity	= INITIAL_GRAVITY;
+	Params.gravIncrease		= GRAV_INCREASE;
+	Params.launchVelocity	= LAUNCH_VELOCITY;
+
+	return Params;
+}
+
+//	Function to set every value back to how it is at the start of a game.  The stream
+//	is the only source of randomness in a session, so two sessions started from the
+//	same stream & given the same rotations will always play out identically.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void Simulation::Reset(const RandomStream& Random)
+{
+	State.Random = Random;				// Seeds the colour generator.  
+
+	State.x = 0.0f;						// Rotation displacement is 0.  
+	State.gravity = Params.initialGravity;	// Sets the starting gravity.  
+	State.score = 0;					// Score at start is 0.  
+	State.level = 1;					// Level at start is 1.  
+	State.bounces = 0;					// No bounces have been made yet.  
+	State.ticks = 0;					// No ticks have been played yet.  
+	State.reserved = 0;					// Keeps the state's bytes fully set.  
+
+	this->Bounce();						// Sets the ball to bounce for the first tick.  
+	this->ChangeColours();				// Sets the colours to start off the game.  
+}
+
+//	Function to advance the session by one tick.  This holds the same rules that were
+//	previously run as part of rendering each frame: the ball is moved, and if it touches
+//	a block of the same colour it is bounced back up.  Returns false once the ball has
+//	fallen through the ring.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool Simulation::Tick()
+{
+	State.ticks++;			// Counts the tick towards the session total.  
+	this->Translate();		// Moves the ball along its arc.  
+
+	// Checks whether specific actions need to be taken.  
+	if (this->Bounced())	// If the ball touches the ring...  
+	{
+		// And the colour of the block below the ball matches the colour of the ball...  
+		if (State.ballColour == State.blockColour[this->GetBlockBelow()])
+		{
+			this->ChangeColours();	// Change the colours of the ring blocks & the ball.  
+			this->Bounce();			// Bounces the ball.  
+			this->IncreaseScore();	// Increases the score by 1.  
+		}
+		// Otherwise, the ball falls through the ring to a game over.  
+	}
+
+	return !this->Fallen();	// Reports whether the session is still in play.  
+}
+
+//	Function to advance the session by up to the given number of ticks with the ring
+//	turned by the same amount on each of them.  Ticks on which nothing can happen are
+//	skipped in one jump by looking the ball's height up on the stored flight & making
+//	just the turns, and the first tick that needs the rules checking is then run through
+//	Tick() as normal.  This always stops straight after such a tick, so the caller can
+//	react to a bounce or a fall before going on.  The state afterwards is bit-identical
+//	to calling Rotate() & Tick() the same number of times.  Returns the number of ticks
+//	advanced.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int Simulation::FastForward(int ticks, float x)
+{
+	if (ticks <= 0)
+		return 0;
+
+	// If the state has been moved off the stored flight, there's nothing to jump with.  
+	Trajectory* Current = this->OnFlight();
+	if (!Current)
+	{
+		this->Rotate(x);
+		this->Tick();
+		return 1;
+	}
+
+	// Finds the next tick on which the rules have something to check: a tick touching
+	// the ring if there are any left, otherwise the tick the ball falls through.  
+	int next;
+	if ((Current->GetContact() < Current->GetPassed()) && ((State.t + 1) < Current->GetPassed()))
+		next = (Current->GetContact() > State.t + 1) ? Current->GetContact() : (State.t + 1);
+	else
+		next = Current->GetFallen();
+
+	// Jumps over every tick before it.  
+	int quiet = next - 1 - State.t;
+	if (quiet > ticks)
+		quiet = ticks;
+	if (quiet > 0)
+	{
+		State.t += quiet;
+		State.ticks += quiet;
+		State.y = Current->Height(State.t);
+
+		// The turns are made one at a time so they round the same as when stepped.  
+		if (x != 0.0f)
+			for (int i = 0 ; i < quiet ; i++)
+				this->Rotate(x);
+	}
+	else
+		quiet = 0;
+
+	// Then runs the tick itself if it's within reach.  
+	if (quiet < ticks)
+	{
+		this->Rotate(x);
+		this->Tick();
+		quiet++;
+	}
+
+	return quiet;
+}
+
+//	Function to rotate the ring based on the given x value.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void Simulation::Rotate(float x)
+{
+	State.x -= x;
+}
+
+//	Function to turn the ring by a tick's worth of player input.  The turns are made in
+//	the same order & by the same amounts as the renderer has always made them, so that
+//	recorded input plays back to exactly the same angles.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void Simulation::Apply(const TickInput& Input)
+{
+	if (Input.keys & INPUT_LEFT)
+		this->Rotate(-0.05f);
+	if (Input.keys & INPUT_RIGHT)
+		this->Rotate( 0.05f);
+	this->Rotate(0.01f * Input.mouse);
+}
+
+//	Function to carry the session on from a stored state, as if it had been played up
+//	to that point.  The state must have come from a session with the same tuning values.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void Simulation::Restore(const SimState& State)
+{
+	this->State = State;
+	this->State.reserved = 0;			// Keeps the state's bytes fully set.  
+}
+
+//	Function to report the full state of the session.  
+//////////////////////////////////////////////////////////////////////////////////////////
+const SimState& Simulation::GetState()
+{
+	return State;
+}
+
+//	Function to report the current rotation of the ring.  
+//////////////////////////////////////////////////////////////////////////////////////////
+float Simulation::GetAngle()
+{
+	return State.x;
+}
+
+//	Function to report the position of the ball on the y-axis.  
+//////////////////////////////////////////////////////////////////////////////////////////
+float Simulation::GetBallY()
+{
+	return State.y;
+}
+
+//	Function to report the colour ID of the ball.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int Simulation::GetBallColour()
+{
+	return State.ballColour;
+}
+
+//	Function to report the colour ID of the given block.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int Simulation::GetBlockColour(int id)
+{
+	return State.blockColour[id];
+}
+
+//	Function to find the ID of the block the ball is currently below.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int Simulation::GetBlockBelow()
+{
+	return Simulation::BlockBelow(State.x);
+}
+
+//	Function to find the ID of the block the ball would be below with the ring at the
+//	given angle.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int Simulation::BlockBelow(float x)
+{
+	// Adds 30 degrees to the current value of the x value around the ring.  This is added
+	// as a means to standardise the value to the front of the ring (without this, it would
+	// see the block a little towards the left of the ring).  
+	float b_std = x + (PI / 6);
+
+	int b_id = (int)floor(b_std);		// Take the value calculated above and round it down
+										// (e.g. 3.142 -> 3).  
+
+	// While the number is negative, add another full circle to make it positive.  
+	while (b_id < 0)
+		b_id += 6;
+
+	return (b_id % 6);	// Find the reminder to get the ID of the block the ball is over.  
+}
+
+//	Function to report the level attained for the current game.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int Simulation::GetLevel()
+{
+	return State.level;
+}
+
+//	Function to report the current progress to the next level.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int Simulation::GetScore()
+{
+	return State.score;
+}
+
+//	Function to report the number of successful bounces made during the session.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int Simulation::GetBounces()
+{
+	return State.bounces;
+}
+
+//	Function to check whether the ball has bounced since the last tick.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool Simulation::Bounced()
+{
+	// Reports whether the ball appears between the values of y = -0.5 and y = 0.  This
+	// acts as a very rudimentary way to determine whether the ball has hit the ring since
+	// the last tick.  
+	return ((State.y > CONTACT_BOTTOM) && (State.y <= CONTACT_TOP));
+}
+
+//	Function to check whether the ball has finally fallen through the ring.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool Simulation::Fallen()
+{
+	// Once the ball has falled down a certain depth below the ring, it is reported that
+	// the ball has falled through the ring.  
+	return (State.y < FALLEN_DEPTH);
+}
+
+//	Function to report how many ticks from now the ball next touches the ring (the
+//	first tick on which Bounced() will be true).  Returns -1 if the ball has already
+//	passed the ring & can only fall.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int Simulation::TicksToImpact()
+{
+	Trajectory* Current = this->OnFlight();
+	if (!Current)
+		return -1;
+
+	// If there's no contact left on this flight, there won't be an impact.  
+	if ((Current->GetContact() >= Current->GetPassed()) || ((State.t + 1) >= Current->GetPassed()))
+		return -1;
+
+	if (Current->GetContact() > State.t)
+		return Current->GetContact() - State.t;
+	return 1;
+}
+
+//	Function to report how many ticks from now the ball will have fully fallen if it
+//	isn't bounced.  Returns -1 if that is further away than the stored flight reaches.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int Simulation::TicksToFall()
+{
+	Trajectory* Current = this->OnFlight();
+	if (!Current || (Current->GetFallen() == MAX_FLIGHT_TICKS))
+		return -1;
+
+	return Current->GetFallen() - State.t;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PRIVATE METHODS
+//	Methods called from within the class for better organisation of the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to calculate the y-position of the ball since the last tick.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void Simulation::Translate()
+{
+	State.t++;								// Adds another tick to the ball's timer.  
+
+	// Y is increased by the result of a "v = u + at" equation of motion,
+	//	v = The ball's displacement since the last tick
+	//	u = The velocity of the ball at launch
+	//	a = The ball's gravitational constant
+	//	t = How long the ball has been in the air
+	// The result is also times by a scale to make the result relevant to the world scale.  
+	State.y += SCALE * (Params.launchVelocity - (State.gravity * State.t));
+}
+
+//	Function to make the ball bounce on the ring.  At its most basic, the function resets
+//	the two dynamic variables (position on the y-axis & time).  
+//////////////////////////////////////////////////////////////////////////////////////////
+void Simulation::Bounce()
+{
+	State.y = 0.0f;
+	State.t = 0;
+}
+
+//	Function to increase the gravitational constant of the ball's motion.  This function
+//	is called each time the player increases in level.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void Simulation::ChangeGravity()
+{
+	// Gravity is increased to an increased percentage of the previous gravity (in case of
+	// commenting, it is increased to 110% of what it was before).  
+	State.gravity += (State.gravity * Params.gravIncrease);
+}
+
+//	Function to change the colours for the ring & ball.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void Simulation::ChangeColours()
+{
+	bool valid = false;		// Check that there's a block available for the player to hit
+							// on each switch.  
+
+	// Picks a new colour at random and assigns it to the ball.  
+	State.ballColour = State.Random.Below(NUM_COLOURS);
+
+	// For each block, a new colour is picked at random and assigned to it.  
+	for (int i = 0 ; i < NUM_BLOCKS ; i++)
+	{
+		State.blockColour[i] = State.Random.Below(NUM_COLOURS);
+
+		// If the block's new colour matches that of the ball, mark it as such.  
+		if (State.blockColour[i] == State.ballColour)
+			valid = true;
+	}
+
+	// If, after generating each block, none of them match the same colour as the ball...  
+	if (!valid)
+	{
+		// A block is picked at random.  This block then takes the same colour as the ball.  
+		State.blockColour[State.Random.Below(NUM_BLOCKS)] = State.ballColour;
+	}
+}
+
+//	Function to increase the score of the game.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void Simulation::IncreaseScore()
+{
+	State.bounces++;					// Counts the bounce towards the session total.  
+
+	State.score++;						// Increments the score by 1.  
+	if (State.score == State.level)		// If the score matches that of the level...  
+	{
+		State.level++;					// Increases the attained level.  
+		State.score = 0;				// Resets the score to 0.  
+		this->ChangeGravity();			// Increases the gravitational pull of the ball.  
+	}
+}
+
+//	Function to find the stored flight for the current gravity & check that the current
+//	state lies on it.  The shared flights are used where they cover the level, and
+//	otherwise the session's own flight is built whenever the gravity has changed.
+//	Every flight in a game starts from a bounce, so this only fails (returning NULL) for
+//	states pieced together by hand.  
+//////////////////////////////////////////////////////////////////////////////////////////
+Trajectory* Simulation::OnFlight()
+{
+	Trajectory* Current = NULL;
+
+	// Looks for the flight in the shared set first.  
+	if (this->Flights)
+		Current = this->Flights->Find(State.level, State.gravity, Params.launchVelocity);
+
+	// Otherwise uses the session's own, building it if it's out of date.  
+	if (!Current)
+	{
+		if (!Flight.Matches(State.gravity, Params.launchVelocity))
+			Flight.Build(State.gravity, Params.launchVelocity);
+		Current = &Flight;
+	}
+
+	if ((State.t < 0) || (State.t >= Current->GetLength()) ||
+		(Current->Height(State.t) != State.y))
+		return NULL;
+
+	return Current;
+}
\ No newline at end of file
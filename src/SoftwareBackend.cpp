@@ -0,0 +1,686 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	SOFTWARE BACKEND MODULE																//
+//	Draws frames on the CPU into memory, so the game can be rendered where there is no	//
+//	Direct3D.  Vertices are lit & projected as each subset is drawn, and the triangles	//
+//	are set up & sorted into the tiles of the screen they touch.  Once the frame is		//
+//	finished, the tiles are filled in on every core at once, each tile by one thread	//
+//	from start to end, so no two threads ever touch the same pixel.  The stencil buffer	//
+//	keeps a byte for each pixel & works as Direct3D is set up to, so the ball's shadow	//
+//	only darkens each pixel once.														//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "SoftwareBackend.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>			// Standard I/O library, for writing images.  
+#include <string.h>			// Standard memory functions.  
+#include <math.h>			// Standard math library.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	The layout of a lit & projected vertex, & the render states kept with a triangle.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define VERTEX_FLOATS		8		// x, y, z, 1 / w, r, g, b & a.  
+
+#define DRAW_DEPTH			0x1		// The triangle is tested against the depth buffer.  
+#define DRAW_BLEND			0x2		// The triangle is blended by its alpha.  
+#define DRAW_STENCIL		0x4		// The triangle is drawn through the stencil buffer.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Class constructor.  The frame is split into tiles, & the given number of threads are
+//	set aside for filling them in (0 for one per core).  The render states start off as
+//	Direct3D's own do.  
+//////////////////////////////////////////////////////////////////////////////////////////
+SoftwareBackend::SoftwareBackend(int width, int height, int threads)
+: Workers(threads)
+{
+	this->width = width;
+	this->height = height;
+	this->tilesWide = (width + TILE_SIZE - 1) / TILE_SIZE;
+	this->tilesHigh = (height + TILE_SIZE - 1) / TILE_SIZE;
+
+	Colour.assign(width * height, 0);
+	Depth.assign(width * height, 1.0f);
+	Stencil.assign(width * height, 0);
+	Marked.assign(tilesWide * tilesHigh, 1);
+	Bins.resize(tilesWide * tilesHigh);
+	Filled.assign(Workers.GetThreadCount(), 0);
+
+	for (int i = 0 ; i < TRANSFORM_COUNT ; i++)
+		Transforms[i] = Matrix::Identity();
+
+	memset(&Material, 0, sizeof(Material));
+	memset(&Lamp, 0, sizeof(Lamp));
+
+	States[STATE_LIGHTING]	= 1;
+	States[STATE_AMBIENT]	= 0;
+	States[STATE_BLEND]		= 0;
+	States[STATE_DEPTH]		= 1;
+	States[STATE_STENCIL]	= 0;
+
+	this->clearFlags = 0;
+	this->clearStencil = 0;
+	this->kernel = RasterKernels::GetBest();
+	this->clearColour = 0;
+	this->clearDepth = 1.0f;
+	this->frameStart = 0;
+
+	memset(&Timing, 0, sizeof(Timing));
+	memset(&Current, 0, sizeof(Current));
+}
+
+//	Function to report what the backend is.  
+//////////////////////////////////////////////////////////////////////////////////////////
+const char* SoftwareBackend::GetName()
+{
+	return "Software";
+}
+
+//	Function to report the width of the frame in pixels.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int SoftwareBackend::GetWidth()
+{
+	return this->width;
+}
+
+//	Function to report the height of the frame in pixels.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int SoftwareBackend::GetHeight()
+{
+	return this->height;
+}
+
+//	Function to make a mesh from a level of detail.  The faces are sorted by material so
+//	that each subset lies in one run, as D3DX meshes do, and the start & length of each
+//	run is kept.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int SoftwareBackend::CreateMesh(const MeshView& Level)
+{
+	SoftMesh Mesh;
+	Mesh.Vertices.assign(Level.Vertices, Level.Vertices + Level.numVertices);
+	Mesh.live = true;
+
+	unsigned int subsets = 0;
+	for (unsigned int f = 0 ; f < Level.numFaces ; f++)
+		if (Level.Attributes[f] + 1 > subsets)
+			subsets = Level.Attributes[f] + 1;
+
+	// Counts the faces in each subset, then works out where each subset starts.  
+	Mesh.Subsets.assign(subsets * 2, 0);
+	for (unsigned int f = 0 ; f < Level.numFaces ; f++)
+		Mesh.Subsets[Level.Attributes[f] * 2 + 1]++;
+
+	unsigned int first = 0;
+	for (unsigned int s = 0 ; s < subsets ; s++)
+	{
+		Mesh.Subsets[s * 2] = first;
+		first += Mesh.Subsets[s * 2 + 1];
+	}
+
+	// Copies each face into its subset's run, keeping the faces in their order.  
+	std::vector<unsigned int> Next(subsets);
+	for (unsigned int s = 0 ; s < subsets ; s++)
+		Next[s] = Mesh.Subsets[s * 2];
+
+	Mesh.Indices.resize(Level.numFaces * 3);
+	for (unsigned int f = 0 ; f < Level.numFaces ; f++)
+	{
+		unsigned int to = Next[Level.Attributes[f]]++;
+		for (int i = 0 ; i < 3 ; i++)
+			Mesh.Indices[to * 3 + i] = Level.Indices[f * 3 + i];
+	}
+
+	Models.push_back(Mesh);
+	return (int)Models.size() - 1;
+}
+
+//	Function to free a mesh.  Its number isn't handed out again.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void SoftwareBackend::DestroyMesh(int mesh)
+{
+	if ((mesh < 0) || (mesh >= (int)Models.size()))
+		return;
+
+	std::vector<MeshVertex>().swap(Models[mesh].Vertices);
+	std::vector<unsigned int>().swap(Models[mesh].Indices);
+	std::vector<unsigned int>().swap(Models[mesh].Subsets);
+	Models[mesh].live = false;
+}
+
+//	Function to report the number of triangles in a mesh.  
+//////////////////////////////////////////////////////////////////////////////////////////
+unsigned int SoftwareBackend::GetFaceCount(int mesh)
+{
+	if ((mesh < 0) || (mesh >= (int)Models.size()))
+		return 0;
+	return (unsigned int)(Models[mesh].Indices.size() / 3);
+}
+
+//	Function to report the memory a mesh takes up.  
+//////////////////////////////////////////////////////////////////////////////////////////
+size_t SoftwareBackend::GetMeshBytes(int mesh)
+{
+	if ((mesh < 0) || (mesh >= (int)Models.size()))
+		return 0;
+
+	const SoftMesh& Mesh = Models[mesh];
+	return Mesh.Vertices.size() * sizeof(MeshVertex) +
+		   (Mesh.Indices.size() + Mesh.Subsets.size()) * sizeof(unsigned int);
+}
+
+//	Function to start a frame, starting its timings afresh.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void SoftwareBackend::BeginScene()
+{
+	memset(&Current, 0, sizeof(Current));
+	frameStart = Time.Now();
+}
+
+//	Function to finish drawing a frame, filling in every triangle drawn.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void SoftwareBackend::EndScene()
+{
+	this->Rasterise();
+}
+
+//	Function to finish a frame.  The frame is already in memory, so all that is left is
+//	to keep its timings.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void SoftwareBackend::Present()
+{
+	Current.frame = Time.Now() - frameStart;
+	Timing = Current;
+}
+
+//	Function to clear the given buffers.  Nothing is cleared straight away; each tile is
+//	cleared as it is filled in, by the thread filling it.  Anything drawn before the
+//	clear is filled in first.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void SoftwareBackend::Clear(unsigned int flags, unsigned int colour, float depth,
+							unsigned int stencil)
+{
+	if (!Triangles.empty())
+		this->Rasterise();
+
+	if (flags & CLEAR_TARGET)
+		clearColour = colour & 0x00ffffff;
+	if (flags & CLEAR_DEPTH)
+		clearDepth = depth;
+	if (flags & CLEAR_STENCIL)
+		clearStencil = (unsigned char)stencil;
+
+	clearFlags |= flags;
+}
+
+//	Function to set one of the transforms.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void SoftwareBackend::SetTransform(int type, const Matrix& Transform)
+{
+	if ((type >= 0) && (type < TRANSFORM_COUNT))
+		Transforms[type] = Transform;
+}
+
+//	Function to report one of the transforms.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void SoftwareBackend::GetTransform(int type, Matrix& Transform)
+{
+	if ((type >= 0) && (type < TRANSFORM_COUNT))
+		Transform = Transforms[type];
+}
+
+//	Function to set the material.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void SoftwareBackend::SetMaterial(const RenderMaterial& Material)
+{
+	this->Material = Material;
+}
+
+//	Function to set the light.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void SoftwareBackend::SetLight(const RenderLight& Light)
+{
+	this->Lamp = Light;
+}
+
+//	Function to set one of the render states.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void SoftwareBackend::SetRenderState(int state, unsigned int value)
+{
+	if ((state >= 0) && (state < STATE_COUNT))
+		States[state] = value;
+}
+
+//	Function to draw a subset of a mesh.  Every vertex of the mesh is lit & projected,
+//	then each face in the subset is set up & placed in the tiles it touches.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void SoftwareBackend::DrawSubset(int mesh, unsigned int subset)
+{
+	if ((mesh < 0) || (mesh >= (int)Models.size()) || !Models[mesh].live)
+		return;
+
+	const SoftMesh& Mesh = Models[mesh];
+	if (subset * 2 >= Mesh.Subsets.size())
+		return;
+
+	long long start = Time.Now();
+
+	this->Light(Mesh);
+
+	unsigned int first = Mesh.Subsets[subset * 2];
+	unsigned int count = Mesh.Subsets[subset * 2 + 1];
+	const float* Vertex = &Projected[0];
+
+	for (unsigned int f = first ; f < first + count ; f++)
+		this->Setup(Vertex + Mesh.Indices[f * 3] * VERTEX_FLOATS,
+					Vertex + Mesh.Indices[f * 3 + 1] * VERTEX_FLOATS,
+					Vertex + Mesh.Indices[f * 3 + 2] * VERTEX_FLOATS);
+
+	Current.triangles += count;
+	Current.geometry += Time.Now() - start;
+}
+
+//	Function to report the finished frame, row by row from the top, as 0x00RRGGBB.  
+//////////////////////////////////////////////////////////////////////////////////////////
+const unsigned int* SoftwareBackend::GetPixels()
+{
+	return &Colour[0];
+}
+
+//	Function to save the finished frame as a binary .ppm image.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool SoftwareBackend::WritePPM(const char* path)
+{
+	FILE* File = fopen(path, "wb");
+	if (!File)
+		return false;
+
+	fprintf(File, "P6\n%d %d\n255\n", width, height);
+
+	std::vector<unsigned char> Row(width * 3);
+	for (int y = 0 ; y < height ; y++)
+	{
+		const unsigned int* Pixel = &Colour[y * width];
+		for (int x = 0 ; x < width ; x++)
+		{
+			Row[x * 3]		= (unsigned char)(Pixel[x] >> 16);
+			Row[x * 3 + 1]	= (unsigned char)(Pixel[x] >> 8);
+			Row[x * 3 + 2]	= (unsigned char)Pixel[x];
+		}
+		fwrite(&Row[0], 1, Row.size(), File);
+	}
+
+	bool written = (ferror(File) == 0);
+	fclose(File);
+	return written;
+}
+
+//	Function to report the timings of the last finished frame.  
+//////////////////////////////////////////////////////////////////////////////////////////
+const SoftTiming& SoftwareBackend::GetTiming()
+{
+	return this->Timing;
+}
+
+//	Function to report the number of threads filling in tiles.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int SoftwareBackend::GetThreadCount()
+{
+	return Workers.GetThreadCount();
+}
+
+//	Function to choose the raster kernel tiles are filled in with.  Kernels the processor
+//	can't run are refused, leaving the current one in place.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool SoftwareBackend::SetKernel(int kernel)
+{
+	if ((kernel < 0) || (kernel >= RASTER_KERNELS) || !RasterKernels::IsSupported(kernel))
+		return false;
+
+	this->kernel = kernel;
+	return true;
+}
+
+//	Function to report the raster kernel in use.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int SoftwareBackend::GetKernel()
+{
+	return this->kernel;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PRIVATE METHODS
+//	Methods called from within the class for better organisation of the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to light & project every vertex of a mesh, as the fixed-function pipeline
+//	does.  Each vertex is lit in world space by the point light, with the diffuse light
+//	falling off with distance & ending at the light's range, and the ambient & emissive
+//	colours added; alpha comes from the diffuse material.  Vertices are then projected
+//	onto the screen & snapped to a sixteenth of a pixel, so that triangles sharing an edge
+//	see exactly the same edge.  A vertex too near the eye is marked with a 1 / w of 0.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void SoftwareBackend::Light(const SoftMesh& Mesh)
+{
+	const Matrix& World = Transforms[TRANSFORM_WORLD];
+	Matrix Clip = Matrix::Multiply(Matrix::Multiply(World, Transforms[TRANSFORM_VIEW]),
+								   Transforms[TRANSFORM_PROJECTION]);
+
+	bool lit = (States[STATE_LIGHTING] != 0);
+	unsigned int ambient = States[STATE_AMBIENT];
+	float Ambient[3] = { ((ambient >> 16) & 0xff) / 255.0f,
+						 ((ambient >> 8) & 0xff) / 255.0f,
+						 (ambient & 0xff) / 255.0f };
+
+	// The colour every vertex gets regardless of the light.  
+	float Base[3] = { Material.Emissive.r + Material.Ambient.r * Ambient[0],
+					  Material.Emissive.g + Material.Ambient.g * Ambient[1],
+					  Material.Emissive.b + Material.Ambient.b * Ambient[2] };
+
+	size_t count = Mesh.Vertices.size();
+	if (Projected.size() < count * VERTEX_FLOATS)
+		Projected.resize(count * VERTEX_FLOATS);
+
+	for (size_t i = 0 ; i < count ; i++)
+	{
+		const MeshVertex& Vertex = Mesh.Vertices[i];
+		const float* p = Vertex.position;
+		float* Out = &Projected[i * VERTEX_FLOATS];
+
+		Vector4 Clipped = Clip.Transform(p);
+		float x = Clipped.x, y = Clipped.y, z = Clipped.z, w = Clipped.w;
+
+		if (w < NEAR_W)						// If the vertex is too near the eye...  
+		{
+			Out[3] = 0.0f;
+			continue;
+		}
+
+		float invW = 1.0f / w;
+		Out[0] = floorf((x * invW + 1.0f) * 0.5f * width * SUBPIXEL_STEPS + 0.5f) / SUBPIXEL_STEPS;
+		Out[1] = floorf((1.0f - y * invW) * 0.5f * height * SUBPIXEL_STEPS + 0.5f) / SUBPIXEL_STEPS;
+		Out[2] = z * invW;
+		Out[3] = invW;
+
+		if (!lit)							// Unlit vertices are left white.  
+		{
+			Out[4] = Out[5] = Out[6] = Out[7] = 1.0f;
+			continue;
+		}
+
+		float Position[3], Normal[3];
+		World.TransformCoord(p, Position);
+		World.TransformNormal(Vertex.normal, Normal);
+
+		float length = sqrtf(Normal[0] * Normal[0] + Normal[1] * Normal[1] + Normal[2] * Normal[2]);
+		if (length > 0.0f)
+		{
+			Normal[0] /= length;	Normal[1] /= length;	Normal[2] /= length;
+		}
+
+		// Works out how much of the light reaches the vertex.  
+		float ToLight[3] = { Lamp.position[0] - Position[0],
+							 Lamp.position[1] - Position[1],
+							 Lamp.position[2] - Position[2] };
+		float distance = sqrtf(ToLight[0] * ToLight[0] + ToLight[1] * ToLight[1] +
+							   ToLight[2] * ToLight[2]);
+		float diffuse = 0.0f;
+
+		if ((distance <= Lamp.range) && (distance > 0.0f))
+		{
+			float facing = (Normal[0] * ToLight[0] + Normal[1] * ToLight[1] +
+							Normal[2] * ToLight[2]) / distance;
+			float fade = Lamp.attenuation[0] + Lamp.attenuation[1] * distance +
+						 Lamp.attenuation[2] * distance * distance;
+
+			if ((facing > 0.0f) && (fade > 0.0f))
+				diffuse = facing / fade;
+		}
+
+		float r = Base[0] + Material.Diffuse.r * Lamp.Diffuse.r * diffuse;
+		float g = Base[1] + Material.Diffuse.g * Lamp.Diffuse.g * diffuse;
+		float b = Base[2] + Material.Diffuse.b * Lamp.Diffuse.b * diffuse;
+		float a = Material.Diffuse.a;
+
+		Out[4] = (r > 1.0f) ? 1.0f : ((r < 0.0f) ? 0.0f : r);
+		Out[5] = (g > 1.0f) ? 1.0f : ((g < 0.0f) ? 0.0f : g);
+		Out[6] = (b > 1.0f) ? 1.0f : ((b < 0.0f) ? 0.0f : b);
+		Out[7] = (a > 1.0f) ? 1.0f : ((a < 0.0f) ? 0.0f : a);
+	}
+}
+
+//	Function to set up a triangle from three lit & projected vertices.  Triangles too near
+//	the eye, facing away (counter-clockwise on screen, as Direct3D culls by default) or
+//	off the screen are dropped.  The rest have their edges & values turned into planes
+//	over the screen & are placed in the tiles they touch.  An edge passing exactly
+//	through a pixel's centre only takes the pixel if it is a top or left edge, so that
+//	triangles sharing an edge never both draw the same pixel.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void SoftwareBackend::Setup(const float* A, const float* B, const float* C)
+{
+	if ((A[3] <= 0.0f) || (B[3] <= 0.0f) || (C[3] <= 0.0f))
+	{
+		Current.culled++;
+		return;
+	}
+
+	double bx = B[0] - A[0], by = B[1] - A[1];
+	double cx = C[0] - A[0], cy = C[1] - A[1];
+	double area = bx * cy - by * cx;
+
+	if (area <= 0.0)						// If the triangle faces away...  
+	{
+		Current.culled++;
+		return;
+	}
+
+	SoftTriangle Triangle;
+
+	// Finds the pixels whose centres could lie inside.  
+	float left = fminf(A[0], fminf(B[0], C[0]));
+	float right = fmaxf(A[0], fmaxf(B[0], C[0]));
+	float top = fminf(A[1], fminf(B[1], C[1]));
+	float bottom = fmaxf(A[1], fmaxf(B[1], C[1]));
+
+	Triangle.box[0] = (int)fmaxf(floorf(left - 0.5f), 0.0f);
+	Triangle.box[1] = (int)fmaxf(floorf(top - 0.5f), 0.0f);
+	Triangle.box[2] = (int)fminf(ceilf(right - 0.5f), (float)(width - 1));
+	Triangle.box[3] = (int)fminf(ceilf(bottom - 0.5f), (float)(height - 1));
+
+	if ((Triangle.box[0] > Triangle.box[2]) || (Triangle.box[1] > Triangle.box[3]))
+	{
+		Current.culled++;						// The triangle is off the screen.  
+		return;
+	}
+
+	// Each edge runs from one vertex to the next, & is positive on the inside.  
+	const float* From[3] = { B, C, A };
+	const float* To[3] = { C, A, B };
+
+	for (int e = 0 ; e < 3 ; e++)
+	{
+		double a = -(double)(To[e][1] - From[e][1]);
+		double b = (double)(To[e][0] - From[e][0]);
+
+		Triangle.Edges[e][0] = a;
+		Triangle.Edges[e][1] = b;
+		Triangle.Edges[e][2] = -(a * From[e][0] + b * From[e][1]);
+		Triangle.topLeft[e] = (a > 0.0) || ((a == 0.0) && (b > 0.0));
+	}
+
+	// Each value, v = v0 + dx (x - x0) + dy (y - y0), is stored as dx, dy & its value
+	// at the origin.  
+	double Values[6][3] = {
+		{ A[2], B[2], C[2] },
+		{ A[3], B[3], C[3] },
+		{ A[4] * A[3], B[4] * B[3], C[4] * C[3] },
+		{ A[5] * A[3], B[5] * B[3], C[5] * C[3] },
+		{ A[6] * A[3], B[6] * B[3], C[6] * C[3] },
+		{ A[7] * A[3], B[7] * B[3], C[7] * C[3] } };
+
+	for (int v = 0 ; v < 6 ; v++)
+	{
+		double db = Values[v][1] - Values[v][0];
+		double dc = Values[v][2] - Values[v][0];
+		double dx = (db * cy - dc * by) / area;
+		double dy = (dc * bx - db * cx) / area;
+
+		Triangle.Planes[v][0] = dx;
+		Triangle.Planes[v][1] = dy;
+		Triangle.Planes[v][2] = Values[v][0] - dx * A[0] - dy * A[1];
+	}
+
+	Triangle.states = (States[STATE_DEPTH] ? DRAW_DEPTH : 0) |
+					  (States[STATE_BLEND] ? DRAW_BLEND : 0) |
+					  (States[STATE_STENCIL] ? DRAW_STENCIL : 0);
+
+	Triangles.push_back(Triangle);
+	this->Bin((int)Triangles.size() - 1);
+}
+
+//	Function to place a triangle in every tile its box touches.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void SoftwareBackend::Bin(int triangle)
+{
+	const int* box = Triangles[triangle].box;
+
+	for (int ty = box[1] / TILE_SIZE ; ty <= box[3] / TILE_SIZE ; ty++)
+		for (int tx = box[0] / TILE_SIZE ; tx <= box[2] / TILE_SIZE ; tx++)
+		{
+			Bins[ty * tilesWide + tx].push_back(triangle);
+			Current.binned++;
+		}
+}
+
+//	Function to fill in every tile on the worker threads, along with any clear waiting,
+//	and then empty the tiles ready for more triangles.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void SoftwareBackend::Rasterise()
+{
+	if (Triangles.empty() && !clearFlags)
+		return;
+
+	long long start = Time.Now();
+
+	for (size_t i = 0 ; i < Filled.size() ; i++)
+		Filled[i] = 0;
+
+	Workers.Run(tilesWide * tilesHigh, &SoftwareBackend::FillTask, this);
+
+	for (size_t i = 0 ; i < Filled.size() ; i++)
+		Current.pixels += Filled[i];
+
+	for (size_t i = 0 ; i < Bins.size() ; i++)
+		Bins[i].clear();
+	Triangles.clear();
+	clearFlags = 0;
+
+	Current.raster += Time.Now() - start;
+}
+
+//	Function to fill in a single tile.  The tile is cleared first if a clear is waiting,
+//	then each triangle in it is handed to the raster kernel in the order drawn.  Each
+//	plane is worked out at the tile's corner in double precision, so that within the tile
+//	only small offsets are added in single precision & an edge shared by two triangles
+//	comes out the same for both.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void SoftwareBackend::FillTile(int tile, int worker)
+{
+	int x0 = (tile % tilesWide) * TILE_SIZE;
+	int y0 = (tile / tilesWide) * TILE_SIZE;
+	int x1 = (x0 + TILE_SIZE < width) ? x0 + TILE_SIZE : width;
+	int y1 = (y0 + TILE_SIZE < height) ? y0 + TILE_SIZE : height;
+
+	for (int y = y0 ; y < y1 ; y++)
+	{
+		if (clearFlags & CLEAR_TARGET)
+			for (int x = x0 ; x < x1 ; x++)
+				Colour[y * width + x] = clearColour;
+		if (clearFlags & CLEAR_DEPTH)
+			for (int x = x0 ; x < x1 ; x++)
+				Depth[y * width + x] = clearDepth;
+	}
+
+	// Only clears the stencil if something has been drawn through it since the last
+	// time, which for the shadow is just the few tiles under the ball.  
+	if ((clearFlags & CLEAR_STENCIL) && (Marked[tile] != clearStencil + 1))
+	{
+		for (int y = y0 ; y < y1 ; y++)
+			memset(&Stencil[y * width + x0], clearStencil, x1 - x0);
+		Marked[tile] = clearStencil + 1;
+	}
+
+	const std::vector<int>& Bin = Bins[tile];
+	RasterKernel Fill = RasterKernels::Get(kernel);
+	long long filled = 0;
+
+	for (size_t t = 0 ; t < Bin.size() ; t++)
+	{
+		const SoftTriangle& Triangle = Triangles[Bin[t]];
+
+		RasterJob Job;
+		Job.x0 = x0;
+		Job.y0 = y0;
+		Job.left = (Triangle.box[0] > x0) ? Triangle.box[0] : x0;
+		Job.top = (Triangle.box[1] > y0) ? Triangle.box[1] : y0;
+		Job.right = (Triangle.box[2] < x1 - 1) ? Triangle.box[2] : x1 - 1;
+		Job.bottom = (Triangle.box[3] < y1 - 1) ? Triangle.box[3] : y1 - 1;
+
+		// Moves every plane to the tile's corner.  
+		for (int e = 0 ; e < 3 ; e++)
+		{
+			Job.Edges[e][0] = (float)Triangle.Edges[e][0];
+			Job.Edges[e][1] = (float)Triangle.Edges[e][1];
+			Job.Edges[e][2] = (float)(Triangle.Edges[e][0] * x0 + Triangle.Edges[e][1] * y0 +
+									 Triangle.Edges[e][2]);
+			Job.topLeft[e] = Triangle.topLeft[e];
+		}
+		for (int v = 0 ; v < 6 ; v++)
+		{
+			Job.Planes[v][0] = (float)Triangle.Planes[v][0];
+			Job.Planes[v][1] = (float)Triangle.Planes[v][1];
+			Job.Planes[v][2] = (float)(Triangle.Planes[v][0] * x0 + Triangle.Planes[v][1] * y0 +
+									  Triangle.Planes[v][2]);
+		}
+
+		Job.depth = (Triangle.states & DRAW_DEPTH) != 0;
+		Job.blend = (Triangle.states & DRAW_BLEND) != 0;
+		Job.stencil = (Triangle.states & DRAW_STENCIL) != 0;
+		Job.Colour = &Colour[0];
+		Job.Depth = &Depth[0];
+		Job.Stencil = &Stencil[0];
+		Job.width = width;
+
+		// The tile's stencil is no longer all one value.  
+		if (Job.stencil)
+			Marked[tile] = 0;
+
+		filled += Fill(Job);
+	}
+
+	Filled[worker] += filled;
+}
+
+//	Function run by the worker threads for each tile.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void SoftwareBackend::FillTask(int task, int worker, void* context)
+{
+	((SoftwareBackend*)context)->FillTile(task, worker);
+}
\ No newline at end of file
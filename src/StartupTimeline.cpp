@@ -0,0 +1,124 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	STARTUP TIMELINE MODULE																//
+//	Records how long each part of starting the game takes, from launch to the first		//
+//	frame.  Parts may run side by side on different threads, so each is kept as its		//
+//	own span of time with the thread it ran on, rather than as one list of steps.		//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "StartupTimeline.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>			// Standard I/O library, for describing spans.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Class constructor.  
+//////////////////////////////////////////////////////////////////////////////////////////
+StartupTimeline::StartupTimeline(Clock* Time)
+{
+	this->Time = Time;
+	this->Start();
+}
+
+//	Function to start the timeline afresh from the present moment.  The thread calling
+//	it is taken to be the main thread.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void StartupTimeline::Start()
+{
+	std::lock_guard<std::mutex> Guard(Lock);
+
+	Spans.clear();
+	Main = std::this_thread::get_id();
+	start = Time->Now();
+}
+
+//	Function to start a span, returning its number for ending it later.  Safe to call
+//	from any thread.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int StartupTimeline::Begin(const char* Name)
+{
+	TimelineSpan Span;
+	snprintf(Span.Name, sizeof(Span.Name), "%s", Name);
+	Span.start = Time->Now() - start;
+	Span.end = -1;
+
+	std::lock_guard<std::mutex> Guard(Lock);
+	Span.worker = (std::this_thread::get_id() != Main);
+	Spans.push_back(Span);
+	return (int)Spans.size() - 1;
+}
+
+//	Function to end a span.  Safe to call from any thread.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void StartupTimeline::End(int span)
+{
+	long long now = Time->Now() - start;
+
+	std::lock_guard<std::mutex> Guard(Lock);
+	if ((span >= 0) && (span < (int)Spans.size()))
+		Spans[span].end = now;
+}
+
+//	Function to report the number of spans recorded.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int StartupTimeline::GetSpanCount()
+{
+	std::lock_guard<std::mutex> Guard(Lock);
+	return (int)Spans.size();
+}
+
+//	Function to report when the last span to finish ended, which for a full startup is
+//	the time taken to the first frame.  
+//////////////////////////////////////////////////////////////////////////////////////////
+long long StartupTimeline::GetLength()
+{
+	std::lock_guard<std::mutex> Guard(Lock);
+
+	long long length = 0;
+	for (size_t i = 0 ; i < Spans.size() ; i++)
+		if (Spans[i].end > length)
+			length = Spans[i].end;
+	return length;
+}
+
+//	Function to describe a span as a line of text: when it started & ended, how long it
+//	took, the thread it ran on & what it was.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void StartupTimeline::Format(int span, char* Line, int length)
+{
+	std::lock_guard<std::mutex> Guard(Lock);
+
+	if ((span < 0) || (span >= (int)Spans.size()))
+	{
+		snprintf(Line, length, "no such span\n");
+		return;
+	}
+
+	const TimelineSpan& Span = Spans[span];
+	double begun = Span.start / (double)NS_PER_MS;
+
+	if (Span.end < 0)
+		snprintf(Line, length, "%8.2fms %10s %10s  %-6s  %s\n", begun, "...", "...",
+				 Span.worker ? "worker" : "main", Span.Name);
+	else
+		snprintf(Line, length, "%8.2fms %8.2fms %8.2fms  %-6s  %s\n", begun,
+				 Span.end / (double)NS_PER_MS, (Span.end - Span.start) / (double)NS_PER_MS,
+				 Span.worker ? "worker" : "main", Span.Name);
+}
\ No newline at end of file
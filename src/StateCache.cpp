@@ -0,0 +1,280 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	STATE CACHE MODULE																	//
+//	A backend that sits in front of another & keeps a copy of every render state,		//
+//	transform, material & light set on it.  Anything set again to what it already is is	//
+//	dropped rather than passed on, and the calls passed on & dropped are counted.		//
+//	Until something has been set through the cache its value isn't known, so the first	//
+//	set is always passed on.															//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "StateCache.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <string.h>			// Standard memory functions.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Class constructor.  Nothing is known about the target to start with.  
+//////////////////////////////////////////////////////////////////////////////////////////
+StateCache::StateCache(RenderBackend* Target)
+{
+	this->Target = Target;
+
+	this->Forget();
+	this->ResetCounts();
+}
+
+//	Function to report what the backend is.  
+//////////////////////////////////////////////////////////////////////////////////////////
+const char* StateCache::GetName()
+{
+	return Target->GetName();
+}
+
+//	Function to report the width of the target in pixels.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int StateCache::GetWidth()
+{
+	return Target->GetWidth();
+}
+
+//	Function to report the height of the target in pixels.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int StateCache::GetHeight()
+{
+	return Target->GetHeight();
+}
+
+//	Function to make a mesh in the target.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int StateCache::CreateMesh(const MeshView& Level)
+{
+	return Target->CreateMesh(Level);
+}
+
+//	Function to free a mesh in the target.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void StateCache::DestroyMesh(int mesh)
+{
+	Target->DestroyMesh(mesh);
+}
+
+//	Function to report the number of triangles in a mesh.  
+//////////////////////////////////////////////////////////////////////////////////////////
+unsigned int StateCache::GetFaceCount(int mesh)
+{
+	return Target->GetFaceCount(mesh);
+}
+
+//	Function to report the memory a mesh takes up.  
+//////////////////////////////////////////////////////////////////////////////////////////
+size_t StateCache::GetMeshBytes(int mesh)
+{
+	return Target->GetMeshBytes(mesh);
+}
+
+//	Function to start a frame.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void StateCache::BeginScene()
+{
+	Target->BeginScene();
+}
+
+//	Function to finish drawing a frame.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void StateCache::EndScene()
+{
+	Target->EndScene();
+}
+
+//	Function to show the finished frame.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void StateCache::Present()
+{
+	Target->Present();
+}
+
+//	Function to clear the given buffers.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void StateCache::Clear(unsigned int flags, unsigned int colour, float depth,
+					   unsigned int stencil)
+{
+	Target->Clear(flags, colour, depth, stencil);
+}
+
+//	Function to set a transform, if it differs from the one held.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void StateCache::SetTransform(int type, const Matrix& Transform)
+{
+	if ((type < 0) || (type >= TRANSFORM_COUNT))
+		return;
+
+	if (knownTransform[type] && (memcmp(&Transforms[type], &Transform, sizeof(Matrix)) == 0))
+	{
+		this->Count(CACHE_TRANSFORM, false);
+		return;
+	}
+
+	Transforms[type] = Transform;
+	knownTransform[type] = true;
+
+	Target->SetTransform(type, Transform);
+	this->Count(CACHE_TRANSFORM, true);
+}
+
+//	Function to report a transform.  Transforms held are reported without asking the
+//	target.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void StateCache::GetTransform(int type, Matrix& Transform)
+{
+	if ((type < 0) || (type >= TRANSFORM_COUNT))
+		return;
+
+	if (knownTransform[type])
+		Transform = Transforms[type];
+	else
+		Target->GetTransform(type, Transform);
+}
+
+//	Function to set the material, if it differs from the one held.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void StateCache::SetMaterial(const RenderMaterial& Material)
+{
+	if (knownMaterial && (memcmp(&this->Material, &Material, sizeof(Material)) == 0))
+	{
+		this->Count(CACHE_MATERIAL, false);
+		return;
+	}
+
+	this->Material = Material;
+	this->knownMaterial = true;
+
+	Target->SetMaterial(Material);
+	this->Count(CACHE_MATERIAL, true);
+}
+
+//	Function to set the light, if it differs from the one held.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void StateCache::SetLight(const RenderLight& Light)
+{
+	if (knownLight && (memcmp(&Lamp, &Light, sizeof(Light)) == 0))
+	{
+		this->Count(CACHE_LIGHT, false);
+		return;
+	}
+
+	this->Lamp = Light;
+	this->knownLight = true;
+
+	Target->SetLight(Light);
+	this->Count(CACHE_LIGHT, true);
+}
+
+//	Function to set a render state, if it differs from the one held.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void StateCache::SetRenderState(int state, unsigned int value)
+{
+	if ((state < 0) || (state >= STATE_COUNT))
+		return;
+
+	if (knownState[state] && (States[state] == value))
+	{
+		this->Count(CACHE_STATE, false);
+		return;
+	}
+
+	States[state] = value;
+	knownState[state] = true;
+
+	Target->SetRenderState(state, value);
+	this->Count(CACHE_STATE, true);
+}
+
+//	Function to draw a subset of a mesh.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void StateCache::DrawSubset(int mesh, unsigned int subset)
+{
+	Target->DrawSubset(mesh, subset);
+}
+
+//	Function to forget everything held, so the next set of each is passed on.  This is
+//	needed whenever the target is changed by anything other than the cache.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void StateCache::Forget()
+{
+	for (int i = 0 ; i < TRANSFORM_COUNT ; i++)
+		knownTransform[i] = false;
+	for (int i = 0 ; i < STATE_COUNT ; i++)
+		knownState[i] = false;
+
+	this->knownMaterial = false;
+	this->knownLight = false;
+}
+
+//	Function to start the counts afresh.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void StateCache::ResetCounts()
+{
+	memset(issued, 0, sizeof(issued));
+	memset(elided, 0, sizeof(elided));
+}
+
+//	Function to report the calls of a kind passed on to the target, or of every kind if
+//	given CACHE_KINDS.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int StateCache::GetIssued(int kind)
+{
+	if ((kind >= 0) && (kind < CACHE_KINDS))
+		return issued[kind];
+
+	int calls = 0;
+	for (int i = 0 ; i < CACHE_KINDS ; i++)
+		calls += issued[i];
+	return calls;
+}
+
+//	Function to report the calls of a kind dropped, or of every kind if given
+//	CACHE_KINDS.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int StateCache::GetElided(int kind)
+{
+	if ((kind >= 0) && (kind < CACHE_KINDS))
+		return elided[kind];
+
+	int calls = 0;
+	for (int i = 0 ; i < CACHE_KINDS ; i++)
+		calls += elided[i];
+	return calls;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PRIVATE METHODS
+//	Methods called from within the class for better organisation of the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to count a call as passed on or dropped.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void StateCache::Count(int kind, bool issued)
+{
+	if (issued)
+		this->issued[kind]++;
+	else
+		this->elided[kind]++;
+}
\ No newline at end of file
@@ -0,0 +1,206 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	TASK POOL MODULE																	//
+//	A work-stealing thread pool for spreading large numbers of independent tasks over	//
+//	every core.  The worker threads are started once & sleep between runs.  Each worker	//
+//	starts a run with its own share of the tasks, and once it has run out it steals		//
+//	from the other end of another worker's queue, so uneven task lengths never leave	//
+//	cores sitting idle.																	//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "TaskPool.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Class constructor.  A thread count of 0 or less makes one worker for each core.  The
+//	worker threads are started here & wait for work, so a run costs no more than waking
+//	them up; the calling thread is always the first worker, so it gets no thread.  
+//////////////////////////////////////////////////////////////////////////////////////////
+TaskPool::TaskPool(int threads)
+{
+	if (threads <= 0)
+		threads = (int)std::thread::hardware_concurrency();
+	if (threads <= 0)				// If the core count isn't known, use just the one.  
+		threads = 1;
+
+	this->Function = NULL;
+	this->context = NULL;
+	this->run = 0;
+	this->busy = 0;
+	this->closing = false;
+
+	for (int i = 0 ; i < threads ; i++)
+		Queues.push_back(new WorkQueue());
+
+	for (int i = 1 ; i < threads ; i++)
+		Threads.push_back(std::thread(&TaskPool::Wait, this, i));
+}
+
+//	Class destructor.  Tells the worker threads to finish, waits for them to do so &
+//	removes each of the worker queues.  
+//////////////////////////////////////////////////////////////////////////////////////////
+TaskPool::~TaskPool()
+{
+	{
+		std::lock_guard<std::mutex> Guard(Lock);
+		closing = true;
+	}
+	Wake.notify_all();
+
+	for (size_t i = 0 ; i < Threads.size() ; i++)
+		Threads[i].join();
+
+	for (size_t i = 0 ; i < Queues.size() ; i++)
+		delete Queues[i];
+}
+
+//	Function to run a batch of tasks across every worker.  The tasks are dealt out in
+//	contiguous blocks so that neighbouring tasks tend to run on the same worker; the
+//	calling thread acts as the first worker, and the function returns once every task
+//	has finished & every worker thread has gone back to waiting.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void TaskPool::Run(int tasks, TaskFunction Function, void* context)
+{
+	int threads = (int)Queues.size();
+
+	// Deals the tasks out between the workers.  
+	for (int i = 0 ; i < threads ; i++)
+	{
+		int first	= (int)(((long long)tasks * i) / threads);
+		int last	= (int)(((long long)tasks * (i + 1)) / threads);
+
+		Queues[i]->Tasks.clear();
+		Queues[i]->steals = 0;
+		for (int t = first ; t < last ; t++)
+			Queues[i]->Tasks.push_back(t);
+	}
+
+	// Wakes every worker besides the first, which is run on this thread.  
+	{
+		std::lock_guard<std::mutex> Guard(Lock);
+		this->Function	= Function;
+		this->context	= context;
+		busy = threads - 1;
+		run++;
+	}
+	Wake.notify_all();
+
+	this->Work(0);
+
+	// Waits for the other workers to run out of tasks.  
+	std::unique_lock<std::mutex> Guard(Lock);
+	Done.wait(Guard, [this] { return busy == 0; });
+}
+
+//	Function to report the number of workers in the pool.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int TaskPool::GetThreadCount()
+{
+	return (int)Queues.size();
+}
+
+//	Function to report how many tasks changed workers during the last run.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int TaskPool::GetSteals()
+{
+	int steals = 0;
+	for (size_t i = 0 ; i < Queues.size() ; i++)
+		steals += Queues[i]->steals;
+	return steals;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PRIVATE METHODS
+//	Methods called from within the class for better organisation of the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function holding each worker thread's main loop.  It sleeps until a run is started,
+//	works through the run's tasks without holding the lock, and reports back once it
+//	has run out, until the pool is closed.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void TaskPool::Wait(int worker)
+{
+	std::unique_lock<std::mutex> Guard(Lock);
+	int seen = 0;				// The last run this worker took part in.  
+
+	while (true)
+	{
+		Wake.wait(Guard, [this, seen] { return (run != seen) || closing; });
+
+		if (closing)
+			return;
+		seen = run;
+
+		Guard.unlock();
+		this->Work(worker);
+		Guard.lock();
+
+		if (--busy == 0)		// If this was the last worker still going...  
+			Done.notify_one();
+	}
+}
+
+//	Function to run tasks until there are none left.  Tasks are never added once a run
+//	has started, so a worker that can neither pop nor steal a task knows there is
+//	nothing left to do.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void TaskPool::Work(int worker)
+{
+	int task;
+
+	while (this->Pop(worker, task) || this->Steal(worker, task))
+		this->Function(task, worker, this->context);
+}
+
+//	Function to take the next task from the back of a worker's own queue.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool TaskPool::Pop(int worker, int& task)
+{
+	WorkQueue* Queue = Queues[worker];
+	std::lock_guard<std::mutex> Guard(Queue->Lock);
+
+	if (Queue->Tasks.empty())
+		return false;
+
+	task = Queue->Tasks.back();
+	Queue->Tasks.pop_back();
+	return true;
+}
+
+//	Function to take a task from the front of another worker's queue.  The victims are
+//	tried in turn starting from the next worker along, so thieves spread themselves out
+//	rather than all crowding the same queue.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool TaskPool::Steal(int worker, int& task)
+{
+	int threads = (int)Queues.size();
+
+	for (int i = 1 ; i < threads ; i++)
+	{
+		WorkQueue* Victim = Queues[(worker + i) % threads];
+		std::lock_guard<std::mutex> Guard(Victim->Lock);
+
+		if (!Victim->Tasks.empty())
+		{
+			task = Victim->Tasks.front();
+			Victim->Tasks.pop_front();
+			Queues[worker]->steals++;		// Only this worker ever writes its count.  
+			return true;
+		}
+	}
+
+	return false;
+}
\ No newline at end of file
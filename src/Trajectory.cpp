@@ -0,0 +1,192 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	TRAJECTORY MODULE																	//
+//	The flight of the ball from one launch.  Every flight starts from y = 0 at t = 0	//
+//	and only depends on the gravity in use, so the heights are worked out once per		//
+//	gravity & then looked up, letting the simulation jump straight from one event to	//
+//	the next.  The closed form of the motion is used to predict where the events fall,	//
+//	while the stored heights are built with the same per-tick sum as the simulation	//
+//	so that jumping gives bit-identical results to stepping.							//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "Trajectory.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <math.h>		// Standard math library.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Class constructor.  The flight is left empty until it is first built.  
+//////////////////////////////////////////////////////////////////////////////////////////
+Trajectory::Trajectory()
+{
+	this->gravity	= -1.0f;
+	this->velocity	= 0.0f;
+	this->contact	= 0;
+	this->passed	= 0;
+	this->fallen	= 0;
+}
+
+//	Function to work out the height of the ball at each tick of a flight.  The closed
+//	form predicts how long the flight lasts so the storage is set aside in one go, but
+//	the heights themselves are summed tick by tick exactly as Simulation::Translate
+//	does, as the closed form rounds differently to the running float sum.  If the ball
+//	would never fall, or not within MAX_FLIGHT_TICKS, nothing is stored & the flight is
+//	left empty, so the simulation steps the ball tick by tick instead.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void Trajectory::Build(float gravity, float velocity)
+{
+	this->gravity	= gravity;
+	this->velocity	= velocity;
+
+	Heights.clear();
+
+	this->contact	= MAX_FLIGHT_TICKS;
+	this->passed	= MAX_FLIGHT_TICKS;
+	this->fallen	= MAX_FLIGHT_TICKS;
+
+	// Predicts the length of the flight, giving up on any that never come down.  
+	double predicted = this->EstimateTick(FALLEN_DEPTH);
+	if ((predicted <= 0.0) || (predicted >= MAX_FLIGHT_TICKS - 16))
+		return;
+
+	Heights.reserve((size_t)predicted + 16);	// Leaves some room spare.  
+	Heights.push_back(0.0f);		// The flight starts at the ring.  
+
+	float y = 0.0f;
+
+	for (int t = 1 ; t < MAX_FLIGHT_TICKS ; t++)
+	{
+		y += SCALE * (velocity - (gravity * t));	// The same step as the simulation.  
+		Heights.push_back(y);
+
+		// Notes the first tick of each event along the flight.  
+		if ((this->contact == MAX_FLIGHT_TICKS) && (y > CONTACT_BOTTOM) && (y <= CONTACT_TOP))
+			this->contact = t;
+		if ((this->passed == MAX_FLIGHT_TICKS) && (y <= CONTACT_BOTTOM))
+			this->passed = t;
+		if (y < FALLEN_DEPTH)
+		{
+			this->fallen = t;
+			break;					// Nothing happens after the ball has fallen.  
+		}
+	}
+}
+
+//	Function to check whether the stored flight was built for the given values.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool Trajectory::Matches(float gravity, float velocity)
+{
+	return ((this->gravity == gravity) && (this->velocity == velocity));
+}
+
+//	Function to report the stored height of the ball at a given tick of the flight.  
+//////////////////////////////////////////////////////////////////////////////////////////
+float Trajectory::Height(int t)
+{
+	return Heights[t];
+}
+
+//	Function to report the height at a given tick from the closed form of the motion.  
+//	Summing "y += SCALE * (u - g * k)" for k = 1 to t gives
+//		y = SCALE * (u * t - g * t * (t + 1) / 2)
+//////////////////////////////////////////////////////////////////////////////////////////
+double Trajectory::Estimate(double t)
+{
+	return SCALE * ((this->velocity * t) - (this->gravity * t * (t + 1.0) / 2.0));
+}
+
+//	Function to report the tick, on the way down, at which the closed form reaches the
+//	given height.  This is the larger root of
+//		(g / 2) t^2 + (g / 2 - u) t + y / SCALE = 0
+//////////////////////////////////////////////////////////////////////////////////////////
+double Trajectory::EstimateTick(double y)
+{
+	double a = this->gravity / 2.0;
+	double b = a - this->velocity;
+	double c = y / SCALE;
+
+	double discriminant = (b * b) - (4.0 * a * c);
+	if ((a <= 0.0) || (discriminant < 0.0))		// If the ball never comes back down...  
+		return -1.0;
+
+	return (-b + sqrt(discriminant)) / (2.0 * a);
+}
+
+//	Function to report the first tick at which the ball touches the ring.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int Trajectory::GetContact()
+{
+	return this->contact;
+}
+
+//	Function to report the first tick at which the ball is past the ring.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int Trajectory::GetPassed()
+{
+	return this->passed;
+}
+
+//	Function to report the first tick at which the ball has fully fallen.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int Trajectory::GetFallen()
+{
+	return this->fallen;
+}
+
+//	Function to report how many ticks of the flight are stored.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int Trajectory::GetLength()
+{
+	return (int)Heights.size();
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	FLIGHT CACHE METHODS
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Class constructor.  Builds the flight for each level in turn, raising the gravity
+//	between levels just as Simulation::ChangeGravity does.  
+//////////////////////////////////////////////////////////////////////////////////////////
+FlightCache::FlightCache(float initialGravity, float gravIncrease, float velocity, int levels)
+{
+	float gravity = initialGravity;
+
+	Flights.resize(levels);
+	for (int i = 0 ; i < levels ; i++)
+	{
+		Flights[i].Build(gravity, velocity);
+		gravity += (gravity * gravIncrease);
+	}
+}
+
+//	Function to find the flight for the given level.  The gravity & velocity are checked
+//	as well, so a session with different tuning values is never given the wrong flight.  
+//////////////////////////////////////////////////////////////////////////////////////////
+Trajectory* FlightCache::Find(int level, float gravity, float velocity)
+{
+	if ((level < 1) || (level > (int)Flights.size()))
+		return NULL;
+
+	Trajectory* Flight = &Flights[level - 1];
+	if (!Flight->Matches(gravity, velocity))
+		return NULL;
+
+	return Flight;
+}
\ No newline at end of file
@@ -0,0 +1,308 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	VERTEX PACKER MODULE																//
+//	Squeezes vertices into less than half the space for storing on disk.  Positions are	//
+//	kept as 16-bit fractions of the mesh's bounding box, normals are folded onto an		//
+//	octahedron & kept as two 16-bit values, and texture co-ordinates are kept as half-	//
+//	precision floats.  Packed vertices are unpacked again before being handed to		//
+//	Direct3D, so packing only saves space on disk & is left for meshes where that		//
+//	matters more than the time taken to open them.										//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "VertexPacker.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <math.h>			// Standard math library.  
+#include <string.h>			// Standard string library, for reading float bits.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	The ranges of the packed values.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define POSITION_STEPS		65535.0f	// Steps across the bounding box.  
+#define NORMAL_STEPS		32767.0f	// Steps from the octahedron's centre to its edge.  
+#define DEGREES				57.29578f	// Degrees in a radian.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to find the box around a set of vertices.  An axis with no size is given a
+//	size of one, so that positions along it still divide out cleanly.  
+//////////////////////////////////////////////////////////////////////////////////////////
+PackedBounds VertexPacker::Measure(const MeshVertex* Vertices, unsigned int count)
+{
+	PackedBounds Bounds;
+	float Highest[3];
+
+	for (int axis = 0 ; axis < 3 ; axis++)
+	{
+		Bounds.origin[axis] = count ? Vertices[0].position[axis] : 0.0f;
+		Highest[axis] = Bounds.origin[axis];
+	}
+
+	for (unsigned int i = 1 ; i < count ; i++)
+		for (int axis = 0 ; axis < 3 ; axis++)
+		{
+			float value = Vertices[i].position[axis];
+			if (value < Bounds.origin[axis])
+				Bounds.origin[axis] = value;
+			if (value > Highest[axis])
+				Highest[axis] = value;
+		}
+
+	for (int axis = 0 ; axis < 3 ; axis++)
+	{
+		Bounds.extent[axis] = Highest[axis] - Bounds.origin[axis];
+		if (Bounds.extent[axis] <= 0.0f)
+			Bounds.extent[axis] = 1.0f;
+	}
+
+	return Bounds;
+}
+
+//	Function to pack a set of vertices inside the given box.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void VertexPacker::Pack(const MeshVertex* Vertices, unsigned int count,
+						const PackedBounds& Bounds, PackedVertex* Out)
+{
+	for (unsigned int i = 0 ; i < count ; i++)
+	{
+		for (int axis = 0 ; axis < 3 ; axis++)
+		{
+			float fraction = (Vertices[i].position[axis] - Bounds.origin[axis]) / Bounds.extent[axis];
+			fraction = (fraction < 0.0f) ? 0.0f : (fraction > 1.0f) ? 1.0f : fraction;
+			Out[i].position[axis] = (unsigned short)(fraction * POSITION_STEPS + 0.5f);
+		}
+
+		VertexPacker::PackNormal(Vertices[i].normal, Out[i].normal);
+		Out[i].uv[0] = VertexPacker::PackHalf(Vertices[i].uv[0]);
+		Out[i].uv[1] = VertexPacker::PackHalf(Vertices[i].uv[1]);
+	}
+}
+
+//	Function to unpack a set of vertices back into the layout Direct3D draws from.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void VertexPacker::Unpack(const PackedVertex* Vertices, unsigned int count,
+						  const PackedBounds& Bounds, MeshVertex* Out)
+{
+	float Step[3];				// The size of one step across the box on each axis.  
+	for (int axis = 0 ; axis < 3 ; axis++)
+		Step[axis] = Bounds.extent[axis] / POSITION_STEPS;
+
+	for (unsigned int i = 0 ; i < count ; i++)
+	{
+		for (int axis = 0 ; axis < 3 ; axis++)
+			Out[i].position[axis] = Bounds.origin[axis] + Vertices[i].position[axis] * Step[axis];
+
+		VertexPacker::UnpackNormal(Vertices[i].normal, Out[i].normal);
+		Out[i].uv[0] = VertexPacker::UnpackHalf(Vertices[i].uv[0]);
+		Out[i].uv[1] = VertexPacker::UnpackHalf(Vertices[i].uv[1]);
+	}
+}
+
+//	Function to measure how far a set of unpacked vertices strays from the originals
+//	they were packed from, at worst.  
+//////////////////////////////////////////////////////////////////////////////////////////
+PackedError VertexPacker::Compare(const MeshVertex* Original, const MeshVertex* Unpacked,
+								  unsigned int count)
+{
+	PackedError Error = { 0.0f, 0.0f, 0.0f };
+
+	for (unsigned int i = 0 ; i < count ; i++)
+	{
+		const MeshVertex& A = Original[i];
+		const MeshVertex& B = Unpacked[i];
+
+		float dx = A.position[0] - B.position[0];
+		float dy = A.position[1] - B.position[1];
+		float dz = A.position[2] - B.position[2];
+		float position = sqrtf(dx * dx + dy * dy + dz * dz);
+
+		// Measures the angle between the normals from both their sine & cosine, as the
+		// cosine alone can't tell apart angles this small.  
+		float cx = A.normal[1] * B.normal[2] - A.normal[2] * B.normal[1];
+		float cy = A.normal[2] * B.normal[0] - A.normal[0] * B.normal[2];
+		float cz = A.normal[0] * B.normal[1] - A.normal[1] * B.normal[0];
+		float sine = sqrtf(cx * cx + cy * cy + cz * cz);
+		float cosine = A.normal[0] * B.normal[0] + A.normal[1] * B.normal[1] +
+					   A.normal[2] * B.normal[2];
+		float normal = atan2f(sine, cosine) * DEGREES;
+
+		float du = fabsf(A.uv[0] - B.uv[0]);
+		float dv = fabsf(A.uv[1] - B.uv[1]);
+		float uv = (du > dv) ? du : dv;
+
+		if (position > Error.position)
+			Error.position = position;
+		if (normal > Error.normal)
+			Error.normal = normal;
+		if (uv > Error.uv)
+			Error.uv = uv;
+	}
+
+	return Error;
+}
+
+//	Function to check a measured error against the module's limits.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool VertexPacker::WithinLimits(const PackedError& Error)
+{
+	return (Error.position <= PACK_MAX_POSITION) && (Error.normal <= PACK_MAX_NORMAL) &&
+		   (Error.uv <= PACK_MAX_UV);
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PRIVATE METHODS
+//	Methods called from within the class for better organisation of the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to fold a normal onto an octahedron & flatten it into a square.  The top
+//	half of the octahedron lies in the middle of the square & the bottom half is folded
+//	out over the corners.  Rounding to the nearest step isn't always the closest normal
+//	once unfolded, so each of the four steps around the point is tried.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void VertexPacker::PackNormal(const float* Normal, short* Out)
+{
+	float sum = fabsf(Normal[0]) + fabsf(Normal[1]) + fabsf(Normal[2]);
+	if (sum <= 0.0f)
+	{
+		Out[0] = 0;
+		Out[1] = 0;
+		return;
+	}
+
+	float u = Normal[0] / sum;
+	float v = Normal[1] / sum;
+
+	if (Normal[2] < 0.0f)		// If the normal is on the bottom half...  
+	{
+		float folded = (1.0f - fabsf(v)) * ((u >= 0.0f) ? 1.0f : -1.0f);
+		v = (1.0f - fabsf(u)) * ((v >= 0.0f) ? 1.0f : -1.0f);
+		u = folded;
+	}
+
+	float best = -2.0f;
+	for (int i = 0 ; i < 4 ; i++)
+	{
+		short Packed[2];
+		Packed[0] = (short)((i & 1) ? ceilf(u * NORMAL_STEPS) : floorf(u * NORMAL_STEPS));
+		Packed[1] = (short)((i & 2) ? ceilf(v * NORMAL_STEPS) : floorf(v * NORMAL_STEPS));
+
+		float Unpacked[3];
+		VertexPacker::UnpackNormal(Packed, Unpacked);
+		float cosine = (Normal[0] * Unpacked[0] + Normal[1] * Unpacked[1] +
+						Normal[2] * Unpacked[2]);
+
+		if (cosine > best)
+		{
+			best = cosine;
+			Out[0] = Packed[0];
+			Out[1] = Packed[1];
+		}
+	}
+}
+
+//	Function to unfold a normal from the square back off the octahedron.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void VertexPacker::UnpackNormal(const short* Packed, float* Out)
+{
+	float u = Packed[0] / NORMAL_STEPS;
+	float v = Packed[1] / NORMAL_STEPS;
+	float z = 1.0f - fabsf(u) - fabsf(v);
+
+	if (z < 0.0f)				// If the normal is on the bottom half...  
+	{
+		float unfolded = (1.0f - fabsf(v)) * ((u >= 0.0f) ? 1.0f : -1.0f);
+		v = (1.0f - fabsf(u)) * ((v >= 0.0f) ? 1.0f : -1.0f);
+		u = unfolded;
+	}
+
+	float length = sqrtf(u * u + v * v + z * z);
+	Out[0] = u / length;
+	Out[1] = v / length;
+	Out[2] = z / length;
+}
+
+//	Function to convert a float to half precision, rounding to the nearest.  Values
+//	too large become infinite & values too small fade out through the denormals.  
+//////////////////////////////////////////////////////////////////////////////////////////
+unsigned short VertexPacker::PackHalf(float value)
+{
+	unsigned int bits;
+	memcpy(&bits, &value, sizeof(bits));
+
+	unsigned short sign = (unsigned short)((bits >> 16) & 0x8000);
+	int exponent = (int)((bits >> 23) & 0xff) - 127 + 15;
+	unsigned int mantissa = bits & 0x7fffff;
+
+	if (((bits >> 23) & 0xff) == 0xff)				// Infinity or not a number.  
+		return sign | 0x7c00 | (mantissa ? 0x200 : 0);
+	if (exponent >= 31)								// Too large.  
+		return sign | 0x7c00;
+	if (exponent <= 0)								// Too small for a normal half.  
+	{
+		if (exponent < -10)
+			return sign;
+
+		mantissa |= 0x800000;
+		int shift = 14 - exponent;
+		unsigned int half = mantissa >> shift;
+		unsigned int rest = mantissa & ((1u << shift) - 1);
+		unsigned int middle = 1u << (shift - 1);
+		if ((rest > middle) || ((rest == middle) && (half & 1)))
+			half++;
+		return sign | (unsigned short)half;
+	}
+
+	unsigned int half = ((unsigned int)exponent << 10) | (mantissa >> 13);
+	unsigned int rest = mantissa & 0x1fff;
+	if ((rest > 0x1000) || ((rest == 0x1000) && (half & 1)))
+		half++;										// Can carry into the exponent.  
+	return sign | (unsigned short)half;
+}
+
+//	Function to convert a half precision value back to a float.  
+//////////////////////////////////////////////////////////////////////////////////////////
+float VertexPacker::UnpackHalf(unsigned short half)
+{
+	unsigned int sign = (unsigned int)(half & 0x8000) << 16;
+	unsigned int exponent = (half >> 10) & 0x1f;
+	unsigned int mantissa = half & 0x3ff;
+	unsigned int bits;
+
+	if (exponent == 0x1f)							// Infinity or not a number.  
+		bits = sign | 0x7f800000 | (mantissa << 13);
+	else if (exponent)								// A normal half.  
+		bits = sign | ((exponent + 127 - 15) << 23) | (mantissa << 13);
+	else if (mantissa)								// A denormal, made normal.  
+	{
+		exponent = 127 - 15 + 1;
+		while (!(mantissa & 0x400))
+		{
+			mantissa <<= 1;
+			exponent--;
+		}
+		bits = sign | (exponent << 23) | ((mantissa & 0x3ff) << 13);
+	}
+	else
+		bits = sign;
+
+	float value;
+	memcpy(&value, &bits, sizeof(value));
+	return value;
+}
\ No newline at end of file
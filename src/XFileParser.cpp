@@ -0,0 +1,678 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	X FILE PARSER MODULE																//
+//	Reads meshes from DirectX .x files in the text format, without needing D3DX.  The	//
+//	file is read in a single pass straight from memory, picking up each Mesh along		//
+//	with its MeshNormals, MeshTextureCoords & MeshMaterialList, and anything else is	//
+//	skipped over.  Frames are searched for meshes, but their transforms are ignored.	//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	CLASS HEADER
+//////////////////////////////////////////////////////////////////////////////////////////
+#include "XFileParser.h"
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LIBRARY INCLUDES
+//	The libraries & namespaces required for the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>			// Standard I/O library, for building error messages.  
+#include <string.h>			// Standard string functions.  
+#include <charconv>			// Standard number conversions.  
+#include "MappedFile.h"		// Memory-mapped files.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MODULE DEFINES
+//	Limits that catch damaged files before they ask for silly amounts of memory.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define X_MAX_ELEMENTS		(1 << 24)	// The most of anything a mesh may list.  
+#define X_MAX_FACE_SIZE		64			// The most corners a face may have.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PUBLIC METHODS
+//	Methods called by other classes.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Class constructor.  
+//////////////////////////////////////////////////////////////////////////////////////////
+XFileParser::XFileParser()
+{
+	this->Output = NULL;
+	this->Begin = NULL;
+	this->Cursor = NULL;
+	this->End = NULL;
+	this->Error = NULL;
+}
+
+//	Function to map the given file into memory & parse it.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool XFileParser::Load(const char* path, MeshData& Mesh)
+{
+	MappedFile File;
+
+	if (!File.Open(path))
+	{
+		Begin = Cursor = End = NULL;
+		Error = NULL;
+		snprintf(Message, sizeof(Message), "Unable to open %s.", path);
+		return this->Fail(Message);
+	}
+
+	return this->Parse(File.GetData(), File.GetSize(), Mesh);
+}
+
+//	Function to parse a whole .x file held in memory.  Every mesh found is added to the
+//	output, which is emptied first.  Returns false if the text isn't a valid .x file, in
+//	which case GetError() says why.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool XFileParser::Parse(const char* Text, size_t size, MeshData& Mesh)
+{
+	Mesh.Clear();
+
+	Output = &Mesh;
+	Error = NULL;
+	Begin = Cursor = Text;
+	End = Text + size;
+	SharedNames.clear();
+	Shared.clear();
+
+	// The header gives the format as "xof 0303txt 0032"; only text files are handled.  
+	if ((size < 16) || (memcmp(Text, "xof ", 4) != 0))
+		return this->Fail("Not a .x file.");
+	if (memcmp(Text + 8, "txt ", 4) != 0)
+		return this->Fail("Only text .x files are supported.");
+
+	Cursor = Text + 16;
+
+	if (!this->ReadBlocks(false))
+		return false;
+	if (Mesh.Indices.empty())
+		return this->Fail("No meshes found.");
+
+	return true;
+}
+
+//	Function to describe why parsing failed.  
+//////////////////////////////////////////////////////////////////////////////////////////
+const char* XFileParser::GetError()
+{
+	return Error ? Error : "No error.";
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PRIVATE METHODS
+//	Methods called from within the class for better organisation of the module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//	Function to skip anything that carries no meaning: white space, the commas &
+//	semicolons separating values (which are redundant, as the counts given before every
+//	list already say how long it is), and comments.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void XFileParser::SkipSpace()
+{
+	while (Cursor < End)
+	{
+		char c = *Cursor;
+
+		if ((c == ' ') || (c == ',') || (c == ';') || (c == '\n') || (c == '\r') || (c == '\t'))
+			Cursor++;
+		else if ((c == '#') || ((c == '/') && (Cursor + 1 < End) && (Cursor[1] == '/')))
+		{
+			while ((Cursor < End) && (*Cursor != '\n'))
+				Cursor++;
+		}
+		else
+			return;
+	}
+}
+
+//	Function to check whether the next character is the given one.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool XFileParser::Peek(char c)
+{
+	this->SkipSpace();
+	return (Cursor < End) && (*Cursor == c);
+}
+
+//	Function to read the given character.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool XFileParser::Expect(char c)
+{
+	if (!this->Peek(c))
+	{
+		snprintf(Message, sizeof(Message), "Expected '%c'.", c);
+		return this->Fail(Message);
+	}
+
+	Cursor++;
+	return true;
+}
+
+//	Function to read an identifier.  Returns false, without recording an error, if the
+//	next thing in the text isn't one.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool XFileParser::ReadName(std::string& Name)
+{
+	this->SkipSpace();
+
+	const char* Start = Cursor;
+	while ((Cursor < End) && (((*Cursor >= 'a') && (*Cursor <= 'z')) ||
+		((*Cursor >= 'A') && (*Cursor <= 'Z')) || ((*Cursor >= '0') && (*Cursor <= '9')) ||
+		(*Cursor == '_') || (*Cursor == '-') || (*Cursor == '.')))
+		Cursor++;
+
+	Name.assign(Start, Cursor);
+	return (Cursor > Start);
+}
+
+//	Function to read a whole number.  Counts & indices make up much of a file, so they
+//	are read directly rather than going through the general number conversion.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool XFileParser::ReadInt(int& value)
+{
+	this->SkipSpace();
+
+	bool negative = (Cursor < End) && (*Cursor == '-');
+	if (negative)
+		Cursor++;
+
+	if ((Cursor >= End) || (*Cursor < '0') || (*Cursor > '9'))
+		return this->Fail("Expected a whole number.");
+
+	unsigned int total = 0;
+	while ((Cursor < End) && (*Cursor >= '0') && (*Cursor <= '9'))
+	{
+		total = (total * 10) + (unsigned int)(*Cursor - '0');
+		if (total > 0x7fffffff)
+			return this->Fail("Number out of range.");
+		Cursor++;
+	}
+
+	value = negative ? -(int)total : (int)total;
+	return true;
+}
+
+//	Function to read a decimal number, using the standard library's locale-free
+//	conversion, which rounds correctly & is far faster than strtod() or sscanf().  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool XFileParser::ReadFloat(float& value)
+{
+	this->SkipSpace();
+
+	std::from_chars_result Result = std::from_chars(Cursor, End, value);
+	if (Result.ec != std::errc())
+		return this->Fail("Expected a decimal number.");
+
+	Cursor = Result.ptr;
+	return true;
+}
+
+//	Function to read the given number of decimal numbers in a row.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool XFileParser::ReadFloats(float* Values, int count)
+{
+	for (int i = 0 ; i < count ; i++)
+		if (!this->ReadFloat(Values[i]))
+			return false;
+
+	return true;
+}
+
+//	Function to read a quoted string, cutting it short if it doesn't fit.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool XFileParser::ReadString(char* Text, int length)
+{
+	if (!this->Expect('"'))
+		return false;
+
+	int used = 0;
+	while ((Cursor < End) && (*Cursor != '"'))
+	{
+		if (used < length - 1)
+			Text[used++] = *Cursor;
+		Cursor++;
+	}
+	Text[used] = '\0';
+
+	return this->Expect('"');
+}
+
+//	Function to read the opening of a block, which may be given a name first.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool XFileParser::OpenBlock()
+{
+	std::string Name;
+
+	this->ReadName(Name);
+	return this->Expect('{');
+}
+
+//	Function to skip the rest of a block whose opening brace has been read, including
+//	any blocks inside it.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool XFileParser::SkipBlock()
+{
+	int depth = 1;
+
+	while (Cursor < End)
+	{
+		char c = *Cursor++;
+
+		if (c == '{')
+			depth++;
+		else if ((c == '}') && (--depth == 0))
+			return true;
+		else if (c == '"')
+		{
+			while ((Cursor < End) && (*Cursor != '"'))
+				Cursor++;
+			Cursor++;
+		}
+	}
+
+	return this->Fail("Unexpected end of file inside a block.");
+}
+
+//	Function to read blocks until the end of the file, or until the end of the block
+//	holding them if nested.  Meshes & materials are read, frames are searched for more
+//	blocks, and anything else is skipped.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool XFileParser::ReadBlocks(bool nested)
+{
+	std::string Type;
+
+	while (true)
+	{
+		this->SkipSpace();
+		if (Cursor >= End)
+			return nested ? this->Fail("Unexpected end of file inside a frame.") : true;
+
+		if (*Cursor == '}')
+		{
+			if (!nested)
+				return this->Fail("Unexpected '}'.");
+			Cursor++;
+			return true;
+		}
+
+		if (!this->ReadName(Type))
+			return this->Fail("Expected a block.");
+
+		if (Type == "template")
+		{
+			if (!this->OpenBlock() || !this->SkipBlock())
+				return false;
+		}
+		else if (Type == "Mesh")
+		{
+			if (!this->OpenBlock() || !this->ReadMesh())
+				return false;
+		}
+		else if (Type == "Frame")
+		{
+			if (!this->OpenBlock() || !this->ReadBlocks(true))
+				return false;
+		}
+		else if (Type == "Material")
+		{
+			// Keeps materials defined on their own, so that meshes can refer to them.  
+			std::string Name;
+			MeshMaterial Material;
+
+			this->ReadName(Name);
+			if (!this->Expect('{') || !this->ReadMaterial(Material))
+				return false;
+
+			SharedNames.push_back(Name);
+			Shared.push_back(Material);
+		}
+		else if (!this->OpenBlock() || !this->SkipBlock())
+			return false;
+	}
+}
+
+//	Function to read a Mesh block whose opening brace has been read.  The positions &
+//	faces come first, followed by the blocks giving the rest of the mesh's data.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool XFileParser::ReadMesh()
+{
+	int count;
+
+	Positions.clear();
+	Normals.clear();
+	TextureCoords.clear();
+	Faces.clear();
+	NormalFaces.clear();
+	FaceMaterials.clear();
+	Materials.clear();
+
+	if (!this->ReadInt(count))
+		return false;
+	if ((count <= 0) || (count > X_MAX_ELEMENTS))
+		return this->Fail("Bad number of vertices.");
+
+	Positions.resize(count * 3);
+	if (!this->ReadFloats(&Positions[0], count * 3))
+		return false;
+
+	if (!this->ReadFaces(Faces, count))
+		return false;
+
+	std::string Type;
+	while (!this->Peek('}'))
+	{
+		if (!this->ReadName(Type))
+			return this->Fail("Expected a block inside the mesh.");
+
+		bool read;
+		if (Type == "MeshNormals")
+			read = this->OpenBlock() && this->ReadNormals();
+		else if (Type == "MeshTextureCoords")
+			read = this->OpenBlock() && this->ReadTextureCoords();
+		else if (Type == "MeshMaterialList")
+			read = this->OpenBlock() && this->ReadMaterialList();
+		else
+			read = this->OpenBlock() && this->SkipBlock();
+
+		if (!read)
+			return false;
+	}
+	Cursor++;
+
+	this->BuildMesh();
+	return true;
+}
+
+//	Function to read a MeshNormals block.  Normals are listed separately from the
+//	positions, with their own set of faces matching the mesh's faces one for one.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool XFileParser::ReadNormals()
+{
+	int count;
+
+	if (!this->ReadInt(count))
+		return false;
+	if ((count <= 0) || (count > X_MAX_ELEMENTS))
+		return this->Fail("Bad number of normals.");
+
+	Normals.resize(count * 3);
+	if (!this->ReadFloats(&Normals[0], count * 3))
+		return false;
+
+	if (!this->ReadFaces(NormalFaces, count))
+		return false;
+	if (NormalFaces.size() != Faces.size())
+		return this->Fail("Normal faces don't match the mesh's faces.");
+
+	return this->Peek('}') ? this->Expect('}') : this->SkipBlock();
+}
+
+//	Function to read a MeshTextureCoords block, giving one pair for each position.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool XFileParser::ReadTextureCoords()
+{
+	int count;
+
+	if (!this->ReadInt(count))
+		return false;
+	if (count != (int)(Positions.size() / 3))
+		return this->Fail("Texture co-ordinates don't match the vertices.");
+
+	TextureCoords.resize(count * 2);
+	if (!this->ReadFloats(&TextureCoords[0], count * 2))
+		return false;
+
+	return this->Expect('}');
+}
+
+//	Function to read a MeshMaterialList block: the material of each face, followed by
+//	the materials themselves, either in full or by the name of one defined earlier.  If
+//	fewer faces are listed than the mesh has, the last one listed carries on.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool XFileParser::ReadMaterialList()
+{
+	int materials, count;
+
+	if (!this->ReadInt(materials) || !this->ReadInt(count))
+		return false;
+	if ((materials < 0) || (count < 0) || (count > X_MAX_ELEMENTS))
+		return this->Fail("Bad material list.");
+
+	FaceMaterials.resize(count);
+	for (int i = 0 ; i < count ; i++)
+	{
+		if (!this->ReadInt(FaceMaterials[i]))
+			return false;
+		if ((FaceMaterials[i] < 0) || (FaceMaterials[i] >= materials))
+			return this->Fail("Material index out of range.");
+	}
+
+	std::string Type;
+	while (!this->Peek('}'))
+	{
+		MeshMaterial Material;
+
+		if (this->Peek('{'))				// A material referred to by name...  
+		{
+			Cursor++;
+			if (!this->ReadName(Type) || !this->Expect('}'))
+				return this->Fail("Expected a material name.");
+
+			size_t i = 0;
+			while ((i < SharedNames.size()) && (SharedNames[i] != Type))
+				i++;
+			if (i == SharedNames.size())
+				return this->Fail("Unknown material.");
+
+			Material = Shared[i];
+		}
+		else if (this->ReadName(Type) && (Type == "Material"))	// Or one in full.  
+		{
+			if (!this->OpenBlock() || !this->ReadMaterial(Material))
+				return false;
+		}
+		else
+			return this->Fail("Expected a material.");
+
+		Materials.push_back(Material);
+	}
+	Cursor++;
+
+	if ((int)Materials.size() != materials)
+		return this->Fail("Wrong number of materials.");
+
+	return true;
+}
+
+//	Function to read a Material block: the face colour, specular power, specular colour,
+//	emissive colour & an optional texture.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool XFileParser::ReadMaterial(MeshMaterial& Material)
+{
+	memset(&Material, 0, sizeof(MeshMaterial));
+
+	if (!this->ReadFloats(Material.diffuse, 4) || !this->ReadFloat(Material.power) ||
+		!this->ReadFloats(Material.specular, 3) || !this->ReadFloats(Material.emissive, 3))
+		return false;
+
+	std::string Type;
+	while (!this->Peek('}'))
+	{
+		if (!this->ReadName(Type))
+			return this->Fail("Expected a block inside the material.");
+
+		if (Type == "TextureFilename")
+		{
+			if (!this->OpenBlock() ||
+				!this->ReadString(Material.texture, MESH_TEXTURE_LENGTH) ||
+				!this->Expect('}'))
+				return false;
+		}
+		else if (!this->OpenBlock() || !this->SkipBlock())
+			return false;
+	}
+	Cursor++;
+
+	return true;
+}
+
+//	Function to read a list of faces.  Each is stored as its number of corners followed
+//	by the index of each corner, which must be below the given number of vertices.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool XFileParser::ReadFaces(std::vector<int>& Faces, int vertices)
+{
+	int count;
+
+	Faces.clear();
+
+	if (!this->ReadInt(count))
+		return false;
+	if ((count <= 0) || (count > X_MAX_ELEMENTS))
+		return this->Fail("Bad number of faces.");
+
+	Faces.reserve(count * 4);
+	for (int i = 0 ; i < count ; i++)
+	{
+		int corners, index;
+
+		if (!this->ReadInt(corners))
+			return false;
+		if ((corners < 3) || (corners > X_MAX_FACE_SIZE))
+			return this->Fail("Bad face size.");
+
+		Faces.push_back(corners);
+		for (int j = 0 ; j < corners ; j++)
+		{
+			if (!this->ReadInt(index))
+				return false;
+			if ((index < 0) || (index >= vertices))
+				return this->Fail("Face index out of range.");
+			Faces.push_back(index);
+		}
+	}
+
+	return true;
+}
+
+//	Function to add the mesh just read to the output.  A .x file indexes positions &
+//	normals separately, whereas the renderer needs a single index per vertex, so a
+//	vertex is made for every distinct pair of position & normal used by the faces.  
+//	Each position keeps a short chain of the vertices made from it, which is all that
+//	needs searching to find a match.  Faces with more than three corners are split into
+//	a fan of triangles.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void XFileParser::BuildMesh()
+{
+	int positions = (int)(Positions.size() / 3);
+	int base = (int)Output->Vertices.size();
+	int materialBase = (int)Output->Materials.size();
+	bool hasNormals = !NormalFaces.empty();
+	bool hasTextureCoords = !TextureCoords.empty();
+
+	First.assign(positions, -1);
+	Next.clear();
+	VertexNormals.clear();
+
+	int corner[X_MAX_FACE_SIZE];		// The vertex made for each corner of a face.  
+	size_t at = 0;						// The position in the face lists.  
+
+	for (int face = 0 ; at < Faces.size() ; face++)
+	{
+		int corners = Faces[at];
+
+		for (int i = 0 ; i < corners ; i++)
+		{
+			int position = Faces[at + 1 + i];
+			int normal = hasNormals ? NormalFaces[at + 1 + i] : -1;
+
+			// Looks for a vertex already made from the same position & normal.  
+			int vertex = First[position];
+			while ((vertex >= 0) && (VertexNormals[vertex] != normal))
+				vertex = Next[vertex];
+
+			// Otherwise makes one, adding it to the position's chain.  
+			if (vertex < 0)
+			{
+				MeshVertex New;
+				memcpy(New.position, &Positions[position * 3], sizeof(New.position));
+				if (hasNormals)
+					memcpy(New.normal, &Normals[normal * 3], sizeof(New.normal));
+				else
+					memset(New.normal, 0, sizeof(New.normal));
+				if (hasTextureCoords)
+					memcpy(New.uv, &TextureCoords[position * 2], sizeof(New.uv));
+				else
+					memset(New.uv, 0, sizeof(New.uv));
+
+				vertex = (int)VertexNormals.size();
+				Output->Vertices.push_back(New);
+				VertexNormals.push_back(normal);
+				Next.push_back(First[position]);
+				First[position] = vertex;
+			}
+
+			corner[i] = base + vertex;
+		}
+
+		// Works out the face's material, carrying the last one listed on if need be.  
+		unsigned int material = 0;
+		if (!FaceMaterials.empty())
+			material = FaceMaterials[(face < (int)FaceMaterials.size()) ? face : (FaceMaterials.size() - 1)];
+
+		for (int i = 1 ; i < corners - 1 ; i++)
+		{
+			Output->Indices.push_back(corner[0]);
+			Output->Indices.push_back(corner[i]);
+			Output->Indices.push_back(corner[i + 1]);
+			Output->Attributes.push_back(materialBase + material);
+		}
+
+		at += corners + 1;
+	}
+
+	// A mesh without materials is given a plain white one.  
+	if (Materials.empty())
+	{
+		MeshMaterial White;
+		memset(&White, 0, sizeof(MeshMaterial));
+		White.diffuse[0] = White.diffuse[1] = White.diffuse[2] = White.diffuse[3] = 1.0f;
+		Materials.push_back(White);
+	}
+
+	Output->Materials.insert(Output->Materials.end(), Materials.begin(), Materials.end());
+}
+
+//	Function to record an error, along with the line it was found on.  Always returns
+//	false so that it can be returned straight from a failed read.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool XFileParser::Fail(const char* Problem)
+{
+	if (Error)						// Keeps the first error found.  
+		return false;
+
+	char Text[96];					// The problem, kept short enough to add the line.  
+	snprintf(Text, sizeof(Text), "%.95s", Problem);
+
+	if (Begin && Cursor)
+	{
+		// Counts the lines up to where parsing stopped.  
+		int line = 1;
+		for (const char* c = Begin ; (c < Cursor) && (c < End) ; c++)
+			if (*c == '\n')
+				line++;
+
+		snprintf(Message, sizeof(Message), "%s (line %d)", Text, line);
+	}
+	else
+		snprintf(Message, sizeof(Message), "%s", Text);
+
+	Error = Message;
+	return false;
+}
\ No newline at end of file
@@ -0,0 +1,2138 @@
+//////////////////////////////////////////////////////////////////////////////////////////
+//								 "Turn & Bounce" Prototype								//
+//					   Written 2007 by Jon Wills (jonaxc@gmail.com)						//
+//				  Written for a Win32 environment using the Direct3D API.				//
+//																						//
+//				   Written at the University of Abertay Dundee, Scotland				//
+//////////////////////////////////////////////////////////////////////////////////////////
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	TOOLS ROOT FILE																		//
+//	Command-line tools for working on the game away from the renderer.  Each tool is	//
+//	picked by the first argument, and only uses the modules that build without			//
+//	Direct3D, so the tools run on any platform.											//
+//////////////////////////////////////////////////////////////////////////////////////////
+#include <stdio.h>			// Standard I/O library.  
+#include <stdlib.h>			// Standard library, for number conversions.  
+#include <string.h>			// Standard string functions.  
+#include <algorithm>		// Standard algorithms, for sorting.  
+#include <atomic>			// Standard atomic operations.  
+#include <thread>			// Standard thread library.  
+#include "Defines.h"		// Library for the project's definitions & macros.  
+#include "Simulation.h"		// Renderer-free game simulation.  
+#include "SessionBatch.h"	// Headless session batches.  
+#include "Controller.h"		// Automatic players.  
+#include "Replay.h"			// Session recording & playback.  
+#include "Clock.h"			// Monotonic clock interface.  
+#include "SnapshotRing.h"	// Fixed-size snapshot history.  
+#include "MappedFile.h"		// Memory-mapped files.  
+#include "XFileParser.h"	// .x text file parser.  
+#include "MS3DParser.h"		// MilkShape model parser.  
+#include "CookedMesh.h"		// Cooked binary meshes.  
+#include "MeshOptimiser.h"	// Vertex cache optimisation.  
+#include "MeshSimplifier.h"	// Level of detail generation.  
+#include "StartupTimeline.h"	// Startup timing.  
+#include "AssetLoader.h"	// Background mesh reading.  
+#include "SoftwareBackend.h"	// CPU render backend.  
+#include "CommandBuffer.h"	// Recorded frame commands.  
+#include "NullBackend.h"	// Counting render backend.  
+#include "StateCache.h"		// Redundant state filter.  
+#include "FrameScheduler.h"	// Frame pacing class.  
+#include "TripleBuffer.h"	// Lock-free snapshot hand-over.  
+#include "SceneGraph.h"		// Transform hierarchy.  
+#include "RenderQueue.h"	// Sorted draw queue.  
+#include "MeshDraw.h"		// Mesh submission.  
+
+int Usage();				// Prints the list of tools.  
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	ARGUMENT HELPERS
+//////////////////////////////////////////////////////////////////////////////////////////
+
+// Function to find a named option, returning its value or the given default.  
+//////////////////////////////////////////////////////////////////////////////////////////
+const char* Option(int argc, char** argv, const char* name, const char* fallback)
+{
+	for (int i = 2 ; i < argc - 1 ; i++)
+		if (strcmp(argv[i], name) == 0)
+			return argv[i + 1];
+	return fallback;
+}
+
+// Function to check whether a named flag was given.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool Flag(int argc, char** argv, const char* name)
+{
+	for (int i = 2 ; i < argc ; i++)
+		if (strcmp(argv[i], name) == 0)
+			return true;
+	return false;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	SIMULATE TOOL
+//	Runs a batch of headless sessions with the given tuning values & prints how they
+//	played out.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+// Function to print the results of a batch.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void PrintBatch(SessionBatch& Batch)
+{
+	const BatchResults& Results = Batch.GetResults();
+
+	printf("%lld sessions, %lld ticks in %.3fs on %d threads\n",
+			Results.sessions, Results.ticks, Batch.GetSeconds(), Batch.GetThreadCount());
+	printf("%.0f sessions/s, %.0f ticks/s, %lld timed out\n",
+			Batch.GetSessionsPerSecond(), Results.ticks / Batch.GetSeconds(),
+			Results.timedOut);
+	printf("checksum %016llx\n\n", Results.checksum);
+
+	// Levels reached & the bounces made at each level.  
+	printf("level    reached    bounces\n");
+	for (int i = 1 ; i < BATCH_LEVELS ; i++)
+		if (Results.levelReached[i] || Results.bounces[i])
+			printf("%5d%s %10lld %10lld\n", i, (i == BATCH_LEVELS - 1) ? "+" : " ",
+					Results.levelReached[i], Results.bounces[i]);
+
+	// Time from each launch to the bounce that ended it.  
+	printf("\nflight ticks   bounces\n");
+	for (int i = 0 ; i < BATCH_FLIGHTS ; i++)
+		if (Results.flights[i])
+			printf("%12d%s %9lld\n", i, (i == BATCH_FLIGHTS - 1) ? "+" : " ",
+					Results.flights[i]);
+}
+
+// Function to read the batch settings shared by the simulate & verify tools.  
+//////////////////////////////////////////////////////////////////////////////////////////
+BatchSettings ReadBatchSettings(int argc, char** argv)
+{
+	BatchSettings Settings;
+
+	Settings.sessions	= atoi(Option(argc, argv, "-sessions", "1000000"));
+	Settings.threads	= atoi(Option(argc, argv, "-threads", "0"));
+	Settings.seed		= strtoull(Option(argc, argv, "-seed", "1"), NULL, 10);
+	Settings.maxTicks	= atoi(Option(argc, argv, "-maxticks", "1000000"));
+	Settings.reaction	= atoi(Option(argc, argv, "-reaction", "20"));
+	Settings.idle		= Flag(argc, argv, "-idle");
+	Settings.eventDriven	= !Flag(argc, argv, "-stepped");
+
+	// Takes the game's own tuning values, only changing the ones asked for.  
+	Settings.Params = Simulation::Defaults();
+	const char* gravity = Option(argc, argv, "-gravity", NULL);
+	const char* increase = Option(argc, argv, "-increase", NULL);
+	const char* velocity = Option(argc, argv, "-velocity", NULL);
+
+	if (gravity)
+		Settings.Params.initialGravity = (float)atof(gravity);
+	if (increase)
+		Settings.Params.gravIncrease = (float)atof(increase);
+	if (velocity)
+		Settings.Params.launchVelocity = (float)atof(velocity);
+
+	return Settings;
+}
+
+// Function to run the simulate tool.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int Simulate(int argc, char** argv)
+{
+	BatchSettings Settings = ReadBatchSettings(argc, argv);
+
+	// If asked for, runs the batch on each thread count in turn to show the scaling.  
+	if (Flag(argc, argv, "-scaling"))
+	{
+		int cores = (int)std::thread::hardware_concurrency();
+		double single = 0.0;
+
+		printf("threads  sessions/s  speedup\n");
+		for (int t = 1 ; t <= cores ; t++)
+		{
+			Settings.threads = t;
+
+			SessionBatch Batch(Settings);
+			Batch.Run();
+
+			if (t == 1)
+				single = Batch.GetSessionsPerSecond();
+			printf("%7d %11.0f %7.2fx\n", t, Batch.GetSessionsPerSecond(),
+					Batch.GetSessionsPerSecond() / single);
+		}
+		return 0;
+	}
+
+	SessionBatch Batch(Settings);
+	Batch.Run();
+	PrintBatch(Batch);
+
+	return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	VERIFY TOOL
+//	Runs the same batch stepped tick by tick & event driven, and checks that both end
+//	in exactly the same states.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int Verify(int argc, char** argv)
+{
+	BatchSettings Settings = ReadBatchSettings(argc, argv);
+
+	Settings.eventDriven = false;
+	SessionBatch Stepped(Settings);
+	Stepped.Run();
+
+	Settings.eventDriven = true;
+	SessionBatch Events(Settings);
+	Events.Run();
+
+	const BatchResults& A = Stepped.GetResults();
+	const BatchResults& B = Events.GetResults();
+
+	printf("stepped       %10.3fs  checksum %016llx\n", Stepped.GetSeconds(), A.checksum);
+	printf("event driven  %10.3fs  checksum %016llx\n", Events.GetSeconds(), B.checksum);
+	printf("speedup       %10.2fx\n", Stepped.GetSeconds() / Events.GetSeconds());
+
+	if ((A.checksum != B.checksum) || (A.ticks != B.ticks))
+	{
+		printf("MISMATCH\n");
+		return 1;
+	}
+
+	printf("identical\n");
+	return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	RECORD TOOL
+//	Plays a session with the bot & records it, giving replays to test with away from
+//	the game itself.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int Record(int argc, char** argv)
+{
+	if (argc < 3)
+		return Usage();
+
+	unsigned long long seed = strtoull(Option(argc, argv, "-seed", "1"), NULL, 10);
+	int maxTicks = atoi(Option(argc, argv, "-maxticks", "1000000"));
+	BotController Bot(atoi(Option(argc, argv, "-reaction", "20")));
+
+	ReplayWriter Recorder;
+	if (!Recorder.Open(argv[2], seed, 0, Simulation::Defaults()))
+	{
+		printf("could not create %s\n", argv[2]);
+		return 1;
+	}
+
+	RandomStream Random(seed);
+	Simulation Sim(Random);
+	Bot.Reset();
+
+	// Turns the bot's choice of rotation into the key presses that would have made it.  
+	int ticks = 0;
+	bool inPlay = true;
+	while (inPlay && (ticks < maxTicks))
+	{
+		float rotation = Bot.Control(Sim);
+
+		TickInput Input;
+		Input.keys = (rotation < 0.0f) ? INPUT_LEFT : ((rotation > 0.0f) ? INPUT_RIGHT : 0);
+		Input.mouse = 0;
+
+		Recorder.Record(Sim.GetState(), Input);
+		Sim.Apply(Input);
+		inPlay = Sim.Tick();
+		ticks++;
+	}
+
+	Recorder.Close();
+
+	printf("recorded %d ticks, level %d, %d bounces\n", ticks, Sim.GetLevel(), Sim.GetBounces());
+	return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	REPLAY TOOL
+//	Plays a recorded session back as fast as it will go, optionally starting from a
+//	given tick or checking every stored state against the one played back.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int Replay(int argc, char** argv)
+{
+	if (argc < 3)
+		return Usage();
+
+	ReplayReader Player;
+	if (!Player.Open(argv[2]))
+	{
+		printf("could not read %s\n", argv[2]);
+		return 1;
+	}
+
+	int seek = atoi(Option(argc, argv, "-seek", "0"));
+	bool check = Flag(argc, argv, "-check");
+
+	printf("%d ticks, %d keyframes, %d bytes (%.2f bytes/tick)\n", Player.GetTicks(),
+			Player.GetKeyframes(), Player.GetSize(),
+			(double)Player.GetSize() / ((Player.GetTicks() > 0) ? Player.GetTicks() : 1));
+
+	SystemClock Time;
+	long long start = Time.Now();
+
+	Simulation Sim(Player.GetStream(), Player.GetParams());
+	if ((seek > 0) && !Player.Seek(Sim, seek))
+	{
+		printf("could not seek to tick %d\n", seek);
+		return 1;
+	}
+	long long seeked = Time.Now();
+
+	// Plays the rest of the session, comparing each stored state along the way.  
+	TickInput Input;
+	int mismatches = 0;
+	while (true)
+	{
+		int tick = Player.GetTick();
+		if (check && ((tick % Player.GetInterval()) == 0))
+		{
+			SimState Stored;
+			if (Player.GetKeyframe(tick / Player.GetInterval(), Stored) &&
+				(memcmp(&Stored, &Sim.GetState(), sizeof(SimState)) != 0))
+			{
+				printf("state differs at tick %d\n", tick);
+				mismatches++;
+			}
+		}
+
+		if (!Player.Next(Input))
+			break;
+		Sim.Apply(Input);
+		Sim.Tick();
+	}
+
+	double seconds = (Time.Now() - start) / (double)NS_PER_SECOND;
+	int played = Player.GetTick() - seek;
+
+	if (seek > 0)
+		printf("seek to %d took %.3fms\n", seek, (seeked - start) / (double)NS_PER_MS);
+	printf("played %d ticks in %.3fs (%.0fx real time)\n", played, seconds,
+			played / 120.0 / ((seconds > 0.0) ? seconds : 1e-9));
+	printf("level %d, score %d, %d bounces\n", Sim.GetLevel(), Sim.GetScore(), Sim.GetBounces());
+
+	if (Player.GetTick() != Player.GetTicks())
+	{
+		printf("replay is damaged\n");
+		return 1;
+	}
+	if (check)
+		printf(mismatches ? "MISMATCH\n" : "every keyframe matches\n");
+
+	return mismatches ? 1 : 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	BISECT TOOL
+//	Finds the first tick at which two recordings of the same session stop agreeing,
+//	such as one recorded before a change to the rules & one after.  The stored states
+//	are searched by halves to find the interval where they part, and that interval is
+//	then stepped through side by side.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+// Function to print each value that differs between two states.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void PrintDifferences(const SimState& A, const SimState& B)
+{
+	if (A.x != B.x)					printf("  angle    %.9g / %.9g\n", A.x, B.x);
+	if (A.y != B.y)					printf("  ball y   %.9g / %.9g\n", A.y, B.y);
+	if (A.t != B.t)					printf("  flight   %d / %d\n", A.t, B.t);
+	if (A.gravity != B.gravity)		printf("  gravity  %.9g / %.9g\n", A.gravity, B.gravity);
+	if (A.ballColour != B.ballColour)	printf("  ball     %d / %d\n", A.ballColour, B.ballColour);
+	for (int i = 0 ; i < NUM_BLOCKS ; i++)
+		if (A.blockColour[i] != B.blockColour[i])
+			printf("  block %d  %d / %d\n", i, A.blockColour[i], B.blockColour[i]);
+	if (A.level != B.level)			printf("  level    %d / %d\n", A.level, B.level);
+	if (A.score != B.score)			printf("  score    %d / %d\n", A.score, B.score);
+	if (A.bounces != B.bounces)		printf("  bounces  %d / %d\n", A.bounces, B.bounces);
+	if (memcmp(&A.Random, &B.Random, sizeof(RandomStream)) != 0)
+		printf("  colour generator differs\n");
+}
+
+// Function to run the bisect tool.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int Bisect(int argc, char** argv)
+{
+	if (argc < 4)
+		return Usage();
+
+	ReplayReader PlayerA, PlayerB;
+	if (!PlayerA.Open(argv[2]) || !PlayerB.Open(argv[3]))
+	{
+		printf("could not read both replays\n");
+		return 1;
+	}
+	if (PlayerA.GetInterval() != PlayerB.GetInterval())
+	{
+		printf("replays were stored at different intervals\n");
+		return 1;
+	}
+
+	// Finds the first stored state that differs, assuming the two never agree again
+	// once they've parted.  
+	int keyframes = (PlayerA.GetKeyframes() < PlayerB.GetKeyframes()) ?
+						PlayerA.GetKeyframes() : PlayerB.GetKeyframes();
+	int low = 0, high = keyframes;
+	while (low < high)
+	{
+		int mid = (low + high) / 2;
+		SimState A, B;
+		PlayerA.GetKeyframe(mid, A);
+		PlayerB.GetKeyframe(mid, B);
+
+		if (memcmp(&A, &B, sizeof(SimState)) == 0)
+			low = mid + 1;
+		else
+			high = mid;
+	}
+
+	// Steps both through the interval before it, keeping the last few ticks of input.  
+	int start = (low > 0) ? (low - 1) * PlayerA.GetInterval() : 0;
+	Simulation SimA(PlayerA.GetStream(), PlayerA.GetParams());
+	Simulation SimB(PlayerB.GetStream(), PlayerB.GetParams());
+	if (!PlayerA.Seek(SimA, start) || !PlayerB.Seek(SimB, start))
+	{
+		printf("could not seek to tick %d\n", start);
+		return 1;
+	}
+
+	SnapshotRing<TickInput, 16> InputsA, InputsB;
+	TickInput A, B;
+
+	while (memcmp(&SimA.GetState(), &SimB.GetState(), sizeof(SimState)) == 0)
+	{
+		bool moreA = PlayerA.Next(A);
+		bool moreB = PlayerB.Next(B);
+		if (!moreA || !moreB)
+		{
+			if (moreA == moreB)
+			{
+				printf("replays agree over all %d ticks\n", PlayerA.GetTick());
+				return 0;
+			}
+			printf("replays agree until one ends at tick %d\n", SimA.GetState().ticks);
+			return 1;
+		}
+
+		InputsA.Push(A);
+		InputsB.Push(B);
+		SimA.Apply(A);
+		SimA.Tick();
+		SimB.Apply(B);
+		SimB.Tick();
+	}
+
+	printf("replays differ from tick %d\n", SimA.GetState().ticks);
+	PrintDifferences(SimA.GetState(), SimB.GetState());
+
+	printf("input leading up to it (keys, mouse):\n");
+	for (int i = InputsA.GetCount() - 1 ; i >= 0 ; i--)
+	{
+		InputsA.Peek(i, A);
+		InputsB.Peek(i, B);
+		printf("  tick %6d   %d %4d / %d %4d%s\n", SimA.GetState().ticks - 1 - i,
+				A.keys, A.mouse, B.keys, B.mouse,
+				((A.keys != B.keys) || (A.mouse != B.mouse)) ? "  <" : "");
+	}
+
+	return 1;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	SNAPSHOT TOOL
+//	Times saving the state into the history & restoring it, as is done for every tick
+//	while playing & every tick while rewinding.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int Snapshot(int argc, char** argv)
+{
+	int rounds = atoi(Option(argc, argv, "-rounds", "10000000"));
+
+	RandomStream Random(1);
+	Simulation Sim(Random);
+	static SnapshotRing<SimState, 1024> History;
+	SimState State;
+
+	SystemClock Time;
+	long long start = Time.Now();
+
+	for (int i = 0 ; i < rounds ; i++)
+	{
+		History.Push(Sim.GetState());
+		Sim.Tick();
+		if (History.Pop(State))
+			Sim.Restore(State);
+	}
+
+	double ns = (double)(Time.Now() - start) / rounds;
+
+	printf("%d bytes per snapshot, %d snapshots (%d bytes) kept\n", (int)sizeof(SimState),
+			History.GetCapacity(), (int)sizeof(History));
+	printf("%.1fns per save, tick & restore\n", ns);
+	return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PARSE TOOL
+//	Times how quickly the .x & .ms3d parsers read the given models, or the shipped ones
+//	if none are given.  Each file is mapped once & parsed from memory over & over, so
+//	the time is spent in the parser alone.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int Parse(int argc, char** argv)
+{
+	const char* Shipped[] = { "Models/Ball.x", "Models/Ball.ms3d", "Models/Block.x", "Models/Block.ms3d" };
+	std::vector<const char*> Files;
+
+	for (int i = 2 ; i < argc ; i++)
+	{
+		if (argv[i][0] == '-')
+			i++;					// Skips the option & its value.  
+		else
+			Files.push_back(argv[i]);
+	}
+	if (Files.empty())
+		Files.assign(Shipped, Shipped + 4);
+
+	int rounds = atoi(Option(argc, argv, "-rounds", "200"));
+	SystemClock Time;
+
+	printf("file                     bytes  vertices  triangles      MB/s   us/load\n");
+	for (size_t f = 0 ; f < Files.size() ; f++)
+	{
+		MappedFile File;
+		if (!File.Open(Files[f]))
+		{
+			printf("could not open %s\n", Files[f]);
+			return 1;
+		}
+
+		XFileParser Parser;
+		MS3DParser Binary;
+		bool binary = MS3DParser::Matches(Files[f]);
+		MeshData Mesh;
+
+		long long start = Time.Now();
+		for (int i = 0 ; i < rounds ; i++)
+		{
+			bool parsed = binary ? Binary.Parse(File.GetData(), File.GetSize(), Mesh)
+								 : Parser.Parse(File.GetData(), File.GetSize(), Mesh);
+			if (!parsed)
+			{
+				printf("%s: %s\n", Files[f], binary ? Binary.GetError() : Parser.GetError());
+				return 1;
+			}
+		}
+		double seconds = (Time.Now() - start) / (double)NS_PER_SECOND;
+
+		printf("%-20s %9d %9d %10d %9.1f %9.1f\n", Files[f], (int)File.GetSize(),
+				(int)Mesh.Vertices.size(), (int)(Mesh.Indices.size() / 3),
+				(double)File.GetSize() * rounds / (1024.0 * 1024.0) / seconds,
+				seconds * 1000000.0 / rounds);
+	}
+
+	return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	COOK TOOL
+//	Converts a .x or .ms3d model into a cooked mesh, written next to it unless told
+//	otherwise.  The mesh is reordered for the vertex cache on the way, unless -raw is
+//	given, and the cache miss ratios before & after are shown.  Coarser levels of detail
+//	are then added, each simplified from the full mesh to half the triangles of the one
+//	before, until -lods levels are held or a level saves too little to be worth keeping.  
+//	Vertices are written unpacked unless -pack is given, as packed ones have to be
+//	unpacked into a copy every time the file is opened; with -pack the cook fails if
+//	unpacking them strays past the packer's limits.  Both files are then read back to
+//	compare how long each takes to load, and with -check the cooked file is also
+//	compared against the mesh written field by field, with packed vertices held to the
+//	same limits.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int Cook(int argc, char** argv)
+{
+	if ((argc < 3) || (argv[2][0] == '-'))
+		return Usage();
+
+	char Cooked[512];
+	CookedMesh::CookedPath(argv[2], Cooked, sizeof(Cooked));
+	const char* Out = Option(argc, argv, "-out", Cooked);
+
+	XFileParser Parser;
+	MS3DParser Binary;
+	bool binary = MS3DParser::Matches(argv[2]);
+	MeshData Mesh;
+	MeshData Loaded;
+
+	if (binary ? !Binary.Load(argv[2], Mesh) : !Parser.Load(argv[2], Mesh))
+	{
+		printf("%s: %s\n", argv[2], binary ? Binary.GetError() : Parser.GetError());
+		return 1;
+	}
+
+	// Reorders the mesh for the vertex cache, unless asked not to.  
+	bool raw = Flag(argc, argv, "-raw");
+	MeshOptimiser Optimiser;
+	CacheStats Before = MeshOptimiser::Analyse(Mesh.GetView(), ANALYSE_CACHE_SIZE);
+	if (!raw)
+		Optimiser.Optimise(Mesh);
+	CacheStats After = MeshOptimiser::Analyse(Mesh.GetView(), ANALYSE_CACHE_SIZE);
+
+	// Adds halving levels of detail while they still save enough triangles.  
+	int lods = atoi(Option(argc, argv, "-lods", "4"));
+	if (lods > MESH_MAX_LODS)
+		lods = MESH_MAX_LODS;
+
+	MeshSimplifier Simplifier;
+	MeshData Full = Mesh;
+	MeshData Level;
+	unsigned int last = (unsigned int)Full.Attributes.size();
+
+	for (int l = 1 ; l < lods ; l++)
+	{
+		unsigned int target = last / 2;
+		if (target < LOD_MIN_FACES)
+			target = LOD_MIN_FACES;
+
+		float error = Simplifier.Simplify(Full.GetView(), target, Level);
+		if (Level.Attributes.size() > last * LOD_MIN_SAVING)
+			break;
+
+		if (!raw)
+			Optimiser.Optimise(Level);
+		Mesh.AddLod(Level, error);
+		last = (unsigned int)Level.Attributes.size();
+	}
+
+	bool pack = Flag(argc, argv, "-pack");
+	if (!CookedMesh::Write(Out, Mesh.GetView(), pack))
+	{
+		printf("could not write %s\n", Out);
+		return 1;
+	}
+
+	// Times loading each way, averaged over a number of rounds.  
+	int rounds = atoi(Option(argc, argv, "-rounds", "100"));
+	SystemClock Time;
+
+	long long start = Time.Now();
+	for (int i = 0 ; i < rounds ; i++)
+		binary ? Binary.Load(argv[2], Loaded) : Parser.Load(argv[2], Loaded);
+	double parsed = (Time.Now() - start) / (double)rounds / 1000.0;
+
+	CookedMesh Mapped;
+	start = Time.Now();
+	for (int i = 0 ; i < rounds ; i++)
+	{
+		if (!Mapped.Open(Out))
+		{
+			printf("%s: %s\n", Out, Mapped.GetError());
+			return 1;
+		}
+		Mapped.GetView();						// Unpacks the vertices, if packed.  
+	}
+	double opened = (Time.Now() - start) / (double)rounds / 1000.0;
+
+	start = Time.Now();
+	for (int i = 0 ; i < rounds ; i++)
+		Mapped.Verify();
+	double verified = (Time.Now() - start) / (double)rounds / 1000.0;
+
+	MappedFile Model;
+	Model.Open(argv[2]);
+	printf("%s: %d bytes -> %s: %d bytes, checksum %016llx\n", argv[2], (int)Model.GetSize(),
+			Out, (int)Mapped.GetSize(), Mapped.GetChecksum());
+	printf("parse %.1fus, open %.1fus, open & verify %.1fus\n", parsed, opened,
+			opened + verified);
+	printf("%d-entry cache: ACMR %.3f -> %.3f, ATVR %.3f -> %.3f\n", ANALYSE_CACHE_SIZE,
+			Before.acmr, After.acmr, Before.atvr, After.atvr);
+
+	// Measures how far packing moved the vertices.  
+	MeshView Levels = Mapped.GetView();
+	size_t stride = pack ? sizeof(PackedVertex) : sizeof(MeshVertex);
+	PackedError Packing = VertexPacker::Compare(&Mesh.Vertices[0], Levels.Vertices,
+												Levels.numVertices);
+
+	printf("vertices: %d bytes -> %d bytes\n", (int)(Levels.numVertices * sizeof(MeshVertex)),
+			(int)(Levels.numVertices * stride));
+	if (pack)
+		printf("packing error: position %.6f, normal %.4f degrees, uv %.6f\n",
+				Packing.position, Packing.normal, Packing.uv);
+
+	if (!VertexPacker::WithinLimits(Packing))
+	{
+		printf("packed vertices stray too far from the model\n");
+		return 1;
+	}
+
+	// Lists each level of detail held.  
+	printf("\n%-5s %9s %9s %9s %9s %9s\n", "LOD", "Faces", "Vertices", "Bytes", "Error", "ACMR");
+	for (unsigned int l = 0 ; l < Levels.GetLodCount() ; l++)
+	{
+		MeshView Lod = Levels.GetLod(l);
+		printf("%-5d %9d %9d %9d %9.4f %9.3f\n", l, Lod.numFaces, Lod.numVertices,
+				(int)(Lod.numVertices * stride + Lod.numIndices * sizeof(unsigned int)),
+				Levels.numLods ? Levels.Lods[l].error : 0.0f,
+				MeshOptimiser::Analyse(Lod, ANALYSE_CACHE_SIZE).acmr);
+	}
+
+	if (Flag(argc, argv, "-check"))
+	{
+		MeshView From = Mesh.GetView();
+		MeshView To = Mapped.GetView();
+
+		bool same = Mapped.Verify() &&
+					(From.numVertices == To.numVertices) && (From.numIndices == To.numIndices) &&
+					(From.numFaces == To.numFaces) && (From.numMaterials == To.numMaterials) &&
+					(From.numLods == To.numLods) &&
+					(pack ? VertexPacker::WithinLimits(VertexPacker::Compare(From.Vertices,
+															To.Vertices, From.numVertices))
+						  : !memcmp(From.Vertices, To.Vertices, From.numVertices * sizeof(MeshVertex))) &&
+					!memcmp(From.Indices, To.Indices, From.numIndices * sizeof(unsigned int)) &&
+					!memcmp(From.Attributes, To.Attributes, From.numFaces * sizeof(unsigned int)) &&
+					!memcmp(From.Materials, To.Materials, From.numMaterials * sizeof(MeshMaterial)) &&
+					!memcmp(From.Lods, To.Lods, From.numLods * sizeof(MeshLod));
+
+		printf(same ? "cooked mesh matches\n" : "cooked mesh differs\n");
+		return same ? 0 : 1;
+	}
+
+	return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	LOAD TOOL
+//	Times reading the given models, or the shipped ones if none are given, first one
+//	after another on this thread & then all at once through the asset loader, as the
+//	game does at startup.  Each model is read from its cooked copy if there is one.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+// Function called as each model read by the loader finishes.  Each level of detail is
+// a mesh of its own, so each is listed on its own line.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void Loaded(const char* path, const MeshView* Mesh, const char* error, void* context)
+{
+	if (Mesh)
+	{
+		for (unsigned int l = 0 ; l < Mesh->GetLodCount() ; l++)
+		{
+			MeshView Lod = Mesh->GetLod(l);
+			printf("%-20s LOD %d %9d vertices %9d triangles\n", path, l,
+					(int)Lod.numVertices, (int)Lod.numFaces);
+		}
+	}
+	else
+	{
+		printf("%s: %s\n", path, error);
+		*(bool*)context = false;
+	}
+}
+
+int Load(int argc, char** argv)
+{
+	const char* Shipped[] = { "Models/Ball.ms3d", "Models/Block.ms3d" };
+	std::vector<const char*> Files;
+
+	for (int i = 2 ; i < argc ; i++)
+		Files.push_back(argv[i]);
+	if (Files.empty())
+		Files.assign(Shipped, Shipped + 2);
+
+	SystemClock Time;
+
+	// Reads each model in turn, as the game did before the loader.  
+	long long start = Time.Now();
+	for (size_t f = 0 ; f < Files.size() ; f++)
+	{
+		MeshSource Source;
+		if (!Source.Read(Files[f], true))
+		{
+			printf("%s: %s\n", Files[f], Source.GetError());
+			return 1;
+		}
+	}
+	double serial = (Time.Now() - start) / (double)NS_PER_MS;
+
+	// Reads them all at once on worker threads.  
+	StartupTimeline Timeline(&Time);
+	AssetLoader Loader(&Timeline);
+	bool loaded = true;
+
+	for (size_t f = 0 ; f < Files.size() ; f++)
+		Loader.Request(Files[f]);
+
+	int span = Timeline.Begin("Wait for meshes");
+	Loader.Finish(Loaded, &loaded);
+	Timeline.End(span);
+
+	if (!loaded)
+		return 1;
+
+	printf("\n   Start      End   Length  Thread  Part\n");
+	for (int i = 0 ; i < Timeline.GetSpanCount() ; i++)
+	{
+		char Line[128];
+		Timeline.Format(i, Line, sizeof(Line));
+		printf("%s", Line);
+	}
+
+	printf("\none after another %.2fms, on worker threads %.2fms\n", serial,
+			Timeline.GetLength() / (double)NS_PER_MS);
+	return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	RENDER TOOL
+//	Plays a session with the bot & draws each frame of it through the software backend,
+//	as the game would draw it, then saves the last frame as an image.  The scene is set
+//	up as the game sets up Direct3D: the same camera, light, render states & palette,
+//	and each frame goes through the same mesh draw module & render queue.  
+//////////////////////////////////////////////////////////////////////////////////////////
+
+// A model made in the backend, with a mesh for each of its levels of detail.  
+struct RenderModel
+{
+	int								Lods[MESH_MAX_LODS];	// The backend's mesh of each level.  
+	float							Errors[MESH_MAX_LODS];	// How far each level strays.  
+	unsigned int					numLods;				// The number of levels.  
+	std::vector<RenderMaterial>		Materials;				// The materials as loaded.  
+};
+
+// Function to read a model & make it in the backend.  
+//////////////////////////////////////////////////////////////////////////////////////////
+bool MakeModel(RenderBackend& Backend, const char* path, RenderModel& Model)
+{
+	MeshSource Source;
+	if (!Source.Read(path, false))
+	{
+		printf("%s: %s\n", path, Source.GetError());
+		return false;
+	}
+
+	const MeshView& View = Source.GetView();
+	Model.numLods = View.GetLodCount();
+	for (unsigned int l = 0 ; l < Model.numLods ; l++)
+	{
+		Model.Lods[l] = Backend.CreateMesh(View.GetLod(l));
+		Model.Errors[l] = View.numLods ? View.Lods[l].error : 0.0f;
+	}
+
+	// Makes the materials as the mesh cache does, with ambient the same as diffuse.  
+	for (unsigned int i = 0 ; i < View.numMaterials ; i++)
+	{
+		const MeshMaterial& From = View.Materials[i];
+		RenderMaterial To;
+
+		RenderColour Diffuse = { From.diffuse[0], From.diffuse[1], From.diffuse[2],
+								 From.diffuse[3] };
+		RenderColour Specular = { From.specular[0], From.specular[1], From.specular[2], 1.0f };
+		RenderColour Emissive = { From.emissive[0], From.emissive[1], From.emissive[2], 1.0f };
+
+		To.Diffuse = To.Ambient = Diffuse;
+		To.Specular = Specular;
+		To.Emissive = Emissive;
+		To.power = From.power;
+		Model.Materials.push_back(To);
+	}
+	return true;
+}
+
+// Function to describe a model to the mesh draw module.  
+//////////////////////////////////////////////////////////////////////////////////////////
+DrawableMesh GetDrawable(const RenderModel& Model)
+{
+	DrawableMesh Drawable;
+	Drawable.Lods = Model.Lods;
+	Drawable.Errors = Model.Errors;
+	Drawable.numLods = Model.numLods;
+	Drawable.Materials = Model.Materials.empty() ? NULL : &Model.Materials[0];
+	Drawable.numMaterials = (unsigned int)Model.Materials.size();
+	return Drawable;
+}
+
+// Function to set the camera as the game does at the start of every frame.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void SetCamera(RenderBackend& Backend)
+{
+	Vector3 Eye(0.0f, 1.0f, -5.0f), At(0.0f, 0.0f, 0.0f), Up(0.0f, 1.0f, 0.0f);
+	Backend.SetTransform(TRANSFORM_VIEW, Matrix::LookAtLH(Eye, At, Up));
+	Backend.SetTransform(TRANSFORM_PROJECTION, Matrix::PerspectiveFovLH(75.0f * PI / 180.0f,
+						 (float)SCREEN_WIDTH / SCREEN_HEIGHT, 1.0f, 10.0f));
+}
+
+// Function to draw a frame of the game as the game draws it.  The ring, the ball's
+// shadow & the ball are handed to the render queue through the mesh draw module, just as
+// the game's meshes hand them in, & the queue sorts them & draws them to the backend.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void DrawScene(RenderBackend& Backend, RenderQueue& Drawing, const SimState& State,
+			   const RenderModel& Block, const RenderModel& Ball)
+{
+	static const RenderMaterial BlackMatter = {
+		{ 0.0f, 0.0f, 0.0f, 0.5f }, { 0.0f, 0.0f, 0.0f, 1.0f }, { 0.0f, 0.0f, 0.0f, 1.0f },
+		{ 0.0f, 0.0f, 0.0f, 1.0f }, 0.0f };
+
+	DrawableMesh Blocks = GetDrawable(Block);
+	DrawableMesh Balls = GetDrawable(Ball);
+
+	Backend.Clear(CLEAR_TARGET | CLEAR_DEPTH | CLEAR_STENCIL, 0, 1.0f, 0);
+	Backend.BeginScene();
+	SetCamera(Backend);
+
+	// Each block hangs off the ring at its place along it, as in the game's scene graph.  
+	Matrix Ring = Matrix::RotationY(State.x);
+	for (int i = 0 ; i < NUM_BLOCKS ; i++)
+	{
+		Matrix World = Matrix::Multiply(Matrix::RotationY(-i * SPLIT_SIX), Ring);
+		MeshDraw::Submit(Drawing, RENDER_PASS_SCENE, Blocks,
+						 MeshDraw::SelectLod(&Backend, Blocks, World), World, NULL,
+						 State.blockColour[i]);
+	}
+
+	float y = State.y;
+	Vector4 Light(0.0f, 0.5f + (2 * y), BASE_Z, 1.0f - y);
+	Plane Base(0.0f, 1.0f, 0.0f, 1.0f);
+	MeshDraw::Submit(Drawing, RENDER_PASS_SHADOW, Balls, Balls.numLods - 1,
+					 Matrix::Shadow(Light, Base), &BlackMatter, PALETTE_NONE);
+
+	Matrix World = Matrix::Translation(0.0f, y, -2.5f);
+	MeshDraw::Submit(Drawing, RENDER_PASS_CASTERS, Balls,
+					 MeshDraw::SelectLod(&Backend, Balls, World), World, NULL,
+					 State.ballColour);
+
+	Drawing.Flush(&Backend);
+
+	Backend.EndScene();
+	Backend.Present();
+}
+
+// Function to set the render states, light & palette as the game does.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void SetupScene(RenderBackend& Backend, RenderQueue& Drawing)
+{
+	// The six colours used in the game: red, yellow, green, cyan, blue & magenta.  
+	static const float Palette[NUM_COLOURS][3] = {
+		{ 1.0f, 0.0f, 0.0f }, { 1.0f, 1.0f, 0.0f }, { 0.0f, 1.0f, 0.0f },
+		{ 0.0f, 1.0f, 1.0f }, { 0.0f, 0.0f, 1.0f }, { 1.0f, 0.0f, 1.0f } };
+
+	for (int i = 0 ; i < NUM_COLOURS ; i++)
+		Drawing.SetColour(i, ColourRGB(Palette[i][0], Palette[i][1], Palette[i][2]));
+
+	Backend.SetRenderState(STATE_LIGHTING, 1);
+	Backend.SetRenderState(STATE_AMBIENT, 0xff323232);
+	Backend.SetRenderState(STATE_BLEND, 1);
+	Backend.SetRenderState(STATE_DEPTH, 1);
+
+	RenderLight Light = { { 0.5f, 0.5f, 0.5f, 0.0f }, { 0.0f, 5.0f, 0.0f }, 10.0f,
+						  { 0.5f, 0.0f, 0.0f } };
+	Backend.SetLight(Light);
+
+	SetCamera(Backend);
+}
+
+// Function to advance a session played by the bot by a frame, starting a new session
+// whenever the ball is missed.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void StepSession(Simulation& Sim, BotController& Bot, RandomStream& Random)
+{
+	float rotation = Bot.Control(Sim);
+
+	TickInput Input;
+	Input.keys = (rotation < 0.0f) ? INPUT_LEFT : ((rotation > 0.0f) ? INPUT_RIGHT : 0);
+	Input.mouse = 0;
+	Sim.Apply(Input);
+	if (!Sim.Tick())
+		Sim.Reset(Random);
+}
+
+// Function to play a session with the bot a frame at a time, drawing each frame as it
+// goes & adding up the timings.  If a list is given, the checksum of every frame drawn
+// is added to it.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void PlaySession(SoftwareBackend& Backend, RenderQueue& Drawing, const RenderModel& Block,
+				 const RenderModel& Ball, int frames, unsigned long long seed,
+				 SoftTiming& Total, std::vector<unsigned long long>* Frames)
+{
+	RandomStream Random(seed);
+	Simulation Sim(Random);
+	BotController Bot(20);
+	Bot.Reset();
+
+	memset(&Total, 0, sizeof(Total));
+	size_t bytes = Backend.GetWidth() * Backend.GetHeight() * sizeof(unsigned int);
+
+	for (int f = 0 ; f < frames ; f++)
+	{
+		StepSession(Sim, Bot, Random);
+		DrawScene(Backend, Drawing, Sim.GetState(), Block, Ball);
+
+		const SoftTiming& Timing = Backend.GetTiming();
+		Total.geometry += Timing.geometry;
+		Total.raster += Timing.raster;
+		Total.frame += Timing.frame;
+		Total.triangles += Timing.triangles;
+		Total.culled += Timing.culled;
+		Total.binned += Timing.binned;
+		Total.pixels += Timing.pixels;
+
+		if (Frames)
+			Frames->push_back(CookedMesh::Checksum(Backend.GetPixels(), bytes));
+	}
+}
+
+int Render(int argc, char** argv)
+{
+	int frames = atoi(Option(argc, argv, "-frames", "120"));
+	int threads = atoi(Option(argc, argv, "-threads", "0"));
+	unsigned long long seed = strtoull(Option(argc, argv, "-seed", "1"), NULL, 10);
+	const char* out = Option(argc, argv, "-out", "Frame.ppm");
+
+	SoftwareBackend Backend(SCREEN_WIDTH, SCREEN_HEIGHT, threads);
+	RenderQueue Drawing;
+	RenderModel Block, Ball;
+
+	if (!MakeModel(Backend, "Models/Block.ms3d", Block) ||
+		!MakeModel(Backend, "Models/Ball.ms3d", Ball))
+		return 1;
+
+	SetupScene(Backend, Drawing);
+
+	SoftTiming Total;
+	PlaySession(Backend, Drawing, Block, Ball, frames, seed, Total, NULL);
+
+	double frame = Total.frame / (double)frames / NS_PER_MS;
+	printf("%d frames at %dx%d on %d threads, %s kernel\n", frames, SCREEN_WIDTH,
+			SCREEN_HEIGHT, Backend.GetThreadCount(), RasterKernels::GetName(Backend.GetKernel()));
+	printf("per frame: geometry %.2fms, raster %.2fms, total %.2fms (%.1f fps)\n",
+			Total.geometry / (double)frames / NS_PER_MS, Total.raster / (double)frames / NS_PER_MS,
+			frame, 1000.0 / frame);
+	printf("per frame: %d triangles, %d culled, %d binned, %lld pixels\n",
+			Total.triangles / frames, Total.culled / frames, Total.binned / frames,
+			Total.pixels / frames);
+
+	if (!Backend.WritePPM(out))
+	{
+		printf("could not write %s\n", out);
+		return 1;
+	}
+	printf("wrote %s\n", out);
+	return 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	RASTER TOOL
+//	Plays the same session through each raster kernel the processor can run & times how
+//	fast each fills in triangles.  Every frame is checked against the plain kernel's, as
+//	the vector kernels must give exactly the same pixels.  One thread is used by default
+//	so that the kernels themselves are measured.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int Raster(int argc, char** argv)
+{
+	int frames = atoi(Option(argc, argv, "-frames", "120"));
+	int threads = atoi(Option(argc, argv, "-threads", "1"));
+	unsigned long long seed = strtoull(Option(argc, argv, "-seed", "1"), NULL, 10);
+
+	std::vector<unsigned long long> Reference;	// The plain kernel's frames.  
+	double baseline = 0.0;						// The plain kernel's raster time.  
+	int failed = 0;
+
+	printf("%d frames at %dx%d, best kernel %s\n\n", frames, SCREEN_WIDTH, SCREEN_HEIGHT,
+			RasterKernels::GetName(RasterKernels::GetBest()));
+	printf("kernel  lanes  raster ms   ktris/s  Mpixels/s  speedup  frames\n");
+
+	for (int kernel = RASTER_SCALAR ; kernel < RASTER_KERNELS ; kernel++)
+	{
+		if (!RasterKernels::IsSupported(kernel))
+		{
+			printf("%-6s  %5d  not supported here\n", RasterKernels::GetName(kernel),
+					RasterKernels::GetLanes(kernel));
+			continue;
+		}
+
+		SoftwareBackend Backend(SCREEN_WIDTH, SCREEN_HEIGHT, threads);
+		RenderQueue Drawing;
+	RenderModel Block, Ball;
+
+		if (!MakeModel(Backend, "Models/Block.ms3d", Block) ||
+			!MakeModel(Backend, "Models/Ball.ms3d", Ball))
+			return 1;
+
+		Backend.SetKernel(kernel);
+		SetupScene(Backend, Drawing);
+
+		SoftTiming Total;
+		std::vector<unsigned long long> Frames;
+		PlaySession(Backend, Drawing, Block, Ball, frames, seed, Total, &Frames);
+
+		double seconds = Total.raster / (double)NS_PER_SECOND;
+		if (kernel == RASTER_SCALAR)
+		{
+			Reference = Frames;
+			baseline = seconds;
+		}
+
+		bool match = (Frames == Reference);
+		if (!match)
+			failed++;
+
+		printf("%-6s  %5d  %9.2f  %8.1f  %9.1f  %6.2fx  %s\n", RasterKernels::GetName(kernel),
+				RasterKernels::GetLanes(kernel), Total.raster / (double)frames / NS_PER_MS,
+				(Total.triangles - Total.culled) / seconds / 1000.0,
+				Total.pixels / seconds / 1000000.0, baseline / seconds,
+				match ? "match" : "DIFFER");
+	}
+
+	return failed ? 1 : 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	DRAW STATS TOOL
+//	Plays a session with the bot, queueing each frame through the mesh draw module &
+//	the render queue as the game does, recording what the queue draws into a command
+//	buffer & counting it with the null backend behind a state cache, as the game hands
+//	its frames to Direct3D.  It then prints the calls, triangles, bytes & state changes
+//	of an average frame.  The counts can be saved, & later counts checked against them: if
+//	any has grown by more than the tolerance the tool fails, so a build can be stopped
+//	when drawing a frame starts asking more of the graphics card.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define DRAW_METRICS	6		// The counts saved & checked.  
+
+int DrawStatistics(int argc, char** argv)
+{
+	static const char* Metrics[DRAW_METRICS] =
+		{ "calls", "draws", "triangles", "changes", "redundant", "bytes" };
+	static const char* Commands[COMMAND_COUNT] =
+		{ "begin", "end", "present", "clear", "transform", "material", "light", "state",
+		  "draw" };
+
+	int frames = atoi(Option(argc, argv, "-frames", "120"));
+	unsigned long long seed = strtoull(Option(argc, argv, "-seed", "1"), NULL, 10);
+	const char* baseline = Option(argc, argv, "-baseline", NULL);
+	const char* save = Option(argc, argv, "-save", NULL);
+	double tolerance = atof(Option(argc, argv, "-tolerance", "0"));
+
+	NullBackend Counter(SCREEN_WIDTH, SCREEN_HEIGHT);
+	StateCache Filter(&Counter);
+	CommandBuffer Recorder(&Filter);
+	RenderQueue Drawing;
+	RenderModel Block, Ball;
+
+	if (!MakeModel(Recorder, "Models/Block.ms3d", Block) ||
+		!MakeModel(Recorder, "Models/Ball.ms3d", Ball))
+		return 1;
+
+	// Sets the scene up, which isn't counted as part of any frame.  
+	SetupScene(Recorder, Drawing);
+	Recorder.Submit();
+	Counter.ResetStats();
+	Filter.ResetCounts();
+
+	RandomStream Random(seed);
+	Simulation Sim(Random);
+	BotController Bot(20);
+	Bot.Reset();
+	size_t largest = 0;				// The most bytes recorded in a frame.  
+
+	for (int f = 0 ; f < frames ; f++)
+	{
+		StepSession(Sim, Bot, Random);
+		DrawScene(Recorder, Drawing, Sim.GetState(), Block, Ball);
+
+		if (Recorder.GetBytes() > largest)
+			largest = Recorder.GetBytes();
+		Counter.CountBytes(Recorder.GetBytes());
+		Recorder.Submit();
+	}
+
+	const DrawStats& Total = Counter.GetTotal();
+	double Values[DRAW_METRICS] = {
+		NullBackend::GetCallCount(Total) / (double)frames,
+		Total.calls[COMMAND_DRAW] / (double)frames,
+		Total.triangles / (double)frames,
+		Total.changes / (double)frames,
+		Total.redundant / (double)frames,
+		Total.bytes / (double)frames };
+
+	printf("%d frames, largest command buffer %u bytes of %u set aside\n\n", frames,
+			(unsigned int)largest, (unsigned int)Recorder.GetCapacity());
+	printf("per frame:");
+	for (int i = 0 ; i < COMMAND_COUNT ; i++)
+		printf(" %s %.1f", Commands[i], Total.calls[i] / (double)frames);
+	printf("\nstate cache: %.1f settings passed on & %.1f dropped per frame\n\n",
+			Filter.GetIssued(CACHE_KINDS) / (double)frames,
+			Filter.GetElided(CACHE_KINDS) / (double)frames);
+
+	// Reads the saved counts, if there are any to check against.  
+	double Saved[DRAW_METRICS];
+	bool known[DRAW_METRICS] = { false };
+
+	if (baseline)
+	{
+		FILE* File = fopen(baseline, "r");
+		if (!File)
+		{
+			printf("could not read %s\n", baseline);
+			return 1;
+		}
+
+		char name[64];
+		double value;
+		while (fscanf(File, "%63s %lf", name, &value) == 2)
+			for (int i = 0 ; i < DRAW_METRICS ; i++)
+				if (strcmp(name, Metrics[i]) == 0)
+				{
+					Saved[i] = value;
+					known[i] = true;
+				}
+		fclose(File);
+	}
+
+	int regressed = 0;
+	printf("%-10s %12s %12s\n", "per frame", "now", "baseline");
+
+	for (int i = 0 ; i < DRAW_METRICS ; i++)
+	{
+		if (!known[i])
+		{
+			printf("%-10s %12.1f\n", Metrics[i], Values[i]);
+			continue;
+		}
+
+		bool worse = (Values[i] > Saved[i] * (1.0 + tolerance / 100.0) + 0.05);
+		if (worse)
+			regressed++;
+
+		printf("%-10s %12.1f %12.1f  %s\n", Metrics[i], Values[i], Saved[i],
+				worse ? "REGRESSED" : ((Values[i] < Saved[i] - 0.05) ? "better" : "ok"));
+	}
+
+	if (save)
+	{
+		FILE* File = fopen(save, "w");
+		if (!File)
+		{
+			printf("could not write %s\n", save);
+			return 1;
+		}
+		for (int i = 0 ; i < DRAW_METRICS ; i++)
+			fprintf(File, "%s %.1f\n", Metrics[i], Values[i]);
+		fclose(File);
+		printf("\nwrote %s\n", save);
+	}
+
+	if (regressed)
+		printf("\n%d counts regressed\n", regressed);
+	return regressed ? 1 : 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	SCHEDULE TOOL
+//	Runs the frame scheduler against a manual clock, so every time it sees is known in
+//	advance, & checks what it does with them: that the ticks handed out add up to the
+//	time that passed, that a stall is capped at MAX_TICKS_PER_FRAME with the rest of it
+//	dropped, that each frame sleeps until the jitter bound & spins out the rest however
+//	late the sleep wakes, & that the statistics match the frames played.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define SCHEDULE_FPS		60						// The frame rate checked.  
+#define SCHEDULE_TPS		100						// The tick rate checked.  
+#define SCHEDULE_WORK		(5 * NS_PER_MS)			// The work done in each frame.  
+#define SCHEDULE_PAUSE		(NS_PER_MS / 10)		// The length of each pause.  
+
+// Function to print the result of a check, returning 1 if it failed.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int ScheduleCheck(const char* name, long long got, long long expected)
+{
+	bool passed = (got == expected);
+	printf("%-28s %12lld %12lld  %s\n", name, got, expected, passed ? "ok" : "FAILED");
+	return passed ? 0 : 1;
+}
+
+int Schedule(int argc, char** argv)
+{
+	int frames = atoi(Option(argc, argv, "-frames", "600"));
+	long long frame_time = NS_PER_SECOND / SCHEDULE_FPS;
+	long long tick_time = NS_PER_SECOND / SCHEDULE_TPS;
+	int failed = 0;
+
+	printf("%d fps, %d tps, %lldms of work a frame\n\n", SCHEDULE_FPS, SCHEDULE_TPS,
+			SCHEDULE_WORK / NS_PER_MS);
+	printf("check                                 got     expected\n");
+
+	// First check - every whole tick of the time played is handed out, & no more.  
+	{
+		ManualClock Time;
+		FrameScheduler Stepper(&Time);
+		Stepper.SetFrameRate(SCHEDULE_FPS);
+		Stepper.SetTickRate(SCHEDULE_TPS);
+
+		long long start = Time.Now();
+		long long ticks = 0;
+		for (int f = 0 ; f < frames ; f++)
+		{
+			ticks += Stepper.BeginFrame();
+			Time.Advance(SCHEDULE_WORK);
+			Stepper.EndFrame();
+		}
+		ticks += Stepper.BeginFrame();
+
+		failed += ScheduleCheck("ticks handed out", ticks, (Time.Now() - start) / tick_time);
+	}
+
+	// Second check - a stall only catches up the capped number of ticks, & the frame
+	// after it starts again from nothing.  
+	{
+		ManualClock Time;
+		FrameScheduler Stepper(&Time);
+		Stepper.SetFrameRate(SCHEDULE_FPS);
+		Stepper.SetTickRate(SCHEDULE_TPS);
+
+		for (int f = 0 ; f < 10 ; f++)
+		{
+			Stepper.BeginFrame();
+			Time.Advance(SCHEDULE_WORK);
+			Stepper.EndFrame();
+		}
+
+		Stepper.BeginFrame();
+		Time.Advance(NS_PER_SECOND);		// The stall.  
+		Stepper.EndFrame();
+		int stalled = Stepper.BeginFrame();
+		Time.Advance(SCHEDULE_WORK);
+		Stepper.EndFrame();
+		int after = Stepper.BeginFrame();
+
+		failed += ScheduleCheck("ticks after a stall", stalled, MAX_TICKS_PER_FRAME);
+		failed += ScheduleCheck("ticks in the next frame", after, frame_time / tick_time);
+	}
+
+	// Third check - each frame sleeps up to the jitter bound & spins out the rest, ending
+	// on the deadline unless the sleep overran it.  
+	long long Oversleeps[3] = { 0, DEFAULT_JITTER_BOUND / 2, DEFAULT_JITTER_BOUND * 3 / 2 };
+	for (int o = 0 ; o < 3 ; o++)
+	{
+		ManualClock Time;
+		Time.SetOversleep(Oversleeps[o]);
+		Time.SetPauseLength(SCHEDULE_PAUSE);
+
+		FrameScheduler Stepper(&Time);
+		Stepper.SetFrameRate(SCHEDULE_FPS);
+		long long deadline = Time.Now() + frame_time;
+
+		Stepper.BeginFrame();
+		Time.Advance(SCHEDULE_WORK);
+		Stepper.EndFrame();
+
+		long long spin = DEFAULT_JITTER_BOUND - Oversleeps[o];
+		long long end = deadline + ((spin < 0) ? -spin : 0);
+		char Name[64];
+
+		sprintf(Name, "oversleep %.1fms: slept", (double)Oversleeps[o] / NS_PER_MS);
+		failed += ScheduleCheck(Name, Time.GetSleepTime(),
+								frame_time - SCHEDULE_WORK - spin);
+		sprintf(Name, "oversleep %.1fms: pauses", (double)Oversleeps[o] / NS_PER_MS);
+		failed += ScheduleCheck(Name, Time.GetPauseCount(),
+								(spin > 0) ? spin / SCHEDULE_PAUSE : 0);
+		sprintf(Name, "oversleep %.1fms: ended", (double)Oversleeps[o] / NS_PER_MS);
+		failed += ScheduleCheck(Name, Time.Now() - deadline, end - deadline);
+	}
+
+	// Fourth check - the statistics of the first full second match the frames played.  
+	{
+		ManualClock Time;
+		Time.SetPauseLength(SCHEDULE_PAUSE);
+		FrameScheduler Stepper(&Time);
+		Stepper.SetFrameRate(SCHEDULE_FPS);
+
+		for (int f = 0 ; f <= SCHEDULE_FPS + 1 ; f++)
+		{
+			Stepper.BeginFrame();
+			Time.Advance(SCHEDULE_WORK);
+			Stepper.EndFrame();
+		}
+
+		long long slept = frame_time - SCHEDULE_WORK - DEFAULT_JITTER_BOUND;
+		failed += ScheduleCheck("work time (us)",
+								(long long)(Stepper.GetWorkTime() * 1000.0f + 0.5f),
+								SCHEDULE_WORK / 1000);
+		failed += ScheduleCheck("worst work time (us)",
+								(long long)(Stepper.GetMaxWorkTime() * 1000.0f + 0.5f),
+								SCHEDULE_WORK / 1000);
+		failed += ScheduleCheck("worst jitter (us)",
+								(long long)(Stepper.GetMaxJitter() * 1000.0f + 0.5f), 0);
+		failed += ScheduleCheck("idle (0.1%)",
+								(long long)(Stepper.GetIdlePercent() * 10.0f + 0.5f),
+								(1000 * slept + frame_time / 2) / frame_time);
+	}
+
+	printf("\n%s\n", failed ? "scheduler checks FAILED" : "scheduler checks passed");
+	return failed ? 1 : 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	PIPELINE TOOL
+//	Plays a session with the bot the way the game runs it: ticked on a thread of its own,
+//	which hands a snapshot to this thread after each pass through a triple buffer, while
+//	this thread draws the newest snapshot on the CPU.  Each snapshot carries a checksum
+//	of itself, so one picked up half written would be caught.  Both threads' timings are
+//	printed at the end, along with how many snapshots were drawn & how many were passed
+//	over while a frame was being drawn.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define PIPELINE_RATE	120		// The passes, ticks & frames per second aimed for.  
+
+// Everything handed from the ticking thread to the drawing thread.  
+struct PipelineSnapshot
+{
+	SimState			State;		// The game after the pass.  
+	int					pass;		// The number of the pass.  
+	unsigned long long	check;		// Checksum of the state & pass number.  
+};
+
+// Everything the ticking thread is given & hands back.  
+struct PipelineTicker
+{
+	TripleBuffer<PipelineSnapshot>*	Frames;	// Where the snapshots are handed over.  
+	std::atomic<bool>	stop;		// Set once the drawing is finished.  
+	unsigned long long	seed;		// The seed of the session.  
+
+	int					passes;		// The passes run.  
+	float				idle;		// Share of the thread's time spent asleep.  
+	float				jitter;		// Mean pass length error in milliseconds.  
+	float				work;		// Mean time spent working in milliseconds.  
+	float				maxWork;	// Worst time spent working in milliseconds.  
+};
+
+// Function to work out the checksum a snapshot should carry.  
+//////////////////////////////////////////////////////////////////////////////////////////
+unsigned long long CheckSnapshot(const PipelineSnapshot& Snapshot)
+{
+	return CookedMesh::Checksum(&Snapshot.State, sizeof(SimState)) ^ Snapshot.pass;
+}
+
+// Function run on the ticking thread, until told to stop.  
+//////////////////////////////////////////////////////////////////////////////////////////
+void TickPipeline(PipelineTicker* Ticker)
+{
+	SystemClock Time;
+	FrameScheduler Stepper(&Time);
+	Stepper.SetFrameRate(PIPELINE_RATE);
+	Stepper.SetTickRate(PIPELINE_RATE);
+
+	RandomStream Random(Ticker->seed);
+	Simulation Sim(Random);
+	BotController Bot(20);
+	Bot.Reset();
+
+	Stepper.Reset();
+	while (!Ticker->stop)
+	{
+		int ticks = Stepper.BeginFrame();
+		for (int i = 0 ; i < ticks ; i++)
+			StepSession(Sim, Bot, Random);
+
+		PipelineSnapshot& Snapshot = Ticker->Frames->GetWriteSlot();
+		Snapshot.State = Sim.GetState();
+		Snapshot.pass = ++Ticker->passes;
+		Snapshot.check = CheckSnapshot(Snapshot);
+		Ticker->Frames->Publish();
+
+		Stepper.EndFrame();
+	}
+
+	Ticker->idle = Stepper.GetIdlePercent();
+	Ticker->jitter = Stepper.GetJitter();
+	Ticker->work = Stepper.GetWorkTime();
+	Ticker->maxWork = Stepper.GetMaxWorkTime();
+}
+
+int Pipeline(int argc, char** argv)
+{
+	int frames = atoi(Option(argc, argv, "-frames", "240"));
+	int threads = atoi(Option(argc, argv, "-threads", "0"));
+	unsigned long long seed = strtoull(Option(argc, argv, "-seed", "1"), NULL, 10);
+
+	SoftwareBackend Backend(SCREEN_WIDTH, SCREEN_HEIGHT, threads);
+	RenderQueue Drawing;
+	RenderModel Block, Ball;
+
+	if (!MakeModel(Backend, "Models/Block.ms3d", Block) ||
+		!MakeModel(Backend, "Models/Ball.ms3d", Ball))
+		return 1;
+
+	SetupScene(Backend, Drawing);
+
+	// The drawing thread starts off with the session as it stands before any ticks.  
+	RandomStream Random(seed);
+	Simulation Start(Random);
+	PipelineSnapshot First;
+	First.State = Start.GetState();
+	First.pass = 0;
+	First.check = CheckSnapshot(First);
+
+	TripleBuffer<PipelineSnapshot> Frames(First);
+
+	PipelineTicker Ticker;
+	Ticker.Frames = &Frames;
+	Ticker.stop = false;
+	Ticker.seed = seed;
+	Ticker.passes = 0;
+
+	SystemClock Time;
+	FrameScheduler Scheduler(&Time);
+	Scheduler.SetFrameRate(PIPELINE_RATE);
+
+	int fresh = 0;			// Frames that picked up a new snapshot.  
+	int skipped = 0;		// Snapshots passed over.  
+	int torn = 0;			// Snapshots whose checksum was wrong.  
+	int last = 0;			// The pass of the last snapshot drawn.  
+
+	std::thread Ticking(TickPipeline, &Ticker);
+	Scheduler.Reset();
+
+	for (int f = 0 ; f < frames ; f++)
+	{
+		Scheduler.BeginFrame();
+
+		if (Frames.Acquire())
+			fresh++;
+
+		const PipelineSnapshot& Snapshot = Frames.GetReadSlot();
+		if (Snapshot.check != CheckSnapshot(Snapshot))
+			torn++;
+		if (Snapshot.pass > last)
+		{
+			skipped += Snapshot.pass - last - 1;
+			last = Snapshot.pass;
+		}
+
+		DrawScene(Backend, Drawing, Snapshot.State, Block, Ball);
+
+		Scheduler.EndFrame();
+	}
+
+	Ticker.stop = true;
+	Ticking.join();
+
+	printf("%d frames at %dx%d on %d threads, %d passes ticked, aiming for %d per second\n\n",
+			frames, SCREEN_WIDTH, SCREEN_HEIGHT, Backend.GetThreadCount(), Ticker.passes,
+			PIPELINE_RATE);
+	printf("thread  idle  jitter ms  work ms  worst work ms\n");
+	printf("tick    %3.0f%%  %9.2f  %7.3f  %13.3f\n", Ticker.idle, Ticker.jitter, Ticker.work,
+			Ticker.maxWork);
+	printf("draw    %3.0f%%  %9.2f  %7.3f  %13.3f\n\n", Scheduler.GetIdlePercent(),
+			Scheduler.GetJitter(), Scheduler.GetWorkTime(), Scheduler.GetMaxWorkTime());
+	printf("snapshots: %d picked up, %d passed over, %d torn\n", fresh, skipped, torn);
+
+	return torn ? 1 : 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MATH TOOL
+//	Checks the matrix builders against the same sums worked out in double precision, as
+//	Direct3D's helpers give them, & checks the vector paths give exactly what the plain
+//	code does.  An error is measured in units in the last place of the largest value in
+//	the matrix, so values that cancel out to near 0 aren't held to more precision than
+//	the floats they came from could give.  Multiplying & transforming are then timed on
+//	both paths.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define MATH_TOLERANCE	8		// The most units in the last place a builder may be out.  
+#define MATH_BATCH		1024	// The matrices & points in each timed batch.  
+#define MATH_REPEATS	10		// The turns each path is timed over.  
+
+// Matrices built at compile time, which must come out as they would at run time.  
+static constexpr Matrix FixedOffset = Matrix::Translation(1.0f, 2.0f, 3.0f);
+static_assert((FixedOffset.m[3][1] == 2.0f) && (Matrix::Identity().m[2][2] == 1.0f),
+			  "Matrices must be buildable at compile time.");
+
+// Function to report the vector path the matrices were built with.  
+//////////////////////////////////////////////////////////////////////////////////////////
+const char* MathPath()
+{
+#if defined(MATH_SSE)
+	return "sse";
+#elif defined(MATH_NEON)
+	return "neon";
+#else
+	return "scalar";
+#endif
+}
+
+// Function to pick a number between the given limits.  
+//////////////////////////////////////////////////////////////////////////////////////////
+float RandomFloat(RandomStream& Random, float low, float high)
+{
+	return low + (high - low) * (float)((Random.Next() >> 40) / (double)(1ULL << 24));
+}
+
+// Function to fill a matrix with numbers between -2 & 2.  
+//////////////////////////////////////////////////////////////////////////////////////////
+Matrix RandomMatrix(RandomStream& Random)
+{
+	Matrix Out;
+	for (int r = 0 ; r < 4 ; r++)
+		for (int c = 0 ; c < 4 ; c++)
+			Out.m[r][c] = RandomFloat(Random, -2.0f, 2.0f);
+	return Out;
+}
+
+// Function to measure how far a matrix is from the exact values, in units in the last
+// place of the largest of them.  
+//////////////////////////////////////////////////////////////////////////////////////////
+double MatrixError(const Matrix& Built, const double Exact[4][4])
+{
+	double largest = 0.0, worst = 0.0;
+	for (int r = 0 ; r < 4 ; r++)
+		for (int c = 0 ; c < 4 ; c++)
+		{
+			if (fabs(Exact[r][c]) > largest)
+				largest = fabs(Exact[r][c]);
+			if (fabs(Built.m[r][c] - Exact[r][c]) > worst)
+				worst = fabs(Built.m[r][c] - Exact[r][c]);
+		}
+
+	int exponent;
+	frexp(largest, &exponent);
+	double ulp = ldexp(1.0, exponent - 24);		// A float's last place at that size.  
+	return (largest > 0.0) ? worst / ulp : worst;
+}
+
+// Function to work out the exact values of each builder for a set of random inputs,
+// returning the worst error of the builder picked.  
+//////////////////////////////////////////////////////////////////////////////////////////
+double CheckBuilder(int builder, RandomStream& Random)
+{
+	double E[4][4] = { { 0.0 } };
+	Matrix Built;
+
+	switch (builder)
+	{
+		case 0:		// Multiply.  
+		{
+			Matrix A = RandomMatrix(Random), B = RandomMatrix(Random);
+			Built = Matrix::Multiply(A, B);
+			for (int r = 0 ; r < 4 ; r++)
+				for (int c = 0 ; c < 4 ; c++)
+					for (int k = 0 ; k < 4 ; k++)
+						E[r][c] += (double)A.m[r][k] * B.m[k][c];
+			break;
+		}
+
+		case 1:		// RotationY.  
+		{
+			float angle = RandomFloat(Random, -2.0f * PI, 2.0f * PI);
+			Built = Matrix::RotationY(angle);
+			E[0][0] = E[2][2] = cos((double)angle);
+			E[2][0] = sin((double)angle);
+			E[0][2] = -E[2][0];
+			E[1][1] = E[3][3] = 1.0;
+			break;
+		}
+
+		case 2:		// LookAtLH.  
+		{
+			Vector3 Eye(RandomFloat(Random, -5.0f, 5.0f), RandomFloat(Random, 1.0f, 5.0f),
+						RandomFloat(Random, -5.0f, -1.0f));
+			Vector3 At(RandomFloat(Random, -1.0f, 1.0f), RandomFloat(Random, -1.0f, 1.0f),
+					   RandomFloat(Random, -1.0f, 1.0f));
+			Vector3 Up(0.0f, 1.0f, 0.0f);
+			Built = Matrix::LookAtLH(Eye, At, Up);
+
+			double z[3] = { (double)At.x - Eye.x, (double)At.y - Eye.y, (double)At.z - Eye.z };
+			double length = sqrt(z[0] * z[0] + z[1] * z[1] + z[2] * z[2]);
+			for (int i = 0 ; i < 3 ; i++)
+				z[i] /= length;
+			double x[3] = { Up.y * z[2] - Up.z * z[1], Up.z * z[0] - Up.x * z[2],
+							Up.x * z[1] - Up.y * z[0] };
+			length = sqrt(x[0] * x[0] + x[1] * x[1] + x[2] * x[2]);
+			for (int i = 0 ; i < 3 ; i++)
+				x[i] /= length;
+			double y[3] = { z[1] * x[2] - z[2] * x[1], z[2] * x[0] - z[0] * x[2],
+							z[0] * x[1] - z[1] * x[0] };
+			double e[3] = { Eye.x, Eye.y, Eye.z };
+
+			for (int i = 0 ; i < 3 ; i++)
+			{
+				E[i][0] = x[i];
+				E[i][1] = y[i];
+				E[i][2] = z[i];
+				E[3][0] -= x[i] * e[i];
+				E[3][1] -= y[i] * e[i];
+				E[3][2] -= z[i] * e[i];
+			}
+			E[3][3] = 1.0;
+			break;
+		}
+
+		case 3:		// PerspectiveFovLH.  
+		{
+			float fov = RandomFloat(Random, 0.5f, 2.5f);
+			float aspect = RandomFloat(Random, 0.5f, 2.5f);
+			float zn = RandomFloat(Random, 0.1f, 2.0f);
+			float zf = zn + RandomFloat(Random, 1.0f, 100.0f);
+			Built = Matrix::PerspectiveFovLH(fov, aspect, zn, zf);
+
+			double yScale = 1.0 / tan(fov * 0.5);
+			E[0][0] = yScale / aspect;
+			E[1][1] = yScale;
+			E[2][2] = zf / ((double)zf - zn);
+			E[2][3] = 1.0;
+			E[3][2] = -(double)zn * zf / ((double)zf - zn);
+			break;
+		}
+
+		case 4:		// Shadow.  
+		{
+			Vector4 Light(RandomFloat(Random, -2.0f, 2.0f), RandomFloat(Random, 1.0f, 5.0f),
+						  RandomFloat(Random, -2.0f, 2.0f), RandomFloat(Random, 0.0f, 1.0f));
+			Plane Base(RandomFloat(Random, -0.5f, 0.5f), RandomFloat(Random, 0.5f, 2.0f),
+					   RandomFloat(Random, -0.5f, 0.5f), RandomFloat(Random, -1.0f, 1.0f));
+			Built = Matrix::Shadow(Light, Base);
+
+			double length = sqrt((double)Base.a * Base.a + (double)Base.b * Base.b +
+								 (double)Base.c * Base.c);
+			double P[4] = { Base.a / length, Base.b / length, Base.c / length, Base.d / length };
+			double L[4] = { Light.x, Light.y, Light.z, Light.w };
+			double dot = P[0] * L[0] + P[1] * L[1] + P[2] * L[2] + P[3] * L[3];
+
+			for (int r = 0 ; r < 4 ; r++)
+				for (int c = 0 ; c < 4 ; c++)
+					E[r][c] = ((r == c) ? dot : 0.0) - P[r] * L[c];
+			break;
+		}
+
+		default:	// Transform, as a matrix of the point moved by four matrices.  
+		{
+			float Point[3] = { RandomFloat(Random, -2.0f, 2.0f), RandomFloat(Random, -2.0f, 2.0f),
+							   RandomFloat(Random, -2.0f, 2.0f) };
+			for (int r = 0 ; r < 4 ; r++)
+			{
+				Matrix M = RandomMatrix(Random);
+				Vector4 Moved = M.Transform(Point);
+				Built.m[r][0] = Moved.x;
+				Built.m[r][1] = Moved.y;
+				Built.m[r][2] = Moved.z;
+				Built.m[r][3] = Moved.w;
+
+				for (int c = 0 ; c < 4 ; c++)
+					E[r][c] = (double)Point[0] * M.m[0][c] + (double)Point[1] * M.m[1][c] +
+							  (double)Point[2] * M.m[2][c] + M.m[3][c];
+			}
+			break;
+		}
+	}
+
+	return MatrixError(Built, E);
+}
+
+int Math(int argc, char** argv)
+{
+	int rounds = atoi(Option(argc, argv, "-rounds", "10000000"));
+	int checks = atoi(Option(argc, argv, "-checks", "100000"));
+
+	static const char* Builders[] = { "Multiply", "RotationY", "LookAtLH",
+									  "PerspectiveFovLH", "Shadow", "Transform" };
+	const int builders = sizeof(Builders) / sizeof(Builders[0]);
+	int failed = 0;
+
+	printf("vector path %s, %d checks each, tolerance %d ulps\n\n", MathPath(), checks,
+			MATH_TOLERANCE);
+	printf("builder           worst ulps  result\n");
+
+	RandomStream Random(1);
+	for (int b = 0 ; b < builders ; b++)
+	{
+		double worst = 0.0;
+		for (int i = 0 ; i < checks ; i++)
+		{
+			double error = CheckBuilder(b, Random);
+			if (error > worst)
+				worst = error;
+		}
+
+		bool passed = (worst <= MATH_TOLERANCE);
+		if (!passed)
+			failed++;
+		printf("%-16s  %10.2f  %s\n", Builders[b], worst, passed ? "ok" : "FAILED");
+	}
+
+	// The vector paths must give exactly the plain code's results.  
+	int differ = 0;
+	for (int i = 0 ; i < checks ; i++)
+	{
+		Matrix A = RandomMatrix(Random), B = RandomMatrix(Random);
+		Matrix Vector = Matrix::Multiply(A, B), Plain = Matrix::MultiplyScalar(A, B);
+		if (memcmp(&Vector, &Plain, sizeof(Matrix)) != 0)
+			differ++;
+
+		Vector4 Moved = A.Transform(B.m[0]), Check = A.TransformScalar(B.m[0]);
+		if (memcmp(&Moved, &Check, sizeof(Vector4)) != 0)
+			differ++;
+	}
+	printf("%-16s  %10d  %s\n\n", "vector vs plain", differ, differ ? "DIFFER" : "match");
+	if (differ)
+		failed++;
+
+	// Times each path over a batch of matrices & points, as the software backend moves
+	// every vertex of a mesh by the same matrix.  
+	std::vector<Matrix> Inputs(MATH_BATCH), Products(MATH_BATCH);
+	std::vector<Vector4> Moved(MATH_BATCH);
+	for (int i = 0 ; i < MATH_BATCH ; i++)
+		Inputs[i] = RandomMatrix(Random);
+
+	SystemClock Time;
+	Matrix A = Matrix::RotationY(0.5f);
+	double times[4];
+
+	// Takes turns between the paths & keeps each one's best, so that a stall landing
+	// on one path doesn't make it look slower than it is.  
+	for (int repeat = 0 ; repeat < MATH_REPEATS ; repeat++)
+	{
+		for (int pass = 0 ; pass < 4 ; pass++)
+		{
+			long long start = Time.Now();
+
+			for (int i = 0 ; i < rounds / MATH_REPEATS ; i += MATH_BATCH)
+			{
+				if (pass == 0)
+					for (int j = 0 ; j < MATH_BATCH ; j++)
+						Products[j] = Matrix::MultiplyScalar(Inputs[j], A);
+				else if (pass == 1)
+					for (int j = 0 ; j < MATH_BATCH ; j++)
+						Products[j] = Matrix::Multiply(Inputs[j], A);
+				else if (pass == 2)
+					for (int j = 0 ; j < MATH_BATCH ; j++)
+						Moved[j] = A.TransformScalar(Inputs[j].m[0]);
+				else
+					for (int j = 0 ; j < MATH_BATCH ; j++)
+						Moved[j] = A.Transform(Inputs[j].m[0]);
+			}
+
+			double time = (double)(Time.Now() - start) / (rounds / MATH_REPEATS);
+			if ((repeat == 0) || (time < times[pass]))
+				times[pass] = time;
+		}
+	}
+
+	printf("operation  plain ns  %6s ns  speedup\n", MathPath());
+	printf("multiply   %8.2f  %9.2f  %6.2fx\n", times[0], times[1], times[0] / times[1]);
+	printf("transform  %8.2f  %9.2f  %6.2fx\n", times[2], times[3], times[2] / times[3]);
+
+	return failed ? 1 : 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	SCENE TOOL
+//	Plays a session with the bot & places a number of rings, stacked one above the
+//	other & all turning with the game's, in two ways: building every block's rotation
+//	from scratch each frame as the game used to, & through the scene graph, where the
+//	blocks hang off their ring & are only worked out again when it turns.  Both ways are
+//	timed over the same frames, & the graph's world matrices are checked against the
+//	ones built directly.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define SCENE_SPACING	0.5f	// The height between one ring & the next.  
+#define SCENE_TOLERANCE	1e-5f	// The most a graph's world matrix may be out by.  
+
+// Function to work out the largest difference between two matrices.  
+//////////////////////////////////////////////////////////////////////////////////////////
+float MatrixDifference(const Matrix& A, const Matrix& B)
+{
+	float worst = 0.0f;
+	for (int r = 0 ; r < 4 ; r++)
+		for (int c = 0 ; c < 4 ; c++)
+			if (fabs(A.m[r][c] - B.m[r][c]) > worst)
+				worst = (float)fabs(A.m[r][c] - B.m[r][c]);
+	return worst;
+}
+
+int Scene(int argc, char** argv)
+{
+	int rings = atoi(Option(argc, argv, "-rings", "64"));
+	int frames = atoi(Option(argc, argv, "-frames", "20000"));
+	unsigned long long seed = strtoull(Option(argc, argv, "-seed", "1"), NULL, 10);
+
+	// Plays the session through first, so both ways are timed over the same angles.  
+	RandomStream Random(seed);
+	Simulation Sim(Random);
+	BotController Bot(20);
+	Bot.Reset();
+
+	std::vector<float> Angles(frames);
+	int still = 0;
+	for (int f = 0 ; f < frames ; f++)
+	{
+		StepSession(Sim, Bot, Random);
+		Angles[f] = Sim.GetState().x;
+		if ((f > 0) && (Angles[f] == Angles[f - 1]))
+			still++;
+	}
+
+	// Builds the graph, with each ring's blocks at their fixed places along it.  
+	SceneGraph Graph;
+	std::vector<int> RingNodes(rings), BlockNodes(rings * NUM_BLOCKS);
+	std::vector<Matrix> Offsets(rings), Direct(rings * NUM_BLOCKS);
+	for (int r = 0 ; r < rings ; r++)
+	{
+		Offsets[r] = Matrix::Translation(0.0f, r * SCENE_SPACING, 0.0f);
+		RingNodes[r] = Graph.AddNode(SCENE_ROOT, Offsets[r]);
+		for (int i = 0 ; i < NUM_BLOCKS ; i++)
+			BlockNodes[r * NUM_BLOCKS + i] = Graph.AddNode(RingNodes[r],
+													Matrix::RotationY(-i * SPLIT_SIX));
+	}
+
+	SystemClock Time;
+	double times[2];
+	long long rebuilt = 0;
+	float worst = 0.0f, sum = 0.0f;
+
+	// First pass - every block's rotation built from scratch each frame.  
+	long long start = Time.Now();
+	for (int f = 0 ; f < frames ; f++)
+		for (int r = 0 ; r < rings ; r++)
+			for (int i = 0 ; i < NUM_BLOCKS ; i++)
+			{
+				Matrix& World = Direct[r * NUM_BLOCKS + i];
+				World = Matrix::Multiply(Matrix::RotationY(Angles[f] - i * SPLIT_SIX),
+										 Offsets[r]);
+				sum += World.m[0][0];
+			}
+	times[0] = (double)(Time.Now() - start) / frames;
+
+	// Second pass - the rings only moved when they turn, & the graph left to catch up.  
+	float placed = 0.0f;
+	start = Time.Now();
+	for (int f = 0 ; f < frames ; f++)
+	{
+		if ((f == 0) || (Angles[f] != placed))
+		{
+			placed = Angles[f];
+			Matrix Turn = Matrix::RotationY(placed);
+			for (int r = 0 ; r < rings ; r++)
+				Graph.SetLocal(RingNodes[r], Matrix::Multiply(Turn, Offsets[r]));
+		}
+
+		Graph.Update();
+		rebuilt += Graph.GetUpdateCount();
+
+		for (int b = 0 ; b < rings * NUM_BLOCKS ; b++)
+			sum += Graph.GetWorld(BlockNodes[b]).m[0][0];
+	}
+	times[1] = (double)(Time.Now() - start) / frames;
+
+	// Both passes finish on the last frame, so their matrices can be compared.  
+	for (int b = 0 ; b < rings * NUM_BLOCKS ; b++)
+	{
+		float difference = MatrixDifference(Graph.GetWorld(BlockNodes[b]), Direct[b]);
+		if (difference > worst)
+			worst = difference;
+	}
+
+	printf("%d rings, %d nodes, %d frames, ring still for %.1f%% of them\n\n", rings,
+			Graph.GetNodeCount(), frames, 100.0f * still / frames);
+	printf("method     ns/frame  matrices/frame\n");
+	printf("direct   %10.1f  %14.1f\n", times[0], (double)rings * NUM_BLOCKS);
+	printf("graph    %10.1f  %14.1f\n", times[1], (double)rebuilt / frames);
+	printf("speedup  %9.2fx\n\n", times[0] / times[1]);
+
+	bool passed = (worst <= SCENE_TOLERANCE);
+	printf("worst difference %g (checksum %g)  %s\n", worst, sum,
+			passed ? "ok" : "FAILED");
+
+	return passed ? 0 : 1;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	RANDOM TOOL
+//	Checks the random streams against published values: the first outputs of
+//	xoshiro256** from a known state, & the first outputs after a jump & a long jump
+//	from it.  It then checks that each worker's stream is the seed long jumped once per
+//	worker, & draws from the streams a batch hands its sessions - chunks a long jump
+//	apart, sessions a jump apart - to check that no value turns up in two of them.  
+//////////////////////////////////////////////////////////////////////////////////////////
+#define RANDOM_WORKERS	8		// The worker streams checked.  
+#define RANDOM_SESSIONS	8		// The sessions checked in each worker's stream.  
+
+static const unsigned long long RandomStart[4] = { 1, 2, 3, 4 };
+static const unsigned long long RandomOutputs[10] =
+{
+	11520ULL, 0ULL, 1509978240ULL, 1215971899390074240ULL, 1216172134540287360ULL,
+	607988272756665600ULL, 16172922978634559625ULL, 8476171486693032832ULL,
+	10595114339597558777ULL, 2904607092377533576ULL
+};
+static const unsigned long long RandomJumped[2] =
+	{ 13534147089533256664ULL, 7126240192422241655ULL };
+static const unsigned long long RandomLongJumped[2] =
+	{ 5942309088398569549ULL, 15625447729937358436ULL };
+
+// Function to check a stream's next outputs, returning 1 if any differ.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int RandomCheck(const char* name, RandomStream& Stream,
+				const unsigned long long* Expected, int count)
+{
+	int wrong = 0;
+	for (int i = 0 ; i < count ; i++)
+		if (Stream.Next() != Expected[i])
+			wrong++;
+
+	printf("%-28s %3d of %3d  %s\n", name, count - wrong, count, wrong ? "FAILED" : "ok");
+	return wrong ? 1 : 0;
+}
+
+int RandomStreams(int argc, char** argv)
+{
+	int draws = atoi(Option(argc, argv, "-draws", "4096"));
+	unsigned long long seed = strtoull(Option(argc, argv, "-seed", "1"), NULL, 10);
+	int failed = 0;
+
+	printf("check                        matched\n");
+
+	// First check - the generator & its jumps against the published outputs.  
+	RandomStream Stream;
+	Stream.SetState(RandomStart);
+	failed += RandomCheck("outputs", Stream, RandomOutputs, 10);
+
+	Stream.SetState(RandomStart);
+	Stream.Jump();
+	failed += RandomCheck("jump", Stream, RandomJumped, 2);
+
+	Stream.SetState(RandomStart);
+	Stream.LongJump();
+	failed += RandomCheck("long jump", Stream, RandomLongJumped, 2);
+
+	// Second check - each worker's stream is the seed long jumped once per worker.  
+	RandomStream Jumped(seed);
+	int matched = 0;
+	for (int w = 0 ; w < RANDOM_WORKERS ; w++)
+	{
+		RandomStream Worker = RandomStream::ForWorker(seed, w);
+		RandomStream Expected = Jumped;
+		bool same = true;
+		for (int i = 0 ; i < draws ; i++)
+			if (Worker.Next() != Expected.Next())
+				same = false;
+		if (same)
+			matched++;
+		Jumped.LongJump();
+	}
+	printf("%-28s %3d of %3d  %s\n", "worker streams", matched, RANDOM_WORKERS,
+			(matched == RANDOM_WORKERS) ? "ok" : "FAILED");
+	failed += (matched == RANDOM_WORKERS) ? 0 : 1;
+
+	// Third check - no value drawn from one session's stream turns up in another's.  
+	std::vector<unsigned long long> Values;
+	for (int w = 0 ; w < RANDOM_WORKERS ; w++)
+	{
+		RandomStream Session = RandomStream::ForWorker(seed, w);
+		for (int s = 0 ; s < RANDOM_SESSIONS ; s++)
+		{
+			RandomStream Drawn = Session;
+			for (int i = 0 ; i < draws ; i++)
+				Values.push_back(Drawn.Next());
+			Session.Jump();
+		}
+	}
+
+	std::sort(Values.begin(), Values.end());
+	int repeats = 0;
+	for (int i = 1 ; i < (int)Values.size() ; i++)
+		if (Values[i] == Values[i - 1])
+			repeats++;
+	printf("%-28s %3d streams, %d values, %d repeated  %s\n", "overlap",
+			RANDOM_WORKERS * RANDOM_SESSIONS, (int)Values.size(), repeats,
+			repeats ? "FAILED" : "ok");
+	failed += repeats ? 1 : 0;
+
+	return failed ? 1 : 0;
+}
+
+//////////////////////////////////////////////////////////////////////////////////////////
+//	MAIN FUNCTION
+//////////////////////////////////////////////////////////////////////////////////////////
+
+// Function to print the list of tools.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int Usage()
+{
+	printf("usage: TABTool <tool> [options]\n\n");
+	printf("  simulate   Runs headless sessions for tuning.\n");
+	printf("             -sessions n -threads n -seed n -maxticks n -reaction n -idle\n");
+	printf("             -gravity g -increase i -velocity v -scaling -stepped\n");
+	printf("  verify     Checks event-driven sessions against stepped ones.\n");
+	printf("             Takes the same options as simulate.\n");
+	printf("  record     Records a session played by the bot.\n");
+	printf("             <file> -seed n -maxticks n -reaction n\n");
+	printf("  replay     Plays back a recorded session.\n");
+	printf("             <file> -seek tick -check\n");
+	printf("  bisect     Finds where two replays of a session part.\n");
+	printf("             <file> <file>\n");
+	printf("  snapshot   Times saving & restoring the game state.\n");
+	printf("             -rounds n\n");
+	printf("  parse      Times reading .x & .ms3d models.\n");
+	printf("             [file...] -rounds n\n");
+	printf("  cook       Converts a model into a cooked mesh.\n");
+	printf("             <file> -out file -rounds n -lods n -raw -pack -check\n");
+	printf("  load       Times reading models on worker threads.\n");
+	printf("             [file...]\n");
+	printf("  render     Draws a session on the CPU & saves the last frame.\n");
+	printf("             -frames n -threads n -seed n -out file\n");
+	printf("  raster     Times & checks each raster kernel the CPU can run.\n");
+	printf("             -frames n -threads n -seed n\n");
+	printf("  drawstats  Counts each frame's draw calls & state changes.\n");
+	printf("             -frames n -seed n -baseline file -save file -tolerance percent\n");
+	printf("  schedule   Checks the frame scheduler against a manual clock.\n");
+	printf("             -frames n\n");
+	printf("  pipeline   Ticks a session on one thread & draws it on another.\n");
+	printf("             -frames n -threads n -seed n\n");
+	printf("  math       Checks & times the matrix builders.\n");
+	printf("             -checks n -rounds n\n");
+	printf("  scene      Times placing many rings with & without the scene graph.\n");
+	printf("             -rings n -frames n -seed n\n");
+	printf("  random     Checks the random streams & their jumps.\n");
+	printf("             -draws n -seed n\n");
+	return 1;
+}
+
+// Main Application Function.  
+//////////////////////////////////////////////////////////////////////////////////////////
+int main(int argc, char** argv)
+{
+	if (argc < 2)
+		return Usage();
+
+	if (strcmp(argv[1], "simulate") == 0)
+		return Simulate(argc, argv);
+	if (strcmp(argv[1], "verify") == 0)
+		return Verify(argc, argv);
+	if (strcmp(argv[1], "record") == 0)
+		return Record(argc, argv);
+	if (strcmp(argv[1], "replay") == 0)
+		return Replay(argc, argv);
+	if (strcmp(argv[1], "bisect") == 0)
+		return Bisect(argc, argv);
+	if (strcmp(argv[1], "snapshot") == 0)
+		return Snapshot(argc, argv);
+	if (strcmp(argv[1], "parse") == 0)
+		return Parse(argc, argv);
+	if (strcmp(argv[1], "cook") == 0)
+		return Cook(argc, argv);
+	if (strcmp(argv[1], "load") == 0)
+		return Load(argc, argv);
+	if (strcmp(argv[1], "render") == 0)
+		return Render(argc, argv);
+	if (strcmp(argv[1], "raster") == 0)
+		return Raster(argc, argv);
+	if (strcmp(argv[1], "drawstats") == 0)
+		return DrawStatistics(argc, argv);
+	if (strcmp(argv[1], "schedule") == 0)
+		return Schedule(argc, argv);
+	if (strcmp(argv[1], "pipeline") == 0)
+		return Pipeline(argc, argv);
+	if (strcmp(argv[1], "math") == 0)
+		return Math(argc, argv);
+	if (strcmp(argv[1], "scene") == 0)
+		return Scene(argc, argv);
+	if (strcmp(argv[1], "random") == 0)
+		return RandomStreams(argc, argv);
+
+	return Usage();
+}
\ No newline at end of file